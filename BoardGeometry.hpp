@@ -0,0 +1,227 @@
+/**
+ * @struct BoardGeometry
+ * @brief Compile-time description of a ROWS x COLS board: cell numbering, bounds checks and attack tables.
+ *
+ * Cells are numbered (row * COLS + col), row 0 being player one's back row. Every helper is constexpr, so with the
+ * dimensions fixed at compile time indexing & bounds checks fold into constants, and the jump / ray / pawn tables
+ * below are built by the compiler rather than at start-up. The standard 8x8 board is StandardBoard; variant boards
+ * (eg. CapablancaBoard, MiniBoard) instantiate the same code with their own dimensions (see VariantPerft).
+ *
+ * Masks have one bit per cell: uint64_t for boards of up to 64 cells, unsigned __int128 for larger ones (up to 128).
+ * The slide(), jump() and isAttacked() generators only need a grid indexable as grid[row][col], whose elements are
+ * null for an empty cell, and a predicate over its elements, so they work on any board representation.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+template <int ROWS_, int COLS_>
+struct BoardGeometry {
+    static_assert(ROWS_ >= 3 && COLS_ >= 3 && ROWS_ * COLS_ <= 128, "Boards must be at least 3x3 and have at most 128 cells");
+
+    static constexpr int ROWS = ROWS_;
+    static constexpr int COLS = COLS_;
+    static constexpr int CELLS = ROWS * COLS;
+    static constexpr int MAX_RAY = (ROWS > COLS ? ROWS : COLS) - 1;   // Cells on the longest ray from any cell
+
+    using Mask = std::conditional_t<(CELLS <= 64), uint64_t, unsigned __int128>;
+
+    /**
+     * @brief Sliding directions. Orthogonal ones (a Rook's) come first, then diagonal ones (a Bishop's).
+     *     NORTH moves up the board, ie. towards higher rows, and EAST towards higher columns.
+     */
+    enum Direction { NORTH, SOUTH, EAST, WEST, NORTH_EAST, NORTH_WEST, SOUTH_EAST, SOUTH_WEST, DIRECTIONS };
+
+    /**
+     * @brief The cells a jumping piece (or a Pawn capturing) reaches from one cell, as a list and as a mask
+     */
+    struct Targets {
+        int8_t count;
+        int8_t cells[8];
+        Mask mask;
+    };
+
+    /**
+     * @brief The cells along one direction from a cell, nearest first, up to the edge of the board
+     */
+    struct Ray {
+        int8_t length;
+        int8_t cells[MAX_RAY];
+    };
+
+    static constexpr bool contains(const int& row, const int& col) {
+        return row >= 0 && row < ROWS && col >= 0 && col < COLS;
+    }
+
+    static constexpr int cell(const int& row, const int& col) { return row * COLS + col; }
+    static constexpr int rowOf(const int& cell) { return cell / COLS; }
+    static constexpr int colOf(const int& cell) { return cell % COLS; }
+
+    static constexpr Mask bit(const int& cell) { return Mask{1} << cell; }
+
+    /**
+     * @brief Gets the mask bit of (row, col), or 0 if it is outside the board
+     */
+    static constexpr Mask bit(const int& row, const int& col) { return contains(row, col) ? bit(cell(row, col)) : Mask{0}; }
+
+    /**
+     * @brief Gets the index of the lowest set bit of a non-zero mask
+     */
+    static constexpr int lowest(const Mask& mask) {
+        if constexpr (CELLS <= 64) {
+            return __builtin_ctzll(mask);
+        } else {
+            const uint64_t low = static_cast<uint64_t>(mask);
+            return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(mask >> 64));
+        }
+    }
+
+    static constexpr int STEPS[DIRECTIONS][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+    static constexpr int KNIGHT_STEPS[8][2] = { {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2} };
+    static constexpr int KING_STEPS[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+    static constexpr std::array<Targets, CELLS> buildTargets(const int (&steps)[8][2], const int& count) {
+        std::array<Targets, CELLS> table{};
+        for (int from = 0; from < CELLS; from++) {
+            Targets& targets = table[from];
+            for (int i = 0; i < count; i++) {
+                const int row = rowOf(from) + steps[i][0];
+                const int col = colOf(from) + steps[i][1];
+                if (!contains(row, col)) { continue; }
+                targets.cells[targets.count++] = static_cast<int8_t>(cell(row, col));
+                targets.mask |= bit(cell(row, col));
+            }
+        }
+        return table;
+    }
+
+    static constexpr std::array<std::array<Ray, DIRECTIONS>, CELLS> buildRays() {
+        std::array<std::array<Ray, DIRECTIONS>, CELLS> table{};
+        for (int from = 0; from < CELLS; from++) {
+            for (int direction = 0; direction < DIRECTIONS; direction++) {
+                Ray& ray = table[from][direction];
+                int row = rowOf(from) + STEPS[direction][0];
+                int col = colOf(from) + STEPS[direction][1];
+                for (; contains(row, col); row += STEPS[direction][0], col += STEPS[direction][1]) {
+                    ray.cells[ray.length++] = static_cast<int8_t>(cell(row, col));
+                }
+            }
+        }
+        return table;
+    }
+
+    static constexpr std::array<std::array<Targets, CELLS>, 2> buildPawnCaptures() {
+        const int up[8][2] = { {1, -1}, {1, 1} };
+        const int down[8][2] = { {-1, -1}, {-1, 1} };
+        return { buildTargets(up, 2), buildTargets(down, 2) };
+    }
+
+    static constexpr std::array<Targets, CELLS> KNIGHT = buildTargets(KNIGHT_STEPS, 8);
+    static constexpr std::array<Targets, CELLS> KING = buildTargets(KING_STEPS, 8);
+    static constexpr std::array<std::array<Ray, DIRECTIONS>, CELLS> RAYS = buildRays();
+
+    // PAWN_CAPTURES[0] for Pawns moving up the board (player one's), [1] for Pawns moving down
+    static constexpr std::array<std::array<Targets, CELLS>, 2> PAWN_CAPTURES = buildPawnCaptures();
+
+    /**
+     * @brief Builds the reachable mask of a piece sliding from cell along the directions [first, last): every cell up to
+     *     the first occupied one, which is included only if can_land(occupant) holds
+     */
+    template <class Grid, class CanLand>
+    static Mask slide(const int& from, const int& first, const int& last, const Grid& grid, const CanLand& can_land) {
+        Mask squares = 0;
+        for (int direction = first; direction < last; direction++) {
+            const Ray& ray = RAYS[from][direction];
+            for (int i = 0; i < ray.length; i++) {
+                const int target = ray.cells[i];
+                const auto& occupant = grid[rowOf(target)][colOf(target)];
+                if (!occupant) {
+                    squares |= bit(target);
+                    continue;
+                }
+                if (can_land(occupant)) { squares |= bit(target); }
+                break;
+            }
+        }
+        return squares;
+    }
+
+    /**
+     * @brief Builds the reachable mask of a jumping piece: every target that is empty or whose occupant satisfies can_land
+     */
+    template <class Grid, class CanLand>
+    static Mask jump(const Targets& targets, const Grid& grid, const CanLand& can_land) {
+        Mask squares = 0;
+        for (int i = 0; i < targets.count; i++) {
+            const int target = targets.cells[i];
+            const auto& occupant = grid[rowOf(target)][colOf(target)];
+            if (!occupant || can_land(occupant)) { squares |= bit(target); }
+        }
+        return squares;
+    }
+
+    /**
+     * @brief Collects the sliders attacking target over an occupancy mask: along each ray, the first occupied cell if it
+     *     holds a slider moving that way. Removing a piece from occupied uncovers the slider behind it (an "x-ray").
+     * @param orthogonal The cells of pieces sliding along rows & columns (Rooks & Queens)
+     * @param diagonal The cells of pieces sliding along diagonals (Bishops & Queens)
+     */
+    static constexpr Mask sliders(const int& target, const Mask& occupied, const Mask& orthogonal, const Mask& diagonal) {
+        Mask attackers = 0;
+        for (int direction = 0; direction < DIRECTIONS; direction++) {
+            const Mask movers = direction < NORTH_EAST ? orthogonal : diagonal;
+            const Ray& ray = RAYS[target][direction];
+            for (int i = 0; i < ray.length; i++) {
+                const Mask cell = bit(ray.cells[i]);
+                if (!(occupied & cell)) { continue; }
+                attackers |= movers & cell;
+                break;
+            }
+        }
+        return attackers;
+    }
+
+    /**
+     * @brief Determines if a piece of one side could capture on cell, by looking outwards from cell through the tables
+     *     instead of generating every enemy piece's moves
+     * @param side The attacking side: 0 if its Pawns move up the board, 1 otherwise
+     * @param attacker Returns the symbol ('P', 'N', 'B', 'R', 'Q' or 'K') of a grid element belonging to the attacking side, 0 otherwise
+     */
+    template <class Grid, class Attacker>
+    static bool isAttacked(const int& target, const int& side, const Grid& grid, const Attacker& attacker) {
+        auto holds = [&] (const int& cell, const char& symbol) {
+            const auto& occupant = grid[rowOf(cell)][colOf(cell)];
+            return occupant && attacker(occupant) == symbol;
+        };
+
+        // A Pawn of the attacking side captures onto target from the cells a Pawn of the other side would capture on
+        const Targets& pawns = PAWN_CAPTURES[side ^ 1][target];
+        for (int i = 0; i < pawns.count; i++) { if (holds(pawns.cells[i], 'P')) { return true; } }
+        for (int i = 0; i < KNIGHT[target].count; i++) { if (holds(KNIGHT[target].cells[i], 'N')) { return true; } }
+        for (int i = 0; i < KING[target].count; i++) { if (holds(KING[target].cells[i], 'K')) { return true; } }
+
+        for (int direction = 0; direction < DIRECTIONS; direction++) {
+            const char slider = direction < NORTH_EAST ? 'R' : 'B';
+            const Ray& ray = RAYS[target][direction];
+            for (int i = 0; i < ray.length; i++) {
+                const auto& occupant = grid[rowOf(ray.cells[i])][colOf(ray.cells[i])];
+                if (!occupant) { continue; }
+                const char symbol = attacker(occupant);
+                if (symbol == slider || symbol == 'Q') { return true; }
+                break;
+            }
+        }
+        return false;
+    }
+};
+
+using StandardBoard = BoardGeometry<8, 8>;       // Standard chess
+using CapablancaBoard = BoardGeometry<8, 10>;    // Capablanca chess: 8 rows of 10 columns
+using MiniBoard = BoardGeometry<6, 6>;           // Los Alamos minichess
+
+// The board ChessBoard & its pieces play on. Everything built on them (moves, notation, evaluation, tablebases, the
+// server's packed positions) takes its dimensions from here rather than from a literal 8.
+using GameBoard = StandardBoard;
@@ -1,5 +1,64 @@
 #include "ChessBoard.hpp"
 
+#include <array>
+#include <sstream>
+#include "Notation.hpp"
+
+namespace {
+    using Geometry = GameBoard;
+
+    const int KING_COLUMN = 3;                          // The column both Kings start on
+    const char PROMOTIONS[4] = {'Q', 'R', 'B', 'N'};    // The pieces a Pawn can become, in generateMoves() order
+
+    // Per wing (0 for kingside, 1 for queenside): the column the Rook starts on, and the columns the King & Rook castle to
+    struct Wing {
+        int rook_col;
+        int king_target;
+        int rook_target;
+    };
+    const Wing WINGS[2] = { {0, 1, 2}, {Geometry::COLS - 1, 5, 4} };
+
+    int homeRow(const int& side) {
+        return side == 0 ? 0 : Geometry::ROWS - 1;
+    }
+
+    int castlingRight(const int& side, const int& wing) {
+        return 1 << (side * 2 + wing);
+    }
+
+    // The castling rights lost by a move that starts or ends on each cell (the Kings' & Rooks' starting cells)
+    const std::array<int, Geometry::CELLS> RIGHTS_LOST = [] () {
+        std::array<int, Geometry::CELLS> lost{};
+        for (int side = 0; side < 2; side++) {
+            lost[Geometry::cell(homeRow(side), KING_COLUMN)] |= castlingRight(side, 0) | castlingRight(side, 1);
+            for (int wing = 0; wing < 2; wing++) {
+                lost[Geometry::cell(homeRow(side), WINGS[wing].rook_col)] |= castlingRight(side, wing);
+            }
+        }
+        return lost;
+    }();
+
+    // Allocates the piece a Pawn promotes to, on the Pawn's cell
+    ChessPiece* promotedPiece(const char& type, const ChessPiece* pawn) {
+        ChessPiece* piece = nullptr;
+        switch (type) {
+            case 'R': piece = new Rook(pawn->getColor(), pawn->getRow(), pawn->getColumn()); break;
+            case 'B': piece = new Bishop(pawn->getColor(), pawn->getRow(), pawn->getColumn()); break;
+            case 'N': piece = new Knight(pawn->getColor(), pawn->getRow(), pawn->getColumn()); break;
+            default: piece = new Queen(pawn->getColor(), pawn->getRow(), pawn->getColumn());
+        }
+        piece->flagMoved();
+        return piece;
+    }
+}
+
+/**
+ * @brief A set of pieces frozen by ChessBoard::snapshot(), kept alive by every board that may still point to one of them
+ */
+struct ChessBoard::SharedPieces {
+    std::vector<std::unique_ptr<ChessPiece>> pieces;
+};
+
 /**
     * Default constructor. 
     * @post The board is setup with the following restrictions:
@@ -31,7 +90,9 @@
     * 3) p1_color is set to "BLACK", and p2_color is set to "WHITE"
     */
 ChessBoard::ChessBoard() 
-    : playerOneTurn{true}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{std::vector(8, std::vector<ChessPiece*>(8)) } {
+    : playerOneTurn{true}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{std::vector(BOARD_LENGTH, std::vector<ChessPiece*>(BOARD_LENGTH)) },
+      move_cache(BOARD_LENGTH * BOARD_LENGTH), influence_cache(BOARD_LENGTH * BOARD_LENGTH), cache_valid{0}, castling_rights{0},
+      en_passant_cell{-1}, owned_cells{0} {
         // Allocate pieces
 
         auto add_mirrored = [this] (const int& i, const std::string& type) {
@@ -61,6 +122,10 @@ ChessBoard::ChessBoard()
             add_mirrored(i, "PAWN");
             add_mirrored(i, inner_pieces[i]);
         }
+        owned_cells = 0xFFFF00000000FFFFull;
+        deriveCastlingRights();
+        position_hash = computeHash();
+        locateKings();
     }
 
 /**
@@ -69,9 +134,74 @@ ChessBoard::ChessBoard()
  * @param instance A 2D vector representing a board state, where each element is a pointer to a ChessPiece.
  * @param p1Turn A boolean indicating whether it's player one's turn. True for player one, false for player two.
  * 
- * @post Initializes the board layout, sets player one's color to "BLACK" and player two's color to "WHITE".
+ * @post Initializes the board layout with copies of the given pieces (the caller keeps ownership of its own), 
+ *     sets player one's color to "BLACK" and player two's color to "WHITE". Castling rights are held by every King & Rook
+ *     that stands unmoved on its starting cell.
  */
-ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, const bool& p1Turn) : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{instance}{}
+ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, const bool& p1Turn) : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{instance},
+    move_cache(BOARD_LENGTH * BOARD_LENGTH), influence_cache(BOARD_LENGTH * BOARD_LENGTH), cache_valid{0}, castling_rights{0},
+    en_passant_cell{-1}, owned_cells{0} {
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            if (!board[i][j]) { continue; }
+            board[i][j] = board[i][j]->clone();
+            owned_cells |= cellMask(i, j);
+        }
+    }
+    deriveCastlingRights();
+    position_hash = computeHash();
+    locateKings();
+}
+
+/**
+ * @brief Copy constructor.
+ * @post The copy shares every piece that other shares (see snapshot()) and gets its own copies of the pieces other owns.
+ */
+ChessBoard::ChessBoard(const ChessBoard& other) : playerOneTurn{other.playerOneTurn}, p1_color{other.p1_color}, p2_color{other.p2_color},
+    board{other.board}, move_cache{other.move_cache}, influence_cache{other.influence_cache}, cache_valid{other.cache_valid},
+    position_hash{other.position_hash}, king_cells{other.king_cells[0], other.king_cells[1]}, castling_rights{other.castling_rights},
+    en_passant_cell{other.en_passant_cell}, shared_pieces{other.shared_pieces},
+    owned_cells{other.owned_cells} {
+    for (uint64_t cells = owned_cells; cells; cells &= cells - 1) {
+        const int cell = __builtin_ctzll(cells);
+        ChessPiece*& piece = board[cell / BOARD_LENGTH][cell % BOARD_LENGTH];
+        piece = piece->clone();
+    }
+}
+
+/**
+ * @brief Forks a copy-on-write snapshot of the board, eg. to try a candidate line without disturbing this one.
+ *     The pieces this board owns are frozen into a set shared by both boards, so the snapshot costs its own grid &
+ *     move cache (about 2KB) and no pieces at all; each board then only copies a piece the first time it moves it.
+ * @note Shared pieces are never modified, so forks of one position can be played on different threads.
+ *     Pieces returned by getCell() must not be modified directly.
+ * @return The new board, in the same position as this one
+ */
+std::unique_ptr<ChessBoard> ChessBoard::snapshot() {
+    if (owned_cells) {
+        auto frozen = std::make_shared<SharedPieces>();
+        for (uint64_t cells = owned_cells; cells; cells &= cells - 1) {
+            const int cell = __builtin_ctzll(cells);
+            frozen->pieces.emplace_back(board[cell / BOARD_LENGTH][cell % BOARD_LENGTH]);
+        }
+        shared_pieces.push_back(std::move(frozen));
+        owned_cells = 0;
+    }
+    return std::unique_ptr<ChessBoard>(new ChessBoard(*this));
+}
+
+/**
+ * @brief Makes sure the piece at (row, col) is owned by this board, copying it if it is shared
+ * @return The (possibly new) piece on the cell
+ */
+ChessPiece* ChessBoard::ownPiece(const int& row, const int& col) {
+    const uint64_t mask = cellMask(row, col);
+    if (!(owned_cells & mask)) {
+        board[row][col] = board[row][col]->clone();
+        owned_cells |= mask;
+    }
+    return board[row][col];
+}
 
 /**
  * @brief Gets the ChessPiece (if any) at (row, col) on the board
@@ -84,16 +214,1034 @@ ChessPiece* ChessBoard::getCell(const int& row, const int& col) const {
     return board[row][col];
 }
 
+/**
+ * @brief Gets a mask with only the bit for (row, col) set. Cells are numbered (row * BOARD_LENGTH + col).
+ * @return The single-bit mask for the cell, or 0 if (row, col) is outside the board.
+ */
+uint64_t ChessBoard::cellMask(const int& row, const int& col) {
+    return Geometry::bit(row, col);
+}
+
+/**
+ * @brief Computes the mask of cells the piece at (row, col) can move to by asking the piece itself (ie. reachableSquares),
+ *     plus the castling targets of a King on its starting cell (see castlingTargets())
+ */
+uint64_t ChessBoard::computeMoves(const int& row, const int& col) const {
+    ChessPiece* piece = board[row][col];
+    if (!piece) { return 0; }
+
+    uint64_t moves = piece->reachableSquares(board);
+    if (castling_rights && piece->getSymbol() == 'K') { moves |= castlingTargets(piece); }
+    return moves;
+}
+
+/**
+ * @brief Gets the cells a King can castle to: for each right its player still holds, the King's target if every cell
+ *     between the King and the Rook is empty. Whether the King is in check or passes through an attacked cell is left
+ *     to generateLegalMoves().
+ */
+uint64_t ChessBoard::castlingTargets(const ChessPiece* king) const {
+    const int side = sideOf(king);
+    const int row = homeRow(side);
+    if (king->getRow() != row || king->getColumn() != KING_COLUMN) { return 0; }
+
+    uint64_t targets = 0;
+    for (int wing = 0; wing < 2; wing++) {
+        if (!(castling_rights & castlingRight(side, wing))) { continue; }
+
+        const int step = WINGS[wing].rook_col < KING_COLUMN ? -1 : 1;
+        bool empty = true;
+        for (int col = KING_COLUMN + step; col != WINGS[wing].rook_col && empty; col += step) { empty = !board[row][col]; }
+        if (empty) { targets |= cellMask(row, WINGS[wing].king_target); }
+    }
+    return targets;
+}
+
+/**
+ * @brief Gets the pseudo-legal destinations of the piece on cell: its cached moves (see getMoves()), plus the en passant
+ *     cell if the piece is a Pawn that can capture onto it
+ * @pre The piece on cell belongs to the player whose turn it is
+ */
+uint64_t ChessBoard::targetsOf(const int& cell) const {
+    const int row = Geometry::rowOf(cell);
+    const int col = Geometry::colOf(cell);
+    uint64_t targets = getMoves(row, col);
+
+    // The en passant cell is empty, so it is never among a Pawn's cached captures
+    if (en_passant_cell >= 0 && std::abs(Geometry::rowOf(en_passant_cell) - row) == 1 && std::abs(Geometry::colOf(en_passant_cell) - col) == 1) {
+        const ChessPiece* piece = board[row][col];
+        const uint64_t ep = Geometry::bit(en_passant_cell);
+        if (piece->getSymbol() == 'P' && (Geometry::PAWN_CAPTURES[piece->isMovingUp() ? 0 : 1][cell].mask & ep)) { targets |= ep; }
+    }
+    return targets;
+}
+
+/**
+ * @brief Determines if every move of the piece promotes, ie. it is a Pawn one step away from its last row
+ */
+bool ChessBoard::promotes(const ChessPiece* piece) {
+    return piece->getSymbol() == 'P' && piece->getRow() == (piece->isMovingUp() ? BOARD_LENGTH - 2 : 1);
+}
+
+/**
+ * @brief Determines if a move of the given piece is an en passant capture, ie. a Pawn moving onto en_passant_cell
+ */
+bool ChessBoard::isEnPassant(const ChessPiece* piece, const Move& move) const {
+    return en_passant_cell == Geometry::cell(move.targetRow(), move.targetCol()) && move.col() != move.targetCol() && piece->getSymbol() == 'P';
+}
+
+/**
+ * @brief Computes castling_rights from the pieces: a right is held if its King & Rook stand unmoved on their starting cells
+ */
+void ChessBoard::deriveCastlingRights() {
+    castling_rights = 0;
+    for (int side = 0; side < 2; side++) {
+        const int row = homeRow(side);
+        const ChessPiece* king = board[row][KING_COLUMN];
+        if (!king || king->getSymbol() != 'K' || sideOf(king) != side || king->hasMoved()) { continue; }
+
+        for (int wing = 0; wing < 2; wing++) {
+            const ChessPiece* rook = board[row][WINGS[wing].rook_col];
+            if (rook && rook->getSymbol() == 'R' && sideOf(rook) == side && !rook->hasMoved()) { castling_rights |= castlingRight(side, wing); }
+        }
+    }
+}
+
+/**
+ * @brief Computes the mask of cells whose contents can change the set of moves available to the given piece.
+ *     Sliding pieces depend on every cell along their rays up to and including the first occupied cell, 
+ *     Knights & Kings on their jump targets (and a King that may castle on its whole starting row), and Pawns on the cells
+ *     in front of them and the two forward diagonals. Pieces of an unknown type conservatively depend on the whole board.
+ */
+uint64_t ChessBoard::computeInfluence(const ChessPiece* piece) const {
+    const int cell = Geometry::cell(piece->getRow(), piece->getColumn());
+    uint64_t influence = 0;
+
+    // Walks from the piece along each direction in [first, last), stopping after the first occupied cell
+    auto add_rays = [&] (const int& first, const int& last) {
+        for (int direction = first; direction < last; direction++) {
+            const Geometry::Ray& ray = Geometry::RAYS[cell][direction];
+            for (int i = 0; i < ray.length; i++) {
+                influence |= Geometry::bit(ray.cells[i]);
+                if (board[Geometry::rowOf(ray.cells[i])][Geometry::colOf(ray.cells[i])]) { break; }
+            }
+        }
+    };
+
+    switch (piece->getSymbol()) {
+        case 'R': add_rays(Geometry::NORTH, Geometry::NORTH_EAST); break;
+        case 'B': add_rays(Geometry::NORTH_EAST, Geometry::DIRECTIONS); break;
+        case 'Q': add_rays(Geometry::NORTH, Geometry::DIRECTIONS); break;
+        case 'N': influence = Geometry::KNIGHT[cell].mask; break;
+        case 'K':
+            // Castling depends on every cell between the King & its Rooks, and on the Rooks themselves. This holds even
+            // without rights: unmakeMove() only gives them back by touching the row.
+            influence = Geometry::KING[cell].mask;
+            if (piece->getColumn() == KING_COLUMN && piece->getRow() == homeRow(sideOf(piece))) {
+                influence |= uint64_t{0xFF} << (piece->getRow() * BOARD_LENGTH);
+            }
+            break;
+        case 'P': {
+            const int row = piece->getRow();
+            const int col = piece->getColumn();
+            const int direction = piece->isMovingUp() ? 1 : -1;
+            influence = cellMask(row + direction, col) | cellMask(row + 2 * direction, col) |
+                Geometry::PAWN_CAPTURES[piece->isMovingUp() ? 0 : 1][cell].mask;
+            break;
+        }
+        default: influence = ~uint64_t{0};
+    }
+
+    return influence;
+}
+
+/**
+ * @brief Drops every cached entry that belongs to, or depends on, one of the touched cells.
+ * @param touched A mask of the cells whose contents have changed
+ */
+void ChessBoard::invalidate(const uint64_t& touched) {
+    cache_valid &= ~touched;
+    for (uint64_t valid = cache_valid; valid; valid &= valid - 1) {
+        int cell = __builtin_ctzll(valid);
+        if (influence_cache[cell] & touched) { cache_valid &= ~(uint64_t{1} << cell); }
+    }
+}
+
+/**
+ * @brief Gets the pseudo-legal destinations of the piece at (row, col).
+ *     The answer is cached per cell, and only recomputed once a move touches a cell the piece depends on.
+ * @note Pieces must only be moved through move() for the cache to stay coherent.
+ * @return A mask of the cells the piece can move to (see cellMask()), or 0 if the cell is empty or out of bounds.
+ */
+uint64_t ChessBoard::getMoves(const int& row, const int& col) const {
+    uint64_t mask = cellMask(row, col);
+    if (!mask || !board[row][col]) { return 0; }
+
+    int cell = row * BOARD_LENGTH + col;
+    if (!(cache_valid & mask)) {
+        move_cache[cell] = computeMoves(row, col);
+        influence_cache[cell] = computeInfluence(board[row][col]);
+        cache_valid |= mask;
+    }
+    return move_cache[cell];
+}
+
+/**
+ * @brief Moves the piece at (row, col) to (target_row, target_col), capturing any piece already there.
+ * @pre The piece at (row, col) belongs to the player whose turn it is.
+ * @post On success, the moved piece's row / col are updated and it is flagged as moved, any captured piece is deallocated,
+ *     the turn passes to the other player, and only the cached moves that depended on the two touched cells are invalidated.
+ * @return True if the move was made. False if the piece can't move there (nothing changes).
+ */
+bool ChessBoard::move(const int& row, const int& col, const int& target_row, const int& target_col) {
+    return move(Move{row, col, target_row, target_col});
+}
+
+/**
+ * @brief Plays a move (including castling, en passant & promotions), deallocating anything it captures.
+ * @pre The piece at (move.row(), move.col()) belongs to the player whose turn it is.
+ * @post Same as move(row, col, target_row, target_col). A Pawn reaching its last row without a promotion becomes a Queen.
+ * @return True if the move was made. False if it is not a pseudo-legal move (nothing changes).
+ */
+bool ChessBoard::move(const Move& move) {
+    if (!cellMask(move.row(), move.col()) || !board[move.row()][move.col()]) { return false; }
+
+    ChessPiece* piece = board[move.row()][move.col()];
+    if (!piece->hasColor(playerOneTurn ? p1_color : p2_color)) { return false; }
+    if (!(targetsOf(Geometry::cell(move.row(), move.col())) & cellMask(move.targetRow(), move.targetCol()))) { return false; }
+
+    Move played = move;
+    if (promotes(piece)) {
+        if (!played.promotion()) { played = Move(played.row(), played.col(), played.targetRow(), played.targetCol(), 'Q'); }
+    } else if (played.promotion()) {
+        return false;
+    }
+
+    const int captured_row = isEnPassant(piece, played) ? played.row() : played.targetRow();
+    MoveUndo undo;
+    makeMove(played, undo);
+    if (undo.owned_cells & cellMask(captured_row, played.targetCol())) { delete undo.captured; }
+    delete undo.promoted;   // makeMove() always owns the Pawn it replaces
+    return true;
+}
+
+/**
+ * @brief Makes a pseudo-legal move without deallocating anything, so that unmakeMove() can take it back.
+ * @pre The move is one of generateMoves()
+ * @post Same as move(), except that a captured piece is only taken off the board & remembered in undo
+ *     (it stays alive until unmakeMove() puts it back, so moves made this way must be taken back)
+ * @param undo Filled with what unmakeMove() needs
+ */
+void ChessBoard::makeMove(const Move& move, MoveUndo& undo) {
+    const int side = playerOneTurn ? 0 : 1;
+    const int from = Geometry::cell(move.row(), move.col());
+    const int to = Geometry::cell(move.targetRow(), move.targetCol());
+
+    undo.owned_cells = owned_cells;
+    undo.hash = position_hash;
+    undo.king_cells[0] = king_cells[0];
+    undo.king_cells[1] = king_cells[1];
+    undo.castling_rights = castling_rights;
+    undo.en_passant_cell = en_passant_cell;
+    undo.promoted = nullptr;
+
+    ChessPiece* piece = ownPiece(move.row(), move.col());
+    const char symbol = piece->getSymbol();
+
+    // En passant captures the Pawn beside the moving one, not on the target cell
+    const int captured_row = isEnPassant(piece, move) ? move.row() : move.targetRow();
+    ChessPiece* captured = board[captured_row][move.targetCol()];
+    uint64_t touched = Geometry::bit(from) | Geometry::bit(to);
+
+    undo.captured = captured;
+    undo.had_moved = piece->hasMoved();
+
+    position_hash ^= pieceKey(piece) ^ Zobrist::sideToMove();
+    if (captured) {
+        position_hash ^= pieceKey(captured);
+        board[captured_row][move.targetCol()] = nullptr;
+        owned_cells &= ~cellMask(captured_row, move.targetCol());
+        touched |= cellMask(captured_row, move.targetCol());
+    }
+
+    board[move.targetRow()][move.targetCol()] = piece;
+    board[move.row()][move.col()] = nullptr;
+    owned_cells = (owned_cells & ~Geometry::bit(from)) | Geometry::bit(to);
+
+    piece->setRow(move.targetRow());
+    piece->setColumn(move.targetCol());
+    piece->flagMoved();
+
+    if (move.promotion()) {
+        undo.promoted = piece;
+        piece = promotedPiece(move.promotion(), piece);
+        board[move.targetRow()][move.targetCol()] = piece;
+    }
+    position_hash ^= pieceKey(piece);
+
+    if (symbol == 'K') {
+        king_cells[side] = to;
+
+        // Castling also moves the Rook to the other side of the King
+        if (std::abs(move.targetCol() - move.col()) == 2) {
+            const Wing& wing = WINGS[move.targetCol() < move.col() ? 0 : 1];
+            ChessPiece* rook = ownPiece(move.row(), wing.rook_col);
+            position_hash ^= pieceKey(rook);
+            board[move.row()][wing.rook_target] = rook;
+            board[move.row()][wing.rook_col] = nullptr;
+            owned_cells = (owned_cells & ~cellMask(move.row(), wing.rook_col)) | cellMask(move.row(), wing.rook_target);
+            rook->setColumn(wing.rook_target);
+            rook->flagMoved();
+            position_hash ^= pieceKey(rook);
+            touched |= cellMask(move.row(), wing.rook_col) | cellMask(move.row(), wing.rook_target);
+        }
+    }
+    if (captured && captured->getSymbol() == 'K') { king_cells[side ^ 1] = -1; }
+
+    const int rights = castling_rights & ~(RIGHTS_LOST[from] | RIGHTS_LOST[to]);
+    position_hash ^= Zobrist::castling(castling_rights) ^ Zobrist::castling(rights);
+    castling_rights = rights;
+
+    // A double jump allows an en passant capture on the next move, but only hashes as such if a Pawn is there to make it
+    if (en_passant_cell >= 0) { position_hash ^= Zobrist::enPassant(Geometry::colOf(en_passant_cell)); }
+    en_passant_cell = -1;
+    if (symbol == 'P' && std::abs(move.targetRow() - move.row()) == 2) {
+        const int skipped = Geometry::cell((move.row() + move.targetRow()) / 2, move.col());
+        const Geometry::Targets& capturers = Geometry::PAWN_CAPTURES[side][skipped];
+        for (int i = 0; i < capturers.count; i++) {
+            const ChessPiece* pawn = board[Geometry::rowOf(capturers.cells[i])][Geometry::colOf(capturers.cells[i])];
+            if (pawn && pawn->getSymbol() == 'P' && sideOf(pawn) != side) { en_passant_cell = skipped; }
+        }
+        if (en_passant_cell >= 0) { position_hash ^= Zobrist::enPassant(move.col()); }
+    }
+
+    invalidate(touched);
+    playerOneTurn = !playerOneTurn;
+}
+
+/**
+ * @brief Takes back the last move made with makeMove()
+ * @pre move & undo are the arguments of the last makeMove() call that was not taken back yet
+ */
+void ChessBoard::unmakeMove(const Move& move, const MoveUndo& undo) {
+    ChessPiece* piece = board[move.targetRow()][move.targetCol()];
+    if (undo.promoted) {
+        delete piece;
+        piece = undo.promoted;
+    }
+
+    // En passant captured the Pawn beside the moving one, on the en passant cell of the position the move was made in
+    const bool en_passant = undo.en_passant_cell == Geometry::cell(move.targetRow(), move.targetCol()) && move.col() != move.targetCol() &&
+        piece->getSymbol() == 'P';
+    const int captured_row = en_passant ? move.row() : move.targetRow();
+    uint64_t touched = cellMask(move.row(), move.col()) | cellMask(move.targetRow(), move.targetCol()) | cellMask(captured_row, move.targetCol());
+
+    board[move.row()][move.col()] = piece;
+    board[move.targetRow()][move.targetCol()] = nullptr;
+    board[captured_row][move.targetCol()] = undo.captured;
+
+    piece->setRow(move.row());
+    piece->setColumn(move.col());
+    piece->setMoved(undo.had_moved);
+
+    // The moving piece was made ours by makeMove() (& stays ours), the captured piece gets its ownership back
+    owned_cells = undo.owned_cells | cellMask(move.row(), move.col());
+
+    if (std::abs(move.targetCol() - move.col()) == 2 && piece->getSymbol() == 'K') {
+        const Wing& wing = WINGS[move.targetCol() < move.col() ? 0 : 1];
+        ChessPiece* rook = board[move.row()][wing.rook_target];
+        board[move.row()][wing.rook_col] = rook;
+        board[move.row()][wing.rook_target] = nullptr;
+        rook->setColumn(wing.rook_col);
+        rook->setMoved(false);  // Castling rights are only held while the Rook has not moved
+        owned_cells |= cellMask(move.row(), wing.rook_col);
+        touched |= cellMask(move.row(), wing.rook_col) | cellMask(move.row(), wing.rook_target);
+    }
+
+    position_hash = undo.hash;
+    king_cells[0] = undo.king_cells[0];
+    king_cells[1] = undo.king_cells[1];
+    castling_rights = undo.castling_rights;
+    en_passant_cell = undo.en_passant_cell;
+
+    invalidate(touched);
+    playerOneTurn = !playerOneTurn;
+}
+
+/**
+ * @brief Appends every pseudo-legal move of the player whose turn it is (ie. moves that may leave their own King in check)
+ */
+void ChessBoard::generateMoves(MoveList& moves) const {
+    const std::string& color = playerOneTurn ? p1_color : p2_color;
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            if (!board[i][j] || !board[i][j]->hasColor(color)) { continue; }
+            const bool promotion = promotes(board[i][j]);
+            for (uint64_t targets = targetsOf(Geometry::cell(i, j)); targets; targets &= targets - 1) {
+                int cell = __builtin_ctzll(targets);
+                if (!promotion) {
+                    moves.push_back(Move{i, j, cell / BOARD_LENGTH, cell % BOARD_LENGTH});
+                    continue;
+                }
+                for (const char& type : PROMOTIONS) { moves.push_back(Move{i, j, cell / BOARD_LENGTH, cell % BOARD_LENGTH, type}); }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Appends the pseudo-legal captures (en passant included) & promotions of the player whose turn it is,
+ *     in generateMoves() order
+ */
+void ChessBoard::generateCaptures(MoveList& moves) const {
+    appendMoves(moves, true);
+}
+
+/**
+ * @brief Appends the pseudo-legal moves that generateCaptures() leaves out, in generateMoves() order
+ */
+void ChessBoard::generateQuiets(MoveList& moves) const {
+    appendMoves(moves, false);
+}
+
+/**
+ * @brief Appends the pseudo-legal moves of generateMoves() that capture or promote (captures = true), or all the others
+ */
+void ChessBoard::appendMoves(MoveList& moves, const bool& captures) const {
+    const std::string& color = playerOneTurn ? p1_color : p2_color;
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            if (!board[i][j] || !board[i][j]->hasColor(color)) { continue; }
+            const bool promotion = promotes(board[i][j]);
+            if (promotion && !captures) { continue; }   // Every move of the Pawn promotes
+
+            // Targets never hold a piece of the mover, so an occupied target is a capture. The en passant cell is the only
+            // empty one a Pawn reaches diagonally.
+            uint64_t targets = targetsOf(Geometry::cell(i, j));
+            if (!promotion) {
+                uint64_t occupied = 0;
+                for (uint64_t cells = targets; cells; cells &= cells - 1) {
+                    const int cell = __builtin_ctzll(cells);
+                    if (board[cell / BOARD_LENGTH][cell % BOARD_LENGTH]) { occupied |= Geometry::bit(cell); }
+                }
+                if (en_passant_cell >= 0 && board[i][j]->getSymbol() == 'P') { occupied |= targets & Geometry::bit(en_passant_cell); }
+                targets = captures ? occupied : targets & ~occupied;
+            }
+
+            for (; targets; targets &= targets - 1) {
+                int cell = __builtin_ctzll(targets);
+                if (!promotion) {
+                    moves.push_back(Move{i, j, cell / BOARD_LENGTH, cell % BOARD_LENGTH});
+                    continue;
+                }
+                for (const char& type : PROMOTIONS) { moves.push_back(Move{i, j, cell / BOARD_LENGTH, cell % BOARD_LENGTH, type}); }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Determines if a move is one of generateMoves(), eg. to check that a move remembered from another
+ *     position can be played in this one
+ */
+bool ChessBoard::isPseudoLegal(const Move& move) const {
+    const ChessPiece* piece = board[move.row()][move.col()];
+    if (!piece || !piece->hasColor(playerOneTurn ? p1_color : p2_color)) { return false; }
+    if (!(targetsOf(Geometry::cell(move.row(), move.col())) & cellMask(move.targetRow(), move.targetCol()))) { return false; }
+
+    return promotes(piece) == (move.promotion() != 0);
+}
+
+/**
+ * @brief Determines if a pseudo-legal move captures or promotes, ie. if it is one of generateCaptures()
+ */
+bool ChessBoard::isCapture(const Move& move) const {
+    return board[move.targetRow()][move.targetCol()] || move.promotion() || isEnPassant(board[move.row()][move.col()], move);
+}
+
+/**
+ * @brief Determines if a pseudo-legal move castles out of check or through an attacked cell. Looking at the King
+ *     after the move (see isInCheck()) only covers the cell it ends on.
+ * @return False for any move that does not castle
+ */
+bool ChessBoard::castlesThroughCheck(const Move& move) const {
+    const int side = playerOneTurn ? 0 : 1;
+    if (Geometry::cell(move.row(), move.col()) != king_cells[side] || std::abs(move.targetCol() - move.col()) != 2) { return false; }
+    return isAttacked(move.row(), move.col(), side == 1) || isAttacked(move.row(), (move.col() + move.targetCol()) / 2, side == 1);
+}
+
+/**
+ * @brief Fills info for the King of the given side, standing on the given cell, by walking its rays & jump tables once
+ */
+void ChessBoard::computeCheckInfo(const int& king, const int& side, CheckInfo& info) const {
+    const std::string& enemy = side == 0 ? p2_color : p1_color;
+    auto enemy_symbol = [&] (const int& cell) {
+        const ChessPiece* piece = board[Geometry::rowOf(cell)][Geometry::colOf(cell)];
+        return piece && piece->hasColor(enemy) ? piece->getSymbol() : '\0';
+    };
+
+    info.checkers = 0;
+    info.pinned = 0;
+
+    // Enemy Pawns attack the King from the cells an own Pawn on the King's cell would capture on
+    const Geometry::Targets& pawns = Geometry::PAWN_CAPTURES[side][king];
+    for (int i = 0; i < pawns.count; i++) {
+        if (enemy_symbol(pawns.cells[i]) == 'P') { info.checkers |= Geometry::bit(pawns.cells[i]); }
+    }
+    const Geometry::Targets& knights = Geometry::KNIGHT[king];
+    for (int i = 0; i < knights.count; i++) {
+        if (enemy_symbol(knights.cells[i]) == 'N') { info.checkers |= Geometry::bit(knights.cells[i]); }
+    }
+    uint64_t blocks = info.checkers;
+
+    // Along each ray: an enemy slider first gives check, an enemy slider behind a single own piece pins it
+    for (int direction = 0; direction < Geometry::DIRECTIONS; direction++) {
+        const char slider = direction < Geometry::NORTH_EAST ? 'R' : 'B';
+        const Geometry::Ray& ray = Geometry::RAYS[king][direction];
+        uint64_t cells = 0;
+        int shield = -1;
+        for (int i = 0; i < ray.length; i++) {
+            const int cell = ray.cells[i];
+            cells |= Geometry::bit(cell);
+            if (!board[Geometry::rowOf(cell)][Geometry::colOf(cell)]) { continue; }
+
+            const char symbol = enemy_symbol(cell);
+            if (!symbol) {
+                if (shield >= 0) { break; }     // Two own pieces in a row: nothing is pinned
+                shield = cell;
+                continue;
+            }
+            if (symbol == slider || symbol == 'Q') {
+                if (shield < 0) {
+                    info.checkers |= Geometry::bit(cell);
+                    blocks |= cells;
+                } else {
+                    info.pinned |= Geometry::bit(shield);
+                    info.pin_rays[shield] = cells;
+                }
+            }
+            break;
+        }
+    }
+
+    const int checks = __builtin_popcountll(info.checkers);
+    info.evasions = checks == 0 ? ~uint64_t{0} : checks == 1 ? blocks : 0;
+}
+
+/**
+ * @brief Appends every legal move of the player whose turn it is (ie. pseudo-legal moves that don't leave their King in check,
+ *     and castling moves that don't start from, pass through or end on an attacked cell)
+ */
+void ChessBoard::generateLegalMoves(MoveList& moves) {
+    const int side = playerOneTurn ? 0 : 1;
+    const int king = king_cells[side];
+    if (king < 0) {
+        generateMoves(moves);
+        return;
+    }
+
+    CheckInfo info;
+    computeCheckInfo(king, side, info);
+
+    const std::string& color = side == 0 ? p1_color : p2_color;
+    for (int cell = 0; cell < BOARD_LENGTH * BOARD_LENGTH; cell++) {
+        const ChessPiece* piece = board[Geometry::rowOf(cell)][Geometry::colOf(cell)];
+        if (!piece || !piece->hasColor(color)) { continue; }
+
+        const bool promotion = promotes(piece);
+        for (uint64_t targets = legalTargets(cell, targetsOf(cell), side, info); targets; targets &= targets - 1) {
+            const int target = __builtin_ctzll(targets);
+            if (!promotion) {
+                moves.push_back(Move{Geometry::rowOf(cell), Geometry::colOf(cell), Geometry::rowOf(target), Geometry::colOf(target)});
+                continue;
+            }
+            for (const char& type : PROMOTIONS) {
+                moves.push_back(Move{Geometry::rowOf(cell), Geometry::colOf(cell), Geometry::rowOf(target), Geometry::colOf(target), type});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gets the move at a position of generateLegalMoves() order without building the list. Only the King, pinned
+ *     pieces, captures en passant & evasions have their moves tested one by one; every other piece is skipped over
+ *     by counting its targets.
+ * @return True if index is in range, in which case move is set. False otherwise.
+ */
+bool ChessBoard::legalMoveAt(int index, Move& move) {
+    if (index < 0) { return false; }
+
+    // Without a King every pseudo-legal move is legal, and every target counts
+    const int side = playerOneTurn ? 0 : 1;
+    const int king = king_cells[side];
+    CheckInfo info;
+    if (king >= 0) { computeCheckInfo(king, side, info); }
+
+    const std::string& color = side == 0 ? p1_color : p2_color;
+    for (int cell = 0; cell < BOARD_LENGTH * BOARD_LENGTH; cell++) {
+        const ChessPiece* piece = board[Geometry::rowOf(cell)][Geometry::colOf(cell)];
+        if (!piece || !piece->hasColor(color)) { continue; }
+
+        uint64_t targets = king >= 0 ? legalTargets(cell, targetsOf(cell), side, info) : targetsOf(cell);
+        const int per_target = promotes(piece) ? 4 : 1;
+        const int count = __builtin_popcountll(targets) * per_target;
+        if (index >= count) {
+            index -= count;
+            continue;
+        }
+
+        // Drop the (index / per_target) lowest targets
+        for (int skip = index / per_target; skip > 0; skip--) { targets &= targets - 1; }
+        const int target = __builtin_ctzll(targets);
+        const char promotion = per_target > 1 ? PROMOTIONS[index % per_target] : 0;
+        move = Move{Geometry::rowOf(cell), Geometry::colOf(cell), Geometry::rowOf(target), Geometry::colOf(target), promotion};
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Narrows the pseudo-legal targets of the piece on cell (see targetsOf()) down to its legal ones
+ * @param info What computeCheckInfo() found about the King of the given side, the player to move
+ */
+uint64_t ChessBoard::legalTargets(const int& cell, const uint64_t& targets, const int& side, const CheckInfo& info) {
+    const int row = Geometry::rowOf(cell);
+    const int col = Geometry::colOf(cell);
+    ChessPiece* piece = board[row][col];
+    uint64_t legal = 0;
+
+    if (cell == king_cells[side]) {
+        // The King is lifted off the grid while its moves are tested, so that a slider checking it also covers the cells
+        // behind it. isAttacked() only reads the grid, so neither the King nor the move cache needs updating.
+        board[row][col] = nullptr;
+        for (uint64_t remaining = targets; remaining; remaining &= remaining - 1) {
+            const int target = __builtin_ctzll(remaining);
+            const int target_col = Geometry::colOf(target);
+
+            // Castling may not start from, or pass through, an attacked cell. The Rook is left where it is: it can only
+            // shield the cell the King passes through, which is tested with the King still in front of it (not in check).
+            if (std::abs(target_col - col) == 2 && (info.checkers || isAttacked(row, (col + target_col) / 2, side == 1))) { continue; }
+            if (!isAttacked(Geometry::rowOf(target), target_col, side == 1)) { legal |= Geometry::bit(target); }
+        }
+        board[row][col] = piece;
+        return legal;
+    }
+
+    legal = targets & info.evasions;
+    if (info.pinned & Geometry::bit(cell)) { legal &= info.pin_rays[cell]; }
+
+    // En passant empties a cell off the moving Pawn's path, which no mask covers (eg. both Pawns leaving the King's row),
+    // so it is played out on the grid instead
+    if (en_passant_cell >= 0 && (targets & Geometry::bit(en_passant_cell)) &&
+        isEnPassant(piece, Move{row, col, Geometry::rowOf(en_passant_cell), Geometry::colOf(en_passant_cell)})) {
+        const int target_row = Geometry::rowOf(en_passant_cell);
+        const int target_col = Geometry::colOf(en_passant_cell);
+        ChessPiece* captured = board[row][target_col];
+        board[row][target_col] = nullptr;
+        board[target_row][target_col] = piece;
+        board[row][col] = nullptr;
+
+        const int king = king_cells[side];
+        legal &= ~Geometry::bit(en_passant_cell);
+        if (!isAttacked(Geometry::rowOf(king), Geometry::colOf(king), side == 1)) { legal |= Geometry::bit(en_passant_cell); }
+
+        board[row][col] = piece;
+        board[target_row][target_col] = nullptr;
+        board[row][target_col] = captured;
+    }
+    return legal;
+}
+
+/**
+ * @brief Fills targets for the enemy King, standing on the given cell, by walking its rays & jump tables once
+ * @param side The player giving check, the player to move
+ */
+void ChessBoard::computeCheckTargets(const int& king, const int& side, CheckTargets& targets) const {
+    const std::string& own = side == 0 ? p1_color : p2_color;
+    auto own_symbol = [&] (const int& cell) {
+        const ChessPiece* piece = board[Geometry::rowOf(cell)][Geometry::colOf(cell)];
+        return piece && piece->hasColor(own) ? piece->getSymbol() : '\0';
+    };
+
+    // An own Pawn attacks the King from the cells a Pawn of the King's side on the King's cell would capture on
+    targets.pawn = Geometry::PAWN_CAPTURES[side ^ 1][king].mask;
+    targets.knight = Geometry::KNIGHT[king].mask;
+    targets.bishop = 0;
+    targets.rook = 0;
+    targets.discoverers = 0;
+
+    // Along each ray: a slider checks from any cell up to the first piece, and an own piece first on the ray with an own
+    // slider right behind it discovers check when it leaves the ray
+    for (int direction = 0; direction < Geometry::DIRECTIONS; direction++) {
+        const char slider = direction < Geometry::NORTH_EAST ? 'R' : 'B';
+        const Geometry::Ray& ray = Geometry::RAYS[king][direction];
+        uint64_t cells = 0;
+        int shield = -1;
+        int i = 0;
+        for (; i < ray.length; i++) {
+            const int cell = ray.cells[i];
+            cells |= Geometry::bit(cell);
+            if (!board[Geometry::rowOf(cell)][Geometry::colOf(cell)]) { continue; }
+
+            if (shield >= 0) {
+                const char symbol = own_symbol(cell);
+                if (symbol == slider || symbol == 'Q') {
+                    targets.discoverers |= Geometry::bit(shield);
+                    targets.discovery_rays[shield] = cells;
+                }
+                break;
+            }
+            (slider == 'R' ? targets.rook : targets.bishop) |= cells;
+            if (!own_symbol(cell)) { break; }   // An enemy piece hides whatever stands behind it
+            shield = cell;
+        }
+        if (shield < 0 && i == ray.length) { (slider == 'R' ? targets.rook : targets.bishop) |= cells; }
+    }
+}
+
+/**
+ * @brief Appends the legal moves of the player whose turn it is that give check, in generateLegalMoves() order.
+ *     A move checks directly when it lands where its piece attacks the enemy King, or by discovery when it leaves
+ *     the line between the King and an own slider (see computeCheckTargets()). Promotions, castling & captures en
+ *     passant, which change more than one cell of a line, are played out instead.
+ *     (When the player is in check, generateLegalMoves() itself generates the evasions.)
+ */
+void ChessBoard::generateChecks(MoveList& moves) {
+    const int side = playerOneTurn ? 0 : 1;
+    const int king = king_cells[side];
+    const int enemy_king = king_cells[side ^ 1];
+    if (enemy_king < 0) { return; }
+
+    // Without a King every pseudo-legal move is legal
+    CheckInfo info;
+    if (king >= 0) { computeCheckInfo(king, side, info); }
+    CheckTargets checks;
+    computeCheckTargets(enemy_king, side, checks);
+
+    auto play_out = [&] (const Move& move) {
+        MoveUndo undo;
+        makeMove(move, undo);
+        const bool check = isInCheck(side == 1);
+        unmakeMove(move, undo);
+        if (check) { moves.push_back(move); }
+    };
+
+    const std::string& color = side == 0 ? p1_color : p2_color;
+    for (int cell = 0; cell < BOARD_LENGTH * BOARD_LENGTH; cell++) {
+        const ChessPiece* piece = board[Geometry::rowOf(cell)][Geometry::colOf(cell)];
+        if (!piece || !piece->hasColor(color)) { continue; }
+
+        const int row = Geometry::rowOf(cell);
+        const int col = Geometry::colOf(cell);
+        const uint64_t targets = king >= 0 ? legalTargets(cell, targetsOf(cell), side, info) : targetsOf(cell);
+        if (promotes(piece)) {
+            for (uint64_t remaining = targets; remaining; remaining &= remaining - 1) {
+                const int target = __builtin_ctzll(remaining);
+                for (const char& type : PROMOTIONS) { play_out(Move{row, col, Geometry::rowOf(target), Geometry::colOf(target), type}); }
+            }
+            continue;
+        }
+
+        uint64_t checking = 0;      // Targets giving check
+        uint64_t played_out = 0;    // Targets whose check is found by playing the move
+        switch (piece->getSymbol()) {
+            case 'P':
+                checking = checks.pawn;
+                if (en_passant_cell >= 0) { played_out = Geometry::bit(en_passant_cell); }
+                break;
+            case 'N': checking = checks.knight; break;
+            case 'B': checking = checks.bishop; break;
+            case 'R': checking = checks.rook; break;
+            case 'Q': checking = checks.bishop | checks.rook; break;
+            case 'K': played_out = Geometry::bit(row, col - 2) | Geometry::bit(row, col + 2); break;     // Castling
+            default: played_out = ~uint64_t{0};    // A piece of another type
+        }
+        if (checks.discoverers & Geometry::bit(cell)) { checking |= ~checks.discovery_rays[cell]; }
+
+        for (uint64_t remaining = targets & (checking | played_out); remaining; remaining &= remaining - 1) {
+            const int target = __builtin_ctzll(remaining);
+            const Move move{row, col, Geometry::rowOf(target), Geometry::colOf(target)};
+            if (played_out & Geometry::bit(target)) {
+                play_out(move);
+            } else {
+                moves.push_back(move);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Determines if a piece of the given player could capture a piece standing on (row, col)
+ * @pre (row, col) is occupied by a piece of the other player (eg. their King)
+ */
+bool ChessBoard::isAttacked(const int& row, const int& col, const bool& byPlayerOne) const {
+    const std::string& color = byPlayerOne ? p1_color : p2_color;
+    return Geometry::isAttacked(Geometry::cell(row, col), byPlayerOne ? 0 : 1, board, [&color] (const ChessPiece* piece) {
+        return piece->hasColor(color) ? piece->getSymbol() : '\0';
+    });
+}
+
+/**
+ * @brief Determines if the given player's King can be captured by the other player
+ * @return True if the player is in check. False otherwise, or if the player has no King.
+ */
+bool ChessBoard::isInCheck(const bool& playerOne) const {
+    int cell = king_cells[playerOne ? 0 : 1];
+    if (cell < 0) { return false; }
+    return isAttacked(cell / BOARD_LENGTH, cell % BOARD_LENGTH, !playerOne);
+}
+
+/**
+ * @brief Builds a board from a position in Forsyth-Edwards Notation, eg. 
+ *     "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+ *     White (uppercase) is player one, and files / ranks map to cells as described in Notation.
+ *     Only the piece placement & side to move fields are required. Castling rights are only granted to Kings & Rooks
+ *     on their starting cells, and an en passant cell is only kept if a Pawn can capture onto it.
+ * @return The board, or nullptr if the text is not a valid position (eg. bad field, not exactly one King per player)
+ */
+std::unique_ptr<ChessBoard> ChessBoard::fromFen(const std::string& fen) {
+    std::istringstream fields(fen);
+    std::string placement, side, castling = "-", en_passant = "-";
+    fields >> placement >> side >> castling >> en_passant;
+    if (side != "w" && side != "b") { return nullptr; }
+
+    // Ranks are listed from rank 8 (row 7) down to rank 1 (row 0), files from 'a' (column 7) to 'h' (column 0)
+    char symbols[BOARD_LENGTH * BOARD_LENGTH] = {};
+    int row = BOARD_LENGTH - 1;
+    int file = 0;
+    for (const char& symbol : placement) {
+        if (symbol == '/') {
+            if (file != BOARD_LENGTH || row == 0) { return nullptr; }
+            row--;
+            file = 0;
+            continue;
+        }
+        if (std::isdigit(symbol)) {
+            file += symbol - '0';
+            if (file > BOARD_LENGTH) { return nullptr; }
+            continue;
+        }
+        if (file >= BOARD_LENGTH) { return nullptr; }
+        symbols[Geometry::cell(row, BOARD_LENGTH - 1 - file)] = symbol;
+        file++;
+    }
+    if (row != 0 || file != BOARD_LENGTH) { return nullptr; }
+
+    const std::string rights = "KQkq";
+    int castling_rights = 0;
+    for (int right = 0; right < 4; right++) {
+        if (castling.find(rights[right]) != std::string::npos) { castling_rights |= 1 << right; }
+    }
+
+    int ep_row, ep_col;
+    const bool has_en_passant = en_passant != "-" && Notation::parseCell(en_passant, ep_row, ep_col);
+    return fromCells(symbols, side == "w", castling_rights, has_en_passant ? Geometry::cell(ep_row, ep_col) : -1);
+}
+
+/**
+ * @brief Builds a board from the contents of its cells, eg. to unpack a position stored without text
+ * @param symbols The piece on every cell (see Geometry::cell()) as a FEN letter (uppercase for player one), or 0 if the cell is empty
+ * @param castling_rights CastlingRight flags, only granted to Kings & Rooks on their starting cells
+ * @param en_passant_cell The cell the player to move may capture onto en passant, or -1. Only kept if a Pawn can.
+ * @return The board, or nullptr if a symbol is unknown or either player has no King or several
+ */
+std::unique_ptr<ChessBoard> ChessBoard::fromCells(const char* symbols, const bool& player_one_turn, const int& castling_rights,
+    const int& en_passant_cell) {
+    const std::string p1 = "BLACK";
+    const std::string p2 = "WHITE";
+
+    std::vector<std::vector<ChessPiece*>> cells(BOARD_LENGTH, std::vector<ChessPiece*>(BOARD_LENGTH));
+    auto discard = [&cells] () {
+        for (auto& row : cells) {
+            for (ChessPiece*& piece : row) { delete piece; piece = nullptr; }
+        }
+        return nullptr;
+    };
+
+    int kings[2] = {0, 0};
+    for (int cell = 0; cell < BOARD_LENGTH * BOARD_LENGTH; cell++) {
+        const char symbol = symbols[cell];
+        if (!symbol) { continue; }
+
+        const int row = Geometry::rowOf(cell);
+        const int col = Geometry::colOf(cell);
+        const bool player_one = std::isupper(symbol);
+        const std::string& color = player_one ? p1 : p2;
+        ChessPiece* piece = nullptr;
+        switch (std::toupper(symbol)) {
+            case 'P': piece = new Pawn(color, row, col, player_one); break;
+            case 'N': piece = new Knight(color, row, col); break;
+            case 'B': piece = new Bishop(color, row, col); break;
+            case 'R': piece = new Rook(color, row, col); break;
+            case 'Q': piece = new Queen(color, row, col); break;
+            case 'K': piece = new King(color, row, col); kings[player_one ? 0 : 1]++; break;
+            default: return discard();
+        }
+        cells[row][col] = piece;
+
+        // Pawns off their starting row can no longer double jump
+        if (piece->getSymbol() == 'P' && row != (player_one ? 1 : BOARD_LENGTH - 2)) { piece->flagMoved(); }
+    }
+    if (kings[0] != 1 || kings[1] != 1) { return discard(); }
+
+    // Rights are granted by the constructor to unmoved Kings & Rooks on their starting cells, so flag the ones without any
+    for (int player = 0; player < 2; player++) {
+        const int home = homeRow(player);
+        bool any = false;
+        for (int wing = 0; wing < 2; wing++) {
+            const bool held = castling_rights & castlingRight(player, wing);
+            ChessPiece* rook = cells[home][WINGS[wing].rook_col];
+            if (rook && !held) { rook->flagMoved(); }
+            any = any || held;
+        }
+        if (cells[home][KING_COLUMN] && !any) { cells[home][KING_COLUMN]->flagMoved(); }
+    }
+
+    std::unique_ptr<ChessBoard> board(new ChessBoard(cells, player_one_turn));
+    discard(); // The board made its own copies
+
+    // The en passant cell lies behind a Pawn of the player who just moved, and needs a Pawn of the player to move beside that one
+    if (en_passant_cell >= 0 && en_passant_cell < BOARD_LENGTH * BOARD_LENGTH &&
+        Geometry::rowOf(en_passant_cell) == (board->playerOneTurn ? BOARD_LENGTH - 3 : 2)) {
+        const int ep_row = Geometry::rowOf(en_passant_cell);
+        const int ep_col = Geometry::colOf(en_passant_cell);
+        const int mover = board->playerOneTurn ? 1 : 0;
+        const int pawn_row = ep_row + (mover == 0 ? 1 : -1);
+        const ChessPiece* pawn = board->board[pawn_row][ep_col];
+        if (!board->board[ep_row][ep_col] && pawn && pawn->getSymbol() == 'P' && board->sideOf(pawn) == mover) {
+            const Geometry::Targets& capturers = Geometry::PAWN_CAPTURES[mover][en_passant_cell];
+            for (int i = 0; i < capturers.count; i++) {
+                const ChessPiece* capturer = board->board[Geometry::rowOf(capturers.cells[i])][Geometry::colOf(capturers.cells[i])];
+                if (capturer && capturer->getSymbol() == 'P' && board->sideOf(capturer) != mover) { board->en_passant_cell = en_passant_cell; }
+            }
+            board->position_hash = board->computeHash();
+        }
+    }
+    return board;
+}
+
+/**
+ * @brief Gets the position in Forsyth-Edwards Notation (see fromFen())
+ */
+std::string ChessBoard::toFen() const {
+    std::string fen;
+    for (int row = BOARD_LENGTH - 1; row >= 0; row--) {
+        int empty = 0;
+        for (int col = BOARD_LENGTH - 1; col >= 0; col--) {
+            const ChessPiece* piece = board[row][col];
+            if (!piece) {
+                empty++;
+                continue;
+            }
+            if (empty) { fen += static_cast<char>('0' + empty); }
+            empty = 0;
+            fen += sideOf(piece) == 0 ? piece->getSymbol() : static_cast<char>(std::tolower(piece->getSymbol()));
+        }
+        if (empty) { fen += static_cast<char>('0' + empty); }
+        if (row) { fen += '/'; }
+    }
+    fen += playerOneTurn ? " w " : " b ";
+
+    const std::string rights = "KQkq";
+    for (int right = 0; right < 4; right++) {
+        if (castling_rights & (1 << right)) { fen += rights[right]; }
+    }
+    if (!castling_rights) { fen += '-'; }
+
+    fen += en_passant_cell < 0 ? std::string(" -") : " " + Notation::cellName(Geometry::rowOf(en_passant_cell), Geometry::colOf(en_passant_cell));
+    return fen + " 0 1";
+}
+
+/**
+ * @brief Getter for the playerOneTurn member
+ */
+bool ChessBoard::isPlayerOneTurn() const {
+    return playerOneTurn;
+}
+
+/**
+ * @brief Gets the color of player one's pieces (p1_color), or of player two's pieces (p2_color)
+ * @param playerOne True to get player one's color, false to get player two's
+ */
+std::string ChessBoard::getPlayerColor(const bool& playerOne) const {
+    return playerOne ? p1_color : p2_color;
+}
+
+/**
+ * @brief Gets the CastlingRight flags still held by either player
+ */
+int ChessBoard::getCastlingRights() const {
+    return castling_rights;
+}
+
+/**
+ * @brief Gets the cell (row * BOARD_LENGTH + col) the player whose turn it is can capture onto en passant, or -1 if there is none
+ */
+int ChessBoard::getEnPassantCell() const {
+    return en_passant_cell;
+}
+
 /**
  * @brief Destructor. 
- * @post Deallocates all ChessPiece pointers stored on the board at time of deletion. 
+ * @post Deallocates all ChessPiece pointers the board owns at time of deletion (shared pieces go with their last board). 
  */
 ChessBoard::~ChessBoard() {
     for (int i = 0; i < BOARD_LENGTH; i++) {
         for (int j = 0; j < BOARD_LENGTH; j++) {
             if (!board[i][j]) { continue; }
-            delete board[i][j];
+            if (owned_cells & cellMask(i, j)) { delete board[i][j]; }
             board[i][j] = nullptr;
         }
     }
+}
+
+/**
+ * @brief Gets the Zobrist key of a piece standing on its current cell
+ */
+uint64_t ChessBoard::pieceKey(const ChessPiece* piece) const {
+    return Zobrist::piece(sideOf(piece), piece->getSymbol(), piece->getRow() * BOARD_LENGTH + piece->getColumn());
+}
+
+/**
+ * @brief Computes the Zobrist hash of the whole board from scratch
+ */
+uint64_t ChessBoard::computeHash() const {
+    uint64_t hash = playerOneTurn ? 0 : Zobrist::sideToMove();
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            if (board[i][j]) { hash ^= pieceKey(board[i][j]); }
+        }
+    }
+    hash ^= Zobrist::castling(castling_rights);
+    if (en_passant_cell >= 0) { hash ^= Zobrist::enPassant(Geometry::colOf(en_passant_cell)); }
+    return hash;
+}
+
+/**
+ * @brief Gets the Zobrist hash of the current position (pieces on their cells, the player to move, castling rights & en passant)
+ *     Equal positions always have equal hashes, and the hash is kept up to date by move() at the cost of a few XORs.
+ */
+uint64_t ChessBoard::getHash() const {
+    return position_hash;
+}
+
+/**
+ * @brief Finds both Kings on the board & stores their cells in king_cells
+ */
+void ChessBoard::locateKings() {
+    king_cells[0] = -1;
+    king_cells[1] = -1;
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            if (board[i][j] && board[i][j]->getSymbol() == 'K') { king_cells[sideOf(board[i][j])] = i * BOARD_LENGTH + j; }
+        }
+    }
+}
+
+/**
+ * @brief Gets the player a piece belongs to
+ * @return 0 for player one, 1 for player two
+ */
+int ChessBoard::sideOf(const ChessPiece* piece) const {
+    return piece->getColor() == p1_color ? 0 : 1;
 }
\ No newline at end of file
@@ -6,12 +6,33 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include "pieces_module.hpp"
+#include "Move.hpp"
+#include "MoveList.hpp"
+#include "Zobrist.hpp"
+
+/**
+ * @brief Everything ChessBoard::makeMove() needs to remember for ChessBoard::unmakeMove() to take the move back
+ */
+struct MoveUndo {
+    ChessPiece* captured;   // The piece that stood on the target cell (or behind it, en passant), if any
+    ChessPiece* promoted;   // The Pawn a promotion took off the board, if any (the piece it became stands on the target cell)
+    bool had_moved;         // The moving piece's hasMoved() flag before the move
+    uint64_t hash;          // The position hash before the move
+    int king_cells[2];      // Both Kings' cells before the move
+    int castling_rights;    // The castling rights before the move
+    int en_passant_cell;    // The en passant cell before the move
+    uint64_t owned_cells;   // The board's owned cells before the move (see ChessBoard::snapshot())
+};
 
 class ChessBoard {
     private:
-        // Define board size (8x8)
-        static const int BOARD_LENGTH = 8;
+        // Board size, fixed at compile time by the geometry the pieces move on (see BoardGeometry)
+        using Geometry = GameBoard;
+        static const int BOARD_LENGTH = Geometry::ROWS;
         
         bool playerOneTurn;
         
@@ -20,7 +41,181 @@ class ChessBoard {
 
         std::vector<std::vector<ChessPiece*>> board;
 
+        /** 
+         * Per-cell cache of pseudo-legal destinations, indexed by (row * BOARD_LENGTH + col).
+         * move_cache[i] holds a mask of the cells the piece on cell i can move to, and influence_cache[i] holds a mask
+         * of the cells whose contents that answer was derived from (ray squares up to & including the first blocker, 
+         * jump targets, etc.). An entry is only trusted while its bit is set in cache_valid.
+         */
+        mutable std::vector<uint64_t> move_cache;
+        mutable std::vector<uint64_t> influence_cache;
+        mutable uint64_t cache_valid;
+
+        // Zobrist hash of the current position (see Zobrist), updated incrementally by move()
+        uint64_t position_hash;
+
+        // Cell (row * BOARD_LENGTH + col) of player one's King [0] & player two's King [1], or -1 if there is none
+        int king_cells[2];
+
+        // The CastlingRight flags still held. A right is lost for good once its King or Rook leaves (or is captured on) its starting cell.
+        int castling_rights;
+
+        // The cell a Pawn skipped over by double jumping on the last move, or -1. Only set when an enemy Pawn stands ready to capture it.
+        int en_passant_cell;
+
+        /**
+         * Pieces are either owned by this board (allocated by it, and deleted when captured or with the board) or shared:
+         * frozen by snapshot() into a SharedPieces set that every board forked from that position keeps alive, and that
+         * no board ever modifies. owned_cells has a bit set for every cell holding an owned piece; a shared piece is
+         * copied into an owned one the first time the board moves it (copy-on-write).
+         */
+        struct SharedPieces;
+        std::vector<std::shared_ptr<const SharedPieces>> shared_pieces;
+        uint64_t owned_cells;
+
+        /**
+         * @brief Makes sure the piece at (row, col) is owned by this board, copying it if it is shared
+         * @return The (possibly new) piece on the cell
+         */
+        ChessPiece* ownPiece(const int& row, const int& col);
+
+        /**
+         * @brief Computes the mask of cells the piece at (row, col) can move to by asking the piece itself (ie. reachableSquares),
+         *     plus the castling targets of a King on its starting cell (see castlingTargets())
+         */
+        uint64_t computeMoves(const int& row, const int& col) const;
+
+        /**
+         * @brief Gets the cells a King can castle to: for each right its player still holds, the King's target if every cell
+         *     between the King and the Rook is empty. Whether the King is in check or passes through an attacked cell is left
+         *     to generateLegalMoves().
+         */
+        uint64_t castlingTargets(const ChessPiece* king) const;
+
+        /**
+         * @brief Gets the pseudo-legal destinations of the piece on cell: its cached moves (see getMoves()), plus the en passant
+         *     cell if the piece is a Pawn that can capture onto it
+         * @pre The piece on cell belongs to the player whose turn it is
+         */
+        uint64_t targetsOf(const int& cell) const;
+
+        /**
+         * @brief Determines if every move of the piece promotes, ie. it is a Pawn one step away from its last row
+         */
+        static bool promotes(const ChessPiece* piece);
+
+        /**
+         * @brief Determines if a move of the given piece is an en passant capture, ie. a Pawn moving onto en_passant_cell
+         */
+        bool isEnPassant(const ChessPiece* piece, const Move& move) const;
+
+        /**
+         * @brief Appends the pseudo-legal moves of generateMoves() that capture or promote (captures = true), or all the others
+         */
+        void appendMoves(MoveList& moves, const bool& captures) const;
+
+        /**
+         * What generateLegalMoves() works out once about the King of the player to move, so that each candidate move can be
+         * checked with a couple of mask operations instead of being played out on the grid.
+         * checkers: the enemy pieces attacking the King.
+         * evasions: the cells a move of another piece must end on: every cell out of check, the checker & the cells between
+         *     it and the King in single check, and none in double check.
+         * pinned: own pieces standing alone between the King and an enemy slider; each must stay on pin_rays[cell]
+         *     (the cells from the King up to & including the pinner).
+         */
+        struct CheckInfo {
+            uint64_t checkers;
+            uint64_t evasions;
+            uint64_t pinned;
+            uint64_t pin_rays[BOARD_LENGTH * BOARD_LENGTH];
+        };
+
+        /**
+         * @brief Fills info for the King of the given side, standing on the given cell, by walking its rays & jump tables once
+         */
+        void computeCheckInfo(const int& king, const int& side, CheckInfo& info) const;
+
+        /**
+         * What generateChecks() works out once about the enemy King, so that the moves giving check can be read off masks.
+         * pawn, knight, bishop & rook: the cells from which a piece of that type would attack the King (a Queen's are the
+         *     bishop & rook cells together).
+         * discoverers: own pieces standing alone between the King and an own slider; moving one off discovery_rays[cell]
+         *     (the cells from the King up to & including the slider) uncovers a check.
+         */
+        struct CheckTargets {
+            uint64_t pawn;
+            uint64_t knight;
+            uint64_t bishop;
+            uint64_t rook;
+            uint64_t discoverers;
+            uint64_t discovery_rays[BOARD_LENGTH * BOARD_LENGTH];
+        };
+
+        /**
+         * @brief Fills targets for the enemy King, standing on the given cell, by walking its rays & jump tables once
+         * @param side The player giving check, the player to move
+         */
+        void computeCheckTargets(const int& king, const int& side, CheckTargets& targets) const;
+
+        /**
+         * @brief Narrows the pseudo-legal targets of the piece on cell (see targetsOf()) down to its legal ones
+         * @param info What computeCheckInfo() found about the King of the given side, the player to move
+         */
+        uint64_t legalTargets(const int& cell, const uint64_t& targets, const int& side, const CheckInfo& info);
+
+        /**
+         * @brief Computes castling_rights from the pieces: a right is held if its King & Rook stand unmoved on their starting cells
+         */
+        void deriveCastlingRights();
+
+        /**
+         * @brief Computes the mask of cells whose contents can change the set of moves available to the given piece.
+         *     Sliding pieces depend on every cell along their rays up to and including the first occupied cell, 
+         *     Knights & Kings on their jump targets (and a King that may castle on its whole starting row), and Pawns on the cells
+         *     in front of them and the two forward diagonals. Pieces of an unknown type conservatively depend on the whole board.
+         */
+        uint64_t computeInfluence(const ChessPiece* piece) const;
+
+        /**
+         * @brief Drops every cached entry that belongs to, or depends on, one of the touched cells.
+         * @param touched A mask of the cells whose contents have changed
+         */
+        void invalidate(const uint64_t& touched);
+
+        /**
+         * @brief Gets the Zobrist key of a piece standing on its current cell
+         */
+        uint64_t pieceKey(const ChessPiece* piece) const;
+
+        /**
+         * @brief Computes the Zobrist hash of the whole board from scratch
+         */
+        uint64_t computeHash() const;
+
+        /**
+         * @brief Finds both Kings on the board & stores their cells in king_cells
+         */
+        void locateKings();
+
+        /**
+         * @brief Gets the player a piece belongs to
+         * @return 0 for player one, 1 for player two
+         */
+        int sideOf(const ChessPiece* piece) const;
+
     public:
+        /**
+         * @brief Castling rights, as flags. Player one's starting row is row 0 and player two's row 7. The King starts on column 3
+         *     and castles KINGSIDE with the Rook on column 0 (ending on columns 1 & 2), or QUEENSIDE with the Rook on column 7
+         *     (ending on columns 5 & 4).
+         */
+        enum CastlingRight {
+            PLAYER_ONE_KINGSIDE = 1,
+            PLAYER_ONE_QUEENSIDE = 2,
+            PLAYER_TWO_KINGSIDE = 4,
+            PLAYER_TWO_QUEENSIDE = 8
+        };
+
         /**
          * Default constructor. 
          * @post The board is setup with the following restrictions:
@@ -57,10 +252,29 @@ class ChessBoard {
          * @param instance A 2D vector representing a board state, where each element is a pointer to a ChessPiece.
          * @param p1Turn A boolean indicating whether it's player one's turn. True for player one, false for player two.
          * 
-         * @post Initializes the board layout, sets player one's color to "BLACK" and player two's color to "WHITE".
+         * @post Initializes the board layout with copies of the given pieces (the caller keeps ownership of its own), 
+         *     sets player one's color to "BLACK" and player two's color to "WHITE".
          */
         ChessBoard(const std::vector<std::vector<ChessPiece*>>& board, const bool& p1Turn);
 
+        /**
+         * @brief Copy constructor.
+         * @post The copy shares every piece that other shares (see snapshot()) and gets its own copies of the pieces other owns.
+         */
+        ChessBoard(const ChessBoard& other);
+
+        ChessBoard& operator=(const ChessBoard&) = delete;
+
+        /**
+         * @brief Forks a copy-on-write snapshot of the board, eg. to try a candidate line without disturbing this one.
+         *     The pieces this board owns are frozen into a set shared by both boards, so the snapshot costs its own grid &
+         *     move cache (about 2KB) and no pieces at all; each board then only copies a piece the first time it moves it.
+         * @note Shared pieces are never modified, so forks of one position can be played on different threads.
+         *     Pieces returned by getCell() must not be modified directly.
+         * @return The new board, in the same position as this one
+         */
+        std::unique_ptr<ChessBoard> snapshot();
+
         /**
          * @brief Gets the ChessPiece (if any) at (row, col) on the board
          * 
@@ -70,9 +284,177 @@ class ChessBoard {
          */
         ChessPiece* getCell(const int& row, const int& col) const;
 
+        /**
+         * @brief Gets a mask with only the bit for (row, col) set. Cells are numbered (row * BOARD_LENGTH + col).
+         * @return The single-bit mask for the cell, or 0 if (row, col) is outside the board.
+         */
+        static uint64_t cellMask(const int& row, const int& col);
+
+        /**
+         * @brief Gets the pseudo-legal destinations of the piece at (row, col).
+         *     The answer is cached per cell, and only recomputed once a move touches a cell the piece depends on.
+         * @note Pieces must only be moved through move() for the cache to stay coherent.
+         * @return A mask of the cells the piece can move to (see cellMask()), or 0 if the cell is empty or out of bounds.
+         */
+        uint64_t getMoves(const int& row, const int& col) const;
+
+        /**
+         * @brief Moves the piece at (row, col) to (target_row, target_col), capturing any piece already there.
+         * @pre The piece at (row, col) belongs to the player whose turn it is.
+         * @post On success, the moved piece's row / col are updated and it is flagged as moved, any captured piece is deallocated,
+         *     the turn passes to the other player, and only the cached moves that depended on the two touched cells are invalidated.
+         * @return True if the move was made. False if the piece can't move there (nothing changes).
+         */
+        bool move(const int& row, const int& col, const int& target_row, const int& target_col);
+
+        /**
+         * @brief Plays a move (including castling, en passant & promotions), deallocating anything it captures.
+         * @pre The piece at (move.row(), move.col()) belongs to the player whose turn it is.
+         * @post Same as move(row, col, target_row, target_col). A Pawn reaching its last row without a promotion becomes a Queen.
+         * @return True if the move was made. False if it is not a pseudo-legal move (nothing changes).
+         */
+        bool move(const Move& move);
+
+        /**
+         * @brief Makes a pseudo-legal move without deallocating anything, so that unmakeMove() can take it back.
+         * @pre The move is one of generateMoves()
+         * @post Same as move(), except that a captured piece is only taken off the board & remembered in undo
+         *     (it stays alive until unmakeMove() puts it back, so moves made this way must be taken back)
+         * @param undo Filled with what unmakeMove() needs
+         */
+        void makeMove(const Move& move, MoveUndo& undo);
+
+        /**
+         * @brief Takes back the last move made with makeMove()
+         * @pre move & undo are the arguments of the last makeMove() call that was not taken back yet
+         */
+        void unmakeMove(const Move& move, const MoveUndo& undo);
+
+        /**
+         * @brief Appends every pseudo-legal move of the player whose turn it is (ie. moves that may leave their own King in check)
+         *     Moves are listed by origin cell, then by target cell. Promotions are listed as four moves, to a Queen, Rook, Bishop & Knight.
+         */
+        void generateMoves(MoveList& moves) const;
+
+        /**
+         * @brief Appends the pseudo-legal captures (en passant included) & promotions of the player whose turn it is,
+         *     in generateMoves() order
+         */
+        void generateCaptures(MoveList& moves) const;
+
+        /**
+         * @brief Appends the pseudo-legal moves that generateCaptures() leaves out, in generateMoves() order
+         */
+        void generateQuiets(MoveList& moves) const;
+
+        /**
+         * @brief Determines if a move is one of generateMoves(), eg. to check that a move remembered from another
+         *     position can be played in this one
+         */
+        bool isPseudoLegal(const Move& move) const;
+
+        /**
+         * @brief Determines if a pseudo-legal move captures or promotes, ie. if it is one of generateCaptures()
+         */
+        bool isCapture(const Move& move) const;
+
+        /**
+         * @brief Determines if a pseudo-legal move castles out of check or through an attacked cell. Looking at the King
+         *     after the move (see isInCheck()) only covers the cell it ends on.
+         * @return False for any move that does not castle
+         */
+        bool castlesThroughCheck(const Move& move) const;
+
+        /**
+         * @brief Appends every legal move of the player whose turn it is (ie. pseudo-legal moves that don't leave their King in check,
+         *     and castling moves that don't start from, pass through or end on an attacked cell)
+         */
+        void generateLegalMoves(MoveList& moves);
+
+        /**
+         * @brief Gets the move at a position of generateLegalMoves() order without building the list. Only the King, pinned
+         *     pieces, captures en passant & evasions have their moves tested one by one; every other piece is skipped over
+         *     by counting its targets.
+         * @return True if index is in range, in which case move is set. False otherwise.
+         */
+        bool legalMoveAt(int index, Move& move);
+
+        /**
+         * @brief Appends the legal moves of the player whose turn it is that give check, in generateLegalMoves() order.
+         *     A move checks directly when it lands where its piece attacks the enemy King, or by discovery when it leaves
+         *     the line between the King and an own slider (see computeCheckTargets()). Promotions, castling & captures en
+         *     passant, which change more than one cell of a line, are played out instead.
+         *     (When the player is in check, generateLegalMoves() itself generates the evasions.)
+         */
+        void generateChecks(MoveList& moves);
+
+        /**
+         * @brief Determines if a piece of the given player could capture a piece standing on (row, col)
+         * @pre (row, col) is occupied by a piece of the other player (eg. their King)
+         */
+        bool isAttacked(const int& row, const int& col, const bool& byPlayerOne) const;
+
+        /**
+         * @brief Determines if the given player's King can be captured by the other player
+         * @return True if the player is in check. False otherwise, or if the player has no King.
+         */
+        bool isInCheck(const bool& playerOne) const;
+
+        /**
+         * @brief Builds a board from a position in Forsyth-Edwards Notation, eg. 
+         *     "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+         *     White (uppercase) is player one, and files / ranks map to cells as described in Notation.
+         *     Only the piece placement & side to move fields are required. Castling rights are only granted to Kings & Rooks
+         *     on their starting cells, and an en passant cell is only kept if a Pawn can capture onto it.
+         * @return The board, or nullptr if the text is not a valid position (eg. bad field, not exactly one King per player)
+         */
+        static std::unique_ptr<ChessBoard> fromFen(const std::string& fen);
+
+        /**
+         * @brief Builds a board from the contents of its cells, eg. to unpack a position stored without text
+         * @param symbols The piece on every cell (row * 8 + col) as a FEN letter (uppercase for player one), or 0 if the cell is empty
+         * @param castling_rights CastlingRight flags, only granted to Kings & Rooks on their starting cells
+         * @param en_passant_cell The cell the player to move may capture onto en passant, or -1. Only kept if a Pawn can.
+         * @return The board, or nullptr if a symbol is unknown or either player has no King or several
+         */
+        static std::unique_ptr<ChessBoard> fromCells(const char* symbols, const bool& player_one_turn, const int& castling_rights,
+            const int& en_passant_cell);
+
+        /**
+         * @brief Gets the position in Forsyth-Edwards Notation (see fromFen())
+         */
+        std::string toFen() const;
+
+        /**
+         * @brief Getter for the playerOneTurn member
+         */
+        bool isPlayerOneTurn() const;
+
+        /**
+         * @brief Gets the color of player one's pieces (p1_color), or of player two's pieces (p2_color)
+         * @param playerOne True to get player one's color, false to get player two's
+         */
+        std::string getPlayerColor(const bool& playerOne) const;
+
+        /**
+         * @brief Gets the CastlingRight flags still held by either player
+         */
+        int getCastlingRights() const;
+
+        /**
+         * @brief Gets the cell (row * BOARD_LENGTH + col) the player whose turn it is can capture onto en passant, or -1 if there is none
+         */
+        int getEnPassantCell() const;
+
+        /**
+         * @brief Gets the Zobrist hash of the current position (pieces on their cells, the player to move, castling rights & en passant)
+         *     Equal positions always have equal hashes, and the hash is kept up to date by move() at the cost of a few XORs.
+         */
+        uint64_t getHash() const;
+
         /**
          * @brief Destructor. 
-         * @post Deallocates all ChessPiece pointers stored on the board at time of deletion. 
+         * @post Deallocates all ChessPiece pointers the board owns at time of deletion (shared pieces go with their last board). 
          */
         ~ChessBoard();
 };
\ No newline at end of file
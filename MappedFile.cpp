@@ -0,0 +1,114 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : mapping_{nullptr}, size_{0} {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the file, if one is mapped
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : mapping_{other.mapping_}, size_{other.size_} {
+    other.mapping_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapping_ = other.mapping_;
+        size_ = other.size_;
+        other.mapping_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Maps a whole file for reading, unmapping any file mapped before
+ * @param min_size The smallest valid file (eg. its header's size)
+ * @return True if the file exists, holds at least min_size bytes and was mapped. False otherwise.
+ */
+bool MappedFile::open(const std::string& path, const size_t& min_size, const Access& access) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat info;
+    const bool mapped = fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= min_size && info.st_size > 0 &&
+        mapDescriptor(fd, static_cast<size_t>(info.st_size), PROT_READ, access);
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    return mapped;
+}
+
+/**
+ * @brief Maps the first size bytes of an open descriptor for reading & writing, unmapping any file mapped before.
+ *     The descriptor is left open.
+ * @return True if the bytes were mapped. False otherwise.
+ */
+bool MappedFile::map(const int& fd, const size_t& size, const Access& access) {
+    close();
+    return size > 0 && mapDescriptor(fd, size, PROT_READ | PROT_WRITE, access);
+}
+
+/**
+ * @brief Unmaps the file, if one is mapped
+ */
+void MappedFile::close() {
+    if (mapping_) { munmap(mapping_, size_); }
+    mapping_ = nullptr;
+    size_ = 0;
+}
+
+/**
+ * @brief Determines if a file is mapped
+ */
+bool MappedFile::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+/**
+ * @brief Gets the first mapped byte, or nullptr if no file is mapped
+ */
+const uint8_t* MappedFile::data() const {
+    return static_cast<const uint8_t*>(mapping_);
+}
+
+uint8_t* MappedFile::data() {
+    return static_cast<uint8_t*>(mapping_);
+}
+
+/**
+ * @brief Gets the number of mapped bytes (0 if no file is mapped)
+ */
+size_t MappedFile::size() const {
+    return size_;
+}
+
+/**
+ * @brief Maps size bytes of fd & applies the access hint
+ * @pre No file is mapped
+ */
+bool MappedFile::mapDescriptor(const int& fd, const size_t& size, const int& protection, const Access& access) {
+    void* mapping = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) { return false; }
+
+    // Only hints: a failure (eg. no huge pages for shared memory on this system) changes nothing
+    if (access == SEQUENTIAL) { madvise(mapping, size, MADV_SEQUENTIAL); }
+    if (access == RANDOM) { madvise(mapping, size, MADV_RANDOM); }
+#ifdef MADV_HUGEPAGE
+    if (access == HUGE_PAGES) { madvise(mapping, size, MADV_HUGEPAGE); }
+#endif
+
+    mapping_ = mapping;
+    size_ = size;
+    return true;
+}
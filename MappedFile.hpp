@@ -0,0 +1,86 @@
+/**
+ * @class MappedFile
+ * @brief Owns a memory mapping of a file (or of a shared-memory segment), unmapping it when closed or destroyed.
+ *
+ * Every on-disk format of the engine (opening books, tablebases, NNUE weights, game archives & position indexes) is
+ * read straight from such a mapping, and a shared TranspositionTable lives in one. The caller checks the mapped bytes,
+ * and only then keeps the mapping (mappings may be moved, eg. into a member), so that a rejected file leaves nothing
+ * behind. The mapping stays valid after the file descriptor is closed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+    public:
+        /**
+         * @brief How the mapping will be read, passed on to the kernel as a hint
+         */
+        enum Access {
+            NORMAL,
+            SEQUENTIAL,     // Mostly front to back: read well ahead
+            RANDOM,         // Lookups landing on unrelated pages, where read-ahead would only waste I/O
+            HUGE_PAGES      // A large table touched everywhere: back it with transparent huge pages where the system allows it
+        };
+
+        MappedFile();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the file, if one is mapped
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Maps a whole file for reading, unmapping any file mapped before
+         * @param min_size The smallest valid file (eg. its header's size)
+         * @return True if the file exists, holds at least min_size bytes and was mapped. False otherwise.
+         */
+        bool open(const std::string& path, const size_t& min_size, const Access& access = NORMAL);
+
+        /**
+         * @brief Maps the first size bytes of an open descriptor for reading & writing, unmapping any file mapped before.
+         *     The descriptor is left open.
+         * @return True if the bytes were mapped. False otherwise.
+         */
+        bool map(const int& fd, const size_t& size, const Access& access = NORMAL);
+
+        /**
+         * @brief Unmaps the file, if one is mapped
+         */
+        void close();
+
+        /**
+         * @brief Determines if a file is mapped
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Gets the first mapped byte, or nullptr if no file is mapped
+         */
+        const uint8_t* data() const;
+        uint8_t* data();
+
+        /**
+         * @brief Gets the number of mapped bytes (0 if no file is mapped)
+         */
+        size_t size() const;
+
+    private:
+        void* mapping_;
+        size_t size_;
+
+        /**
+         * @brief Maps size bytes of fd & applies the access hint
+         * @pre No file is mapped
+         */
+        bool mapDescriptor(const int& fd, const size_t& size, const int& protection, const Access& access);
+};
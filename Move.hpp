@@ -0,0 +1,88 @@
+/**
+ * @class Move
+ * @brief A move of the piece on (row, col) of a ChessBoard to (target_row, target_col), packed into 16 bits.
+ *
+ * Castling is written as the King's move (two columns towards the Rook), and en passant as the Pawn's diagonal move onto
+ * the empty cell it captures through. A Pawn reaching the last row names the piece it becomes in promotion.
+ *
+ * Layout (bit 0 first): origin cell (6 bits, numbered as in GameBoard) | target cell (6) | promotion piece (2: N, B, R, Q) |
+ * promotion flag (1) | unused (1). Castling & en passant need no flag of their own: they follow from the moving piece &
+ * the target, and leaving them out lets a move parsed from text compare equal to the generated one.
+ * The all-zero move (a1 to a1, which no piece can play) means "no move"; it is what Move() builds.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "BoardGeometry.hpp"
+
+class Move {
+    public:
+        /**
+         * @brief Constructs "no move" when value-initialized (Move() or Move{}), and leaves the move unset otherwise,
+         *     like any other plain value
+         */
+        Move() = default;
+
+        /**
+         * @param promotion 'Q', 'R', 'B' or 'N' for a promotion, 0 otherwise
+         * @pre (row, col) & (target_row, target_col) are on the board (see GameBoard)
+         */
+        constexpr Move(const int& row, const int& col, const int& target_row, const int& target_col, const char& promotion = 0) :
+            data_{static_cast<uint16_t>(GameBoard::cell(row, col) | GameBoard::cell(target_row, target_col) << 6 | promotionBits(promotion))} {}
+
+        int row() const { return GameBoard::rowOf(from()); }
+        int col() const { return GameBoard::colOf(from()); }
+        int targetRow() const { return GameBoard::rowOf(to()); }
+        int targetCol() const { return GameBoard::colOf(to()); }
+
+        /**
+         * @brief Gets the origin cell, GameBoard::cell(row(), col())
+         */
+        int from() const { return data_ & 0x3F; }
+
+        /**
+         * @brief Gets the target cell, GameBoard::cell(targetRow(), targetCol())
+         */
+        int to() const { return (data_ >> 6) & 0x3F; }
+
+        /**
+         * @brief Gets the piece a Pawn is promoted to ('Q', 'R', 'B' or 'N'), or 0 if the move is not a promotion
+         */
+        char promotion() const { return (data_ & PROMOTION_FLAG) ? "NBRQ"[(data_ >> 12) & 3] : 0; }
+
+        /**
+         * @brief Determines if this is "no move" (see the class description)
+         */
+        bool isNone() const { return data_ == 0; }
+
+        /**
+         * @brief Gets the 16-bit encoding, eg. to store the move in a table
+         */
+        uint16_t raw() const { return data_; }
+
+        /**
+         * @brief Rebuilds a move from its raw() encoding
+         */
+        static Move fromRaw(const uint16_t& raw) {
+            Move move;
+            move.data_ = raw;
+            return move;
+        }
+
+        bool operator==(const Move& other) const { return data_ == other.data_; }
+        bool operator!=(const Move& other) const { return data_ != other.data_; }
+
+    private:
+        static constexpr uint16_t PROMOTION_FLAG = 1 << 14;
+
+        uint16_t data_;
+
+        static constexpr uint16_t promotionBits(const char& promotion) {
+            return promotion == 'N' ? PROMOTION_FLAG : promotion == 'B' ? PROMOTION_FLAG | 1 << 12 :
+                promotion == 'R' ? PROMOTION_FLAG | 2 << 12 : promotion == 'Q' ? PROMOTION_FLAG | 3 << 12 : 0;
+        }
+};
+
+static_assert(sizeof(Move) == 2, "Moves are packed into 16 bits");
+static_assert(GameBoard::CELLS <= 64, "Move cells are packed into 6 bits");
@@ -0,0 +1,41 @@
+/**
+ * @class MoveList
+ * @brief A list of moves held in place, with room for any position's moves, so that generating them allocates nothing.
+ *
+ * No reachable position has more than 218 legal moves, nor more than CAPACITY pseudo-legal ones. A full list takes
+ * 512 bytes, so the lists of a whole search line stay in the L1 cache. The moves are left unset until pushed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "Move.hpp"
+
+class MoveList {
+    public:
+        static const size_t CAPACITY = 256;
+
+        MoveList() : size_{0} {}
+
+        /**
+         * @pre size() < CAPACITY
+         */
+        void push_back(const Move& move) { moves_[size_++] = move; }
+
+        void clear() { size_ = 0; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        Move& operator[](const size_t& index) { return moves_[index]; }
+        const Move& operator[](const size_t& index) const { return moves_[index]; }
+        const Move& front() const { return moves_[0]; }
+
+        Move* begin() { return moves_; }
+        Move* end() { return moves_ + size_; }
+        const Move* begin() const { return moves_; }
+        const Move* end() const { return moves_ + size_; }
+
+    private:
+        Move moves_[CAPACITY];
+        size_t size_;
+};
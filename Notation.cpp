@@ -0,0 +1,72 @@
+#include "Notation.hpp"
+
+#include <cctype>
+
+/**
+ * @brief Gets the name of the cell at (row, col), eg. "e2"
+ */
+std::string Notation::cellName(const int& row, const int& col) {
+    std::string name;
+    name += static_cast<char>('a' + (GameBoard::COLS - 1 - col));
+    name += static_cast<char>('1' + row);
+    return name;
+}
+
+/**
+ * @brief Parses a cell name such as "e2"
+ * @return True if text starts with a valid cell name, in which case row & col are set. False otherwise.
+ */
+bool Notation::parseCell(const std::string& text, int& row, int& col) {
+    if (text.size() < 2) { return false; }
+
+    int file = text[0] - 'a';
+    int rank = text[1] - '1';
+    if (file < 0 || file >= GameBoard::COLS || rank < 0 || rank >= GameBoard::ROWS) { return false; }
+
+    row = rank;
+    col = GameBoard::COLS - 1 - file;
+    return true;
+}
+
+/**
+ * @brief Gets the coordinate notation of a move, eg. "e2e4"
+ */
+std::string Notation::moveName(const int& row, const int& col, const int& target_row, const int& target_col) {
+    return cellName(row, col) + cellName(target_row, target_col);
+}
+
+/**
+ * @brief Parses a move in coordinate notation such as "e2e4"
+ * @return True if text is a valid move, in which case the four coordinates are set. False otherwise.
+ */
+bool Notation::parseMove(const std::string& text, int& row, int& col, int& target_row, int& target_col) {
+    if (text.size() != 4) { return false; }
+    return parseCell(text.substr(0, 2), row, col) && parseCell(text.substr(2, 2), target_row, target_col);
+}
+
+/**
+ * @brief Gets the coordinate notation of a move, with the promotion in lowercase if there is one, eg. "e2e4", "e7e8q"
+ */
+std::string Notation::moveName(const Move& move) {
+    std::string name = moveName(move.row(), move.col(), move.targetRow(), move.targetCol());
+    if (move.promotion()) { name += static_cast<char>(std::tolower(move.promotion())); }
+    return name;
+}
+
+/**
+ * @brief Parses a move in coordinate notation such as "e2e4", or "e7e8q" for a promotion
+ * @return True if text is a valid move, in which case move is set (promotion being 0 without one). False otherwise.
+ */
+bool Notation::parseMove(const std::string& text, Move& move) {
+    if (text.size() != 4 && text.size() != 5) { return false; }
+
+    char promotion = 0;
+    if (text.size() == 5) {
+        promotion = static_cast<char>(std::toupper(text[4]));
+        if (promotion != 'Q' && promotion != 'R' && promotion != 'B' && promotion != 'N') { return false; }
+    }
+    int row, col, target_row, target_col;
+    if (!parseMove(text.substr(0, 4), row, col, target_row, target_col)) { return false; }
+    move = Move(row, col, target_row, target_col, promotion);
+    return true;
+}
@@ -0,0 +1,48 @@
+/**
+ * @class Notation
+ * @brief Converts between board cells and standard coordinate notation (eg. "e2", "e2e4").
+ *
+ * Player one starts on row 0 and moves first, so it plays the part of White: rank 1 is row 0, and since the King starts on
+ * column 3 (the e-file in standard chess), files run right to left, ie. file 'a' is column GameBoard::COLS - 1 and 'h' is column 0.
+ */
+
+#pragma once
+
+#include <string>
+#include "Move.hpp"
+
+class Notation {
+    public:
+        /**
+         * @brief Gets the name of the cell at (row, col), eg. "e2"
+         */
+        static std::string cellName(const int& row, const int& col);
+
+        /**
+         * @brief Parses a cell name such as "e2"
+         * @return True if text starts with a valid cell name, in which case row & col are set. False otherwise.
+         */
+        static bool parseCell(const std::string& text, int& row, int& col);
+
+        /**
+         * @brief Gets the coordinate notation of a move, eg. "e2e4"
+         */
+        static std::string moveName(const int& row, const int& col, const int& target_row, const int& target_col);
+
+        /**
+         * @brief Parses a move in coordinate notation such as "e2e4"
+         * @return True if text is a valid move, in which case the four coordinates are set. False otherwise.
+         */
+        static bool parseMove(const std::string& text, int& row, int& col, int& target_row, int& target_col);
+
+        /**
+         * @brief Gets the coordinate notation of a move, with the promotion in lowercase if there is one, eg. "e2e4", "e7e8q"
+         */
+        static std::string moveName(const Move& move);
+
+        /**
+         * @brief Parses a move in coordinate notation such as "e2e4", or "e7e8q" for a promotion
+         * @return True if text is a valid move, in which case move is set (promotion being 0 without one). False otherwise.
+         */
+        static bool parseMove(const std::string& text, Move& move);
+};
@@ -0,0 +1,19 @@
+/**
+ * @brief Fork-join helper for the builders that split their work into a fixed number of parts (eg. TrainingSetBuilder,
+ *     PositionIndexBuilder): each part runs on its own thread, and the call returns once every part is done.
+ */
+
+#pragma once
+
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs function(i) for every i in [0, count), each on its own thread, and waits for all of them
+ */
+template <typename Function>
+void parallelFor(const unsigned& count, Function function) {
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < count; i++) { workers.emplace_back(function, i); }
+    for (std::thread& worker : workers) { worker.join(); }
+}
@@ -0,0 +1,32 @@
+/**
+ * @class SplitMix64
+ * @brief The splitmix64 generator & its finalizer, shared by everything that needs cheap, well-spread 64-bit values
+ *     (Zobrist keys, chunk shuffles, hashes of packed positions & Bloom filter probes).
+ *
+ * The sequence of a state is fixed, so values drawn from a fixed seed are identical across runs and builds.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class SplitMix64 {
+    public:
+        static constexpr uint64_t GAMMA = 0x9E3779B97F4A7C15ULL;   // Added to the state for every value drawn
+
+        /**
+         * @brief Finalizer of splitmix64: every input bit affects every output bit
+         */
+        static uint64_t mix(uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        /**
+         * @brief Advances state & draws its next value
+         */
+        static uint64_t next(uint64_t& state) {
+            return mix(state += GAMMA);
+        }
+};
@@ -0,0 +1,77 @@
+#include "Zobrist.hpp"
+#include "SplitMix64.hpp"
+
+#include <string>
+
+namespace {
+    const std::string SYMBOLS = "PNBRQK";
+
+    struct Keys {
+        // One extra row of keys covers pieces whose type is not a standard chess piece
+        uint64_t pieces[2][7][Zobrist::CELLS];
+        uint64_t side_to_move;
+        uint64_t castling[16];  // XOR of the keys of the rights set in the index
+        uint64_t en_passant[GameBoard::COLS];
+
+        Keys() {
+            // splitmix64, seeded with a fixed constant so that keys never change between runs
+            uint64_t state = SplitMix64::GAMMA;
+            auto next = [&state] () { return SplitMix64::next(state); };
+
+            for (auto& side : pieces) {
+                for (auto& type : side) {
+                    for (uint64_t& key : type) { key = next(); }
+                }
+            }
+            side_to_move = next();
+
+            // Drawn after the older keys, so that positions without castling rights or en passant keep their hashes
+            const uint64_t rights[4] = {next(), next(), next(), next()};
+            for (int set = 0; set < 16; set++) {
+                castling[set] = 0;
+                for (int right = 0; right < 4; right++) {
+                    if (set & (1 << right)) { castling[set] ^= rights[right]; }
+                }
+            }
+            for (uint64_t& key : en_passant) { key = next(); }
+        }
+    };
+
+    const Keys& keys() {
+        static const Keys instance;
+        return instance;
+    }
+}
+
+/**
+ * @brief Gets the key of a piece on a cell
+ * @param side 0 for player one's pieces, 1 for player two's
+ * @param symbol The piece's symbol (see ChessPiece::getSymbol())
+ * @param cell The cell index (see GameBoard)
+ */
+uint64_t Zobrist::piece(const int& side, const char& symbol, const int& cell) {
+    size_t type = SYMBOLS.find(symbol);
+    if (type == std::string::npos) { type = SYMBOLS.size(); }
+    return keys().pieces[side][type][cell];
+}
+
+/**
+ * @brief Gets the key XORed in while it is player two's turn
+ */
+uint64_t Zobrist::sideToMove() {
+    return keys().side_to_move;
+}
+
+/**
+ * @brief Gets the combined key of a set of castling rights (see ChessBoard::CastlingRight). No rights hash to 0.
+ */
+uint64_t Zobrist::castling(const int& rights) {
+    return keys().castling[rights & 15];
+}
+
+/**
+ * @brief Gets the key XORed in while a Pawn standing next to the Pawn that just double jumped on column col can capture it en passant
+ */
+uint64_t Zobrist::enPassant(const int& col) {
+    return keys().en_passant[col];
+}
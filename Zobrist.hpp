@@ -0,0 +1,41 @@
+/**
+ * @class Zobrist
+ * @brief Random keys used to hash board positions (Zobrist hashing).
+ *
+ * The hash of a position is the XOR of one key per (side, piece type, cell) that is occupied, plus the side-to-move key
+ * when it is player two's turn, one key per castling right still held and one key for the column of a possible en passant capture. Since XOR is its own inverse, a move only needs to XOR out / in the keys of the cells it touches.
+ * Keys are generated from a fixed seed, so hashes are identical across runs and builds (eg. for on-disk opening books).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "BoardGeometry.hpp"
+
+class Zobrist {
+    public:
+        static const int CELLS = GameBoard::CELLS;
+
+        /**
+         * @brief Gets the key of a piece on a cell
+         * @param side 0 for player one's pieces, 1 for player two's
+         * @param symbol The piece's symbol (see ChessPiece::getSymbol())
+         * @param cell The cell index (see GameBoard)
+         */
+        static uint64_t piece(const int& side, const char& symbol, const int& cell);
+
+        /**
+         * @brief Gets the key XORed in while it is player two's turn
+         */
+        static uint64_t sideToMove();
+
+        /**
+         * @brief Gets the combined key of a set of castling rights (see ChessBoard::CastlingRight). No rights hash to 0.
+         */
+        static uint64_t castling(const int& rights);
+
+        /**
+         * @brief Gets the key XORed in while a Pawn standing next to the Pawn that just double jumped on column col can capture it en passant
+         */
+        static uint64_t enPassant(const int& col);
+};
@@ -0,0 +1,210 @@
+#include "AnalysisScheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    long long milliseconds(const std::chrono::steady_clock::duration& duration) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    }
+}
+
+/**
+ * @brief Gets the throughput in jobs (positions) finished per second, whatever their status
+ */
+double AnalysisScheduler::Stats::positionsPerSecond() const {
+    return (completed + partial + expired + no_moves) / std::max(seconds, 1e-9);
+}
+
+/**
+ * @brief Constructs a scheduler & starts its workers
+ * @param threads The number of workers. 0 uses one per hardware thread.
+ * @param network Evaluates positions when not null (see Search::setNetwork()); must outlive the scheduler
+ * @param on_result Called with every result, from the worker that produced it
+ */
+AnalysisScheduler::AnalysisScheduler(unsigned threads, const size_t& hash_megabytes, const NnueNetwork* network,
+    const std::function<void(const AnalysisResult&)>& on_result) : table_{hash_megabytes}, network_{network}, on_result_{on_result},
+    next_id_{1}, unfinished_{0}, shutdown_{false}, started_{false} {
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    for (unsigned t = 0; t < threads; t++) { workers_.emplace_back(&AnalysisScheduler::work, this); }
+}
+
+/**
+ * @brief Destructor.
+ * @post Queued jobs are dropped, running ones stopped, and the workers joined
+ */
+AnalysisScheduler::~AnalysisScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+        for (Search* search : running_) { search->stop(); }
+    }
+    queued_.notify_all();
+    for (std::thread& worker : workers_) { worker.join(); }
+}
+
+/**
+ * @brief Moves the transposition table into a named shared-memory segment (see TranspositionTable::openShared())
+ * @pre No job has been submitted yet
+ * @return True if the segment was opened
+ */
+bool AnalysisScheduler::openSharedTable(const std::string& name) {
+    return table_.openShared(name);
+}
+
+/**
+ * @brief Gets the size of the transposition table in megabytes (see TranspositionTable::getMegabytes())
+ */
+size_t AnalysisScheduler::getTableMegabytes() const {
+    return table_.getMegabytes();
+}
+
+/**
+ * @brief Queues a job. Safe to call from any thread.
+ * @return The job's id (from 1), which its result carries, or 0 if the position is invalid
+ */
+uint64_t AnalysisScheduler::submit(const AnalysisJob& job) {
+    Queued queued;
+    queued.job = job;
+    queued.board = job.fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(job.fen);
+    if (!queued.board) { return 0; }
+    queued.submitted = std::chrono::steady_clock::now();
+    queued.deadline = queued.submitted + std::chrono::milliseconds(std::max(0LL, job.deadline));
+
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_) {
+            started_ = true;
+            first_submission_ = queued.submitted;
+        }
+        id = queued.id = next_id_++;
+        unfinished_++;
+        queue_.push_back(std::move(queued));
+        std::push_heap(queue_.begin(), queue_.end(), runsAfter);
+    }
+    queued_.notify_one();
+    return id;
+}
+
+/**
+ * @brief Waits until every submitted job has produced its result
+ */
+void AnalysisScheduler::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+/**
+ * @brief Gets the totals over the jobs finished so far
+ */
+AnalysisScheduler::Stats AnalysisScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.seconds = started_ ? std::chrono::duration<double>(last_result_ - first_submission_).count() : 0;
+    return stats;
+}
+
+/**
+ * @brief Body of a worker: runs jobs until the scheduler shuts down
+ */
+void AnalysisScheduler::work() {
+    while (true) {
+        Queued queued;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queued_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+            if (shutdown_) { return; }
+            std::pop_heap(queue_.begin(), queue_.end(), runsAfter);
+            queued = std::move(queue_.back());
+            queue_.pop_back();
+        }
+
+        const AnalysisResult result = run(queued);
+        {
+            std::lock_guard<std::mutex> lock(result_mutex_);
+            if (on_result_) { on_result_(result); }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const AnalysisResult::Status status = result.status;
+            (status == AnalysisResult::COMPLETE ? stats_.completed : status == AnalysisResult::PARTIAL ? stats_.partial :
+                status == AnalysisResult::EXPIRED ? stats_.expired : stats_.no_moves)++;
+            stats_.nodes += result.nodes;
+            last_result_ = std::chrono::steady_clock::now();
+            unfinished_--;
+        }
+        idle_.notify_all();
+    }
+}
+
+/**
+ * @brief Searches a job
+ */
+AnalysisResult AnalysisScheduler::run(Queued& queued) {
+    AnalysisResult result;
+    result.id = queued.id;
+    const auto start = std::chrono::steady_clock::now();
+    result.wait_time = milliseconds(start - queued.submitted);
+
+    SearchLimits limits;
+    limits.depth = std::max(1, std::min(queued.job.depth, static_cast<int>(Search::MAX_PLY)));
+    if (queued.job.deadline > 0) {
+        limits.movetime = milliseconds(queued.deadline - start);
+        if (limits.movetime <= 0) {
+            result.status = AnalysisResult::EXPIRED;
+            return result;
+        }
+    }
+
+    MoveList moves;
+    queued.board->generateLegalMoves(moves);
+    if (moves.empty()) {
+        result.status = AnalysisResult::NO_MOVES;
+        return result;
+    }
+    limits.multi_pv = std::max(1, std::min(queued.job.multi_pv, static_cast<int>(moves.size())));
+
+    // Lines are kept once every variation of an iteration is in, so they always come from the same depth
+    Search search(*queued.board, table_);
+    search.setNetwork(network_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shutdown_) { search.stop(); }
+        running_.push_back(&search);
+    }
+    std::vector<AnalysisLine> current;
+    search.run(limits, [&] (const SearchInfo& info) {
+        if (info.pv.empty()) { return; }
+        if (info.multi_pv == 1) { current.clear(); }
+        current.push_back(AnalysisLine{info.score, info.pv});
+        if (info.multi_pv == limits.multi_pv) {
+            result.lines = current;
+            result.depth = info.depth;
+        }
+    });
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.erase(std::find(running_.begin(), running_.end(), &search));
+    }
+
+    result.nodes = search.getNodes();
+    result.search_time = milliseconds(std::chrono::steady_clock::now() - start);
+    const bool finished_mate = !result.lines.empty() && Search::isMateScore(result.lines[0].score) &&
+        Search::MATE_SCORE - std::abs(result.lines[0].score) <= result.depth;
+    result.status = (result.depth >= limits.depth || finished_mate) ? AnalysisResult::COMPLETE : AnalysisResult::PARTIAL;
+    return result;
+}
+
+/**
+ * @brief Heap order of the queue: whether a should run after b
+ */
+bool AnalysisScheduler::runsAfter(const Queued& a, const Queued& b) {
+    if (a.job.priority != b.job.priority) { return a.job.priority < b.job.priority; }
+    const bool a_deadline = a.job.deadline > 0;
+    const bool b_deadline = b.job.deadline > 0;
+    if (a_deadline != b_deadline) { return !a_deadline; }
+    if (a_deadline && a.deadline != b.deadline) { return a.deadline > b.deadline; }
+    return a.id > b.id;
+}
@@ -0,0 +1,181 @@
+/**
+ * @class AnalysisScheduler
+ * @brief Runs bursts of analysis jobs ("search this position to depth D with K principal variations") on a pool of
+ *     worker threads.
+ *
+ * submit() builds the job's ChessBoard straight away, so that an invalid position is rejected before it is queued.
+ * Workers take the queued job with the highest priority first, then the one with the earliest deadline, then the
+ * oldest, and search it with a Search of their own. All searches share one TranspositionTable, so jobs on related
+ * positions (eg. successive positions of a game) start from each other's results. The table may be moved into a named
+ * shared-memory segment (see openSharedTable()) to share results with other processes on the host as well.
+ *
+ * A job's deadline is counted from its submission. A job still queued at its deadline is dropped (EXPIRED) rather than
+ * searched; a running one is cut short with whatever its last finished iteration found (PARTIAL).
+ * Results are handed to a callback on the worker's thread, one call at a time.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ChessBoard.hpp"
+#include "../search/NnueNetwork.hpp"
+#include "../search/Search.hpp"
+#include "../search/TranspositionTable.hpp"
+
+/**
+ * @brief A position to analyse & how
+ */
+struct AnalysisJob {
+    std::string fen;            // The position, or empty for the standard starting position
+    int depth = 8;              // Deepest iteration to search
+    int multi_pv = 1;           // Principal variations to report
+    int priority = 0;           // Higher priorities are searched first
+    long long deadline = 0;     // Milliseconds from submission by which the result is wanted, or 0 for no deadline
+};
+
+/**
+ * @brief One principal variation of a result
+ */
+struct AnalysisLine {
+    int score;                  // Centipawns for the player to move (see SearchInfo)
+    std::vector<Move> pv;
+};
+
+/**
+ * @brief The outcome of a job
+ */
+struct AnalysisResult {
+    enum Status : uint8_t {
+        COMPLETE,   // Searched to the job's depth, or to a forced mate no deeper search could shorten
+        PARTIAL,    // The deadline stopped the search early; lines hold its last finished iteration, if any
+        EXPIRED,    // The deadline passed before the job was started
+        NO_MOVES    // The player to move is checkmated or stalemated
+    };
+
+    uint64_t id = 0;
+    Status status = COMPLETE;
+    int depth = 0;                      // Depth of the lines
+    std::vector<AnalysisLine> lines;    // Best first
+    long long nodes = 0;
+    long long wait_time = 0;            // Milliseconds spent queued
+    long long search_time = 0;          // Milliseconds spent searching
+};
+
+class AnalysisScheduler {
+    public:
+        /**
+         * @brief Totals over the jobs finished so far
+         */
+        struct Stats {
+            long long completed = 0;
+            long long partial = 0;
+            long long expired = 0;
+            long long no_moves = 0;
+            long long nodes = 0;
+            double seconds = 0;         // From the first submission to the last result
+
+            /**
+             * @brief Gets the throughput in jobs (positions) finished per second, whatever their status
+             */
+            double positionsPerSecond() const;
+        };
+
+        /**
+         * @brief Constructs a scheduler & starts its workers
+         * @param threads The number of workers. 0 uses one per hardware thread.
+         * @param network Evaluates positions when not null (see Search::setNetwork()); must outlive the scheduler
+         * @param on_result Called with every result, from the worker that produced it
+         */
+        AnalysisScheduler(unsigned threads, const size_t& hash_megabytes, const NnueNetwork* network,
+            const std::function<void(const AnalysisResult&)>& on_result);
+
+        /**
+         * @brief Destructor.
+         * @post Queued jobs are dropped, running ones stopped, and the workers joined
+         */
+        ~AnalysisScheduler();
+
+        AnalysisScheduler(const AnalysisScheduler&) = delete;
+        AnalysisScheduler& operator=(const AnalysisScheduler&) = delete;
+
+        /**
+         * @brief Moves the transposition table into a named shared-memory segment (see TranspositionTable::openShared())
+         * @pre No job has been submitted yet
+         * @return True if the segment was opened
+         */
+        bool openSharedTable(const std::string& name);
+
+        /**
+         * @brief Gets the size of the transposition table in megabytes (see TranspositionTable::getMegabytes())
+         */
+        size_t getTableMegabytes() const;
+
+        /**
+         * @brief Queues a job. Safe to call from any thread.
+         * @return The job's id (from 1), which its result carries, or 0 if the position is invalid
+         */
+        uint64_t submit(const AnalysisJob& job);
+
+        /**
+         * @brief Waits until every submitted job has produced its result
+         */
+        void wait();
+
+        /**
+         * @brief Gets the totals over the jobs finished so far
+         */
+        Stats getStats() const;
+
+    private:
+        struct Queued {
+            uint64_t id;
+            AnalysisJob job;
+            std::unique_ptr<ChessBoard> board;
+            std::chrono::steady_clock::time_point submitted;
+            std::chrono::steady_clock::time_point deadline;     // Only meaningful when job.deadline > 0
+        };
+
+        TranspositionTable table_;
+        const NnueNetwork* network_;
+        std::function<void(const AnalysisResult&)> on_result_;
+
+        mutable std::mutex mutex_;          // Guards everything below
+        std::condition_variable queued_;    // Signalled when a job is queued or the scheduler shuts down
+        std::condition_variable idle_;      // Signalled when a job finishes
+        std::vector<Queued> queue_;         // A heap, ordered by runsAfter()
+        std::vector<Search*> running_;      // Searches in progress, to stop them on shutdown
+        uint64_t next_id_;
+        long long unfinished_;              // Jobs submitted but not finished
+        bool shutdown_;
+        bool started_;
+        std::chrono::steady_clock::time_point first_submission_;
+        std::chrono::steady_clock::time_point last_result_;
+        Stats stats_;
+
+        std::mutex result_mutex_;           // Serializes on_result_
+        std::vector<std::thread> workers_;
+
+        /**
+         * @brief Body of a worker: runs jobs until the scheduler shuts down
+         */
+        void work();
+
+        /**
+         * @brief Searches a job
+         */
+        AnalysisResult run(Queued& queued);
+
+        /**
+         * @brief Heap order of the queue: whether a should run after b
+         */
+        static bool runsAfter(const Queued& a, const Queued& b);
+};
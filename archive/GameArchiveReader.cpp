@@ -0,0 +1,175 @@
+#include "GameArchiveReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+GameArchiveReader::GameArchiveReader() : data_{nullptr}, index_{nullptr},
+    blocks_{0}, games_{0}, index_offset_{0}, position_{0}, game_{0} {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the archive
+ */
+GameArchiveReader::~GameArchiveReader() {
+    close();
+}
+
+/**
+ * @brief Memory-maps an archive and positions the reader on its first game
+ * @return True if the file exists and is a complete archive. False otherwise.
+ */
+bool GameArchiveReader::open(const std::string& path) {
+    close();
+
+    // Games are mostly read front to back
+    MappedFile file;
+    if (!file.open(path, sizeof(ArchiveHeader) + sizeof(ArchiveTrailer), MappedFile::SEQUENTIAL)) { return false; }
+
+    const uint8_t* data = file.data();
+    ArchiveHeader header;
+    ArchiveTrailer trailer;
+    std::memcpy(&header, data, sizeof(header));
+    std::memcpy(&trailer, data + file.size() - sizeof(trailer), sizeof(trailer));
+
+    const uint64_t index_end = file.size() - sizeof(trailer);
+    bool valid = std::memcmp(header.magic, "P4GA", 4) == 0 && header.version >= OLDEST_VERSION && header.version <= VERSION &&
+        std::memcmp(trailer.magic, "P4GAEND", 8) == 0 && trailer.index_offset >= sizeof(header) &&
+        trailer.index_offset <= index_end && (index_end - trailer.index_offset) / sizeof(ArchiveBlock) == trailer.blocks &&
+        trailer.index_offset % alignof(ArchiveBlock) == 0;
+    if (!valid) { return false; }
+
+    file_ = std::move(file);
+    data_ = data;
+    index_ = reinterpret_cast<const ArchiveBlock*>(data + trailer.index_offset);
+    blocks_ = trailer.blocks;
+    games_ = trailer.games;
+    index_offset_ = trailer.index_offset;
+    position_ = sizeof(ArchiveHeader);
+    game_ = 0;
+    return true;
+}
+
+/**
+ * @brief Gets the number of games in the archive
+ */
+uint64_t GameArchiveReader::size() const {
+    return games_;
+}
+
+/**
+ * @brief Positions the reader on a game, so that the next call to next() returns it
+ * @return True if the game exists. False otherwise (the position is unchanged).
+ */
+bool GameArchiveReader::seek(const uint64_t& game) {
+    if (game >= games_ || blocks_ == 0) { return false; }
+
+    // Last block whose first game is not past the target
+    const ArchiveBlock* block = std::upper_bound(index_, index_ + blocks_, game, [] (const uint64_t& target, const ArchiveBlock& entry) {
+        return target < entry.first_game;
+    }) - 1;
+
+    uint64_t offset = block->offset;
+    for (uint64_t skipped = block->first_game; skipped < game; skipped++) {
+        uint64_t plies;
+        uint8_t result;
+        offset = readHeader(offset, plies, result, nullptr);
+        if (offset == 0) { return false; }
+        offset += plies;
+    }
+
+    position_ = offset;
+    game_ = game;
+    return true;
+}
+
+/**
+ * @brief Decodes the game at the reader's position and moves on to the next one
+ * @return True if a game was read. False at the end of the archive, or if the game is corrupt.
+ */
+bool GameArchiveReader::next(GameRecord& record) {
+    return decode(record, nullptr);
+}
+
+/**
+ * @brief Same as next(record), and also appends the ChessBoard::getHash() of every position of the game
+ *     (the starting position, then the position after each move) to hashes
+ */
+bool GameArchiveReader::next(GameRecord& record, std::vector<uint64_t>& hashes) {
+    return decode(record, &hashes);
+}
+
+/**
+ * @brief Implements both next() overloads; hashes may be null
+ */
+bool GameArchiveReader::decode(GameRecord& record, std::vector<uint64_t>* hashes) {
+    if (game_ >= games_) { return false; }
+
+    uint64_t plies;
+    uint8_t result;
+    uint64_t offset = readHeader(position_, plies, result, &record.fen);
+    if (offset == 0 || plies > index_offset_ - offset || result > GameRecord::DRAW) { return false; }
+
+    record.moves.clear();
+    record.result = static_cast<GameRecord::Result>(result);
+
+    std::unique_ptr<ChessBoard> board = record.fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(record.fen);
+    if (!board) { return false; }
+    if (hashes) { hashes->push_back(board->getHash()); }
+    for (uint64_t ply = 0; ply < plies; ply++) {
+        Move move;
+        if (!board->legalMoveAt(data_[offset + ply], move)) { return false; }
+
+        board->move(move);
+        record.moves.push_back(move);
+        if (hashes) { hashes->push_back(board->getHash()); }
+    }
+
+    position_ = offset + plies;
+    game_++;
+    return true;
+}
+
+/**
+ * @brief Unmaps the current archive, if any
+ */
+void GameArchiveReader::close() {
+    file_.close();
+    data_ = nullptr;
+    index_ = nullptr;
+    blocks_ = games_ = index_offset_ = position_ = game_ = 0;
+}
+
+/**
+ * @brief Reads the varint ply count, result & starting FEN (if any) of the game at offset
+ * @param fen Set to the FEN, or emptied for the standard starting position. May be null to skip it.
+ * @return The offset of the game's first move, or 0 if the game runs past the end of the data
+ */
+uint64_t GameArchiveReader::readHeader(uint64_t offset, uint64_t& plies, uint8_t& result, std::string* fen) const {
+    offset = readVarint(offset, plies);
+    if (offset == 0 || offset >= index_offset_) { return 0; }
+    result = data_[offset++];
+    if (fen) { fen->clear(); }
+    if (!(result & START_FEN)) { return offset; }
+
+    result &= ~START_FEN;
+    uint64_t length;
+    offset = readVarint(offset, length);
+    if (offset == 0 || length > index_offset_ - offset) { return 0; }
+    if (fen) { fen->assign(reinterpret_cast<const char*>(data_ + offset), length); }
+    return offset + length;
+}
+
+/**
+ * @brief Reads a varint at offset
+ * @return The offset right after it, or 0 if it runs past the end of the data
+ */
+uint64_t GameArchiveReader::readVarint(uint64_t offset, uint64_t& value) const {
+    value = 0;
+    for (int shift = 0; ; shift += 7) {
+        if (offset >= index_offset_ || shift > 56) { return 0; }
+        const uint8_t byte = data_[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) { return offset; }
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @class GameArchiveReader
+ * @brief Reads games back from a binary game archive (".p4ga") written by GameArchiveWriter.
+ *
+ * Every move is stored as its index in the list of legal moves of the position it was played from, as generated by
+ * ChessBoard::generateLegalMoves() (ordered by origin cell, then target cell). ChessBoard::legalMoveAt() finds it without
+ * building the list, only playing out the moves that could leave the King in check. No position has more than 218 legal
+ * moves, so a move takes exactly one byte. A game is encoded as:
+ *
+ *      varint ply count | result byte (GameRecord::Result) | [varint FEN length | FEN] | one byte per ply
+ *
+ * The FEN is only there for games that do not start from the standard starting position, which set the result byte's
+ * START_FEN bit (version 3; version 2 archives have no such games, and are read as they are).
+ *
+ * Games are grouped into blocks of a fixed number of games, and the file is laid out as
+ *
+ *      ArchiveHeader | block 0 | block 1 | ... | ArchiveBlock index (one per block) | ArchiveTrailer
+ *
+ * The file is memory-mapped. seek() finds the block holding a game with a binary search over the index, then skips the
+ * games before it by their ply counts without replaying them; next() replays a game on a ChessBoard to decode its moves.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameRecord.hpp"
+#include "../ChessBoard.hpp"
+#include "../MappedFile.hpp"
+
+/**
+ * @brief Start of an archive file
+ */
+struct ArchiveHeader {
+    char magic[4];              // "P4GA"
+    uint32_t version;           // Currently 3
+    uint32_t games_per_block;   // Games in every block but the last
+    uint32_t reserved;
+};
+
+/**
+ * @brief One entry of the block index
+ */
+struct ArchiveBlock {
+    uint64_t offset;            // File offset of the block's first game
+    uint64_t first_game;        // Number of the block's first game
+};
+
+/**
+ * @brief End of an archive file. A file without a valid trailer was not closed properly.
+ */
+struct ArchiveTrailer {
+    uint64_t index_offset;      // File offset of the block index
+    uint64_t blocks;            // Entries in the block index
+    uint64_t games;             // Games in the archive
+    char magic[8];              // "P4GAEND" followed by a zero
+};
+
+class GameArchiveReader {
+    public:
+        static const uint32_t VERSION = 3;
+        static const uint32_t OLDEST_VERSION = 2;   // Oldest version that can still be read
+        static const uint8_t START_FEN = 0x80;      // Result byte flag of a game that starts from a FEN
+
+        GameArchiveReader();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the archive
+         */
+        ~GameArchiveReader();
+
+        GameArchiveReader(const GameArchiveReader&) = delete;
+        GameArchiveReader& operator=(const GameArchiveReader&) = delete;
+
+        /**
+         * @brief Memory-maps an archive and positions the reader on its first game
+         * @return True if the file exists and is a complete archive. False otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Gets the number of games in the archive
+         */
+        uint64_t size() const;
+
+        /**
+         * @brief Positions the reader on a game, so that the next call to next() returns it
+         * @return True if the game exists. False otherwise (the position is unchanged).
+         */
+        bool seek(const uint64_t& game);
+
+        /**
+         * @brief Decodes the game at the reader's position and moves on to the next one
+         * @return True if a game was read. False at the end of the archive, or if the game is corrupt.
+         */
+        bool next(GameRecord& record);
+
+        /**
+         * @brief Same as next(record), and also appends the ChessBoard::getHash() of every position of the game
+         *     (the starting position, then the position after each move) to hashes
+         */
+        bool next(GameRecord& record, std::vector<uint64_t>& hashes);
+
+    private:
+        MappedFile file_;
+        const uint8_t* data_;
+        const ArchiveBlock* index_;
+        uint64_t blocks_;
+        uint64_t games_;
+        uint64_t index_offset_;     // End of the game data
+        uint64_t position_;         // File offset of the next game
+        uint64_t game_;             // Number of the next game
+
+        /**
+         * @brief Unmaps the current archive, if any
+         */
+        void close();
+
+        /**
+         * @brief Reads the varint ply count, result & starting FEN (if any) of the game at offset
+         * @param fen Set to the FEN, or emptied for the standard starting position. May be null to skip it.
+         * @return The offset of the game's first move, or 0 if the game runs past the end of the data
+         */
+        uint64_t readHeader(uint64_t offset, uint64_t& plies, uint8_t& result, std::string* fen) const;
+
+        /**
+         * @brief Reads a varint at offset
+         * @return The offset right after it, or 0 if it runs past the end of the data
+         */
+        uint64_t readVarint(uint64_t offset, uint64_t& value) const;
+
+        /**
+         * @brief Implements both next() overloads; hashes may be null
+         */
+        bool decode(GameRecord& record, std::vector<uint64_t>* hashes);
+};
@@ -0,0 +1,140 @@
+#include "GameArchiveWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+GameArchiveWriter::GameArchiveWriter() : games_per_block_{DEFAULT_GAMES_PER_BLOCK}, games_{0}, offset_{0}, block_games_{0} {}
+
+/**
+ * @brief Destructor.
+ * @post Closes the archive if it is still open
+ */
+GameArchiveWriter::~GameArchiveWriter() {
+    if (out_.is_open()) { close(); }
+}
+
+/**
+ * @brief Creates (or truncates) an archive file and writes its header
+ * @param games_per_block Games per block of the index. Smaller blocks make seeking cheaper at the cost of a bigger index.
+ * @return True if the file could be created. False otherwise.
+ */
+bool GameArchiveWriter::open(const std::string& path, const uint32_t& games_per_block) {
+    if (out_.is_open()) { close(); }
+
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) { return false; }
+
+    games_per_block_ = games_per_block > 0 ? games_per_block : DEFAULT_GAMES_PER_BLOCK;
+    games_ = 0;
+    block_.clear();
+    block_games_ = 0;
+    index_.clear();
+
+    ArchiveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "P4GA", 4);
+    header.version = GameArchiveReader::VERSION;
+    header.games_per_block = games_per_block_;
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset_ = sizeof(header);
+    return static_cast<bool>(out_);
+}
+
+/**
+ * @brief Appends a game
+ * @return True if the game was added. False (and nothing is added) if a move is illegal or the archive is not open.
+ */
+bool GameArchiveWriter::write(const GameRecord& record) {
+    if (!out_.is_open()) { return false; }
+
+    std::unique_ptr<ChessBoard> board = record.fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(record.fen);
+    if (!board) { return false; }
+
+    encoded_.clear();
+    appendVarint(record.moves.size());
+    if (record.fen.empty()) {
+        encoded_.push_back(record.result);
+    } else {
+        encoded_.push_back(record.result | GameArchiveReader::START_FEN);
+        appendVarint(record.fen.size());
+        encoded_.insert(encoded_.end(), record.fen.begin(), record.fen.end());
+    }
+
+    MoveList legal;
+    for (const Move& move : record.moves) {
+        legal.clear();
+        board->generateLegalMoves(legal);
+
+        // Like ChessBoard::move(), a Pawn reaching its last row without a promotion becomes a Queen
+        const Move queen(move.row(), move.col(), move.targetRow(), move.targetCol(), 'Q');
+        const Move* choice = std::find_if(legal.begin(), legal.end(), [&] (const Move& candidate) {
+            return candidate.raw() == move.raw() || (!move.promotion() && candidate.raw() == queen.raw());
+        });
+        if (choice == legal.end()) { return false; }
+
+        board->move(*choice);
+        encoded_.push_back(static_cast<uint8_t>(choice - legal.begin()));
+    }
+
+    block_.insert(block_.end(), encoded_.begin(), encoded_.end());
+    games_++;
+    if (++block_games_ == games_per_block_) { return flush(); }
+    return true;
+}
+
+/**
+ * @brief Gets the number of games added so far
+ */
+uint64_t GameArchiveWriter::size() const {
+    return games_;
+}
+
+/**
+ * @brief Writes the last block, the block index and the trailer, then closes the file
+ * @return True if everything was written. False otherwise.
+ */
+bool GameArchiveWriter::close() {
+    if (!out_.is_open()) { return false; }
+    flush();
+
+    // Align the index so that readers can use it in place
+    static const char padding[alignof(ArchiveBlock)] = {};
+    const size_t pad = (alignof(ArchiveBlock) - offset_ % alignof(ArchiveBlock)) % alignof(ArchiveBlock);
+    out_.write(padding, static_cast<std::streamsize>(pad));
+    offset_ += pad;
+
+    ArchiveTrailer trailer;
+    std::memset(&trailer, 0, sizeof(trailer));
+    trailer.index_offset = offset_;
+    trailer.blocks = index_.size();
+    trailer.games = games_;
+    std::memcpy(trailer.magic, "P4GAEND", 8);
+
+    out_.write(reinterpret_cast<const char*>(index_.data()), static_cast<std::streamsize>(index_.size() * sizeof(ArchiveBlock)));
+    out_.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+    const bool written = static_cast<bool>(out_);
+    out_.close();
+    return written;
+}
+
+/**
+ * @brief Appends a varint to the game being encoded
+ */
+void GameArchiveWriter::appendVarint(uint64_t value) {
+    for (; value >= 0x80; value >>= 7) { encoded_.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80)); }
+    encoded_.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Appends the buffered block to the file and records it in the index
+ */
+bool GameArchiveWriter::flush() {
+    if (block_games_ == 0) { return true; }
+
+    index_.push_back({offset_, games_ - block_games_});
+    out_.write(reinterpret_cast<const char*>(block_.data()), static_cast<std::streamsize>(block_.size()));
+    offset_ += block_.size();
+    block_.clear();
+    block_games_ = 0;
+    return static_cast<bool>(out_);
+}
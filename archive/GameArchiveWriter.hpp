@@ -0,0 +1,75 @@
+/**
+ * @class GameArchiveWriter
+ * @brief Streams games into a binary game archive (see GameArchiveReader for the format).
+ *
+ * Games are replayed on a ChessBoard to turn each move into its move-list index, buffered one block at a time, and
+ * appended to the file as soon as a block is full. The block index and trailer are written by close().
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "GameArchiveReader.hpp"
+#include "GameRecord.hpp"
+
+class GameArchiveWriter {
+    public:
+        static constexpr uint32_t DEFAULT_GAMES_PER_BLOCK = 4096;
+
+        GameArchiveWriter();
+
+        /**
+         * @brief Destructor.
+         * @post Closes the archive if it is still open
+         */
+        ~GameArchiveWriter();
+
+        GameArchiveWriter(const GameArchiveWriter&) = delete;
+        GameArchiveWriter& operator=(const GameArchiveWriter&) = delete;
+
+        /**
+         * @brief Creates (or truncates) an archive file and writes its header
+         * @param games_per_block Games per block of the index. Smaller blocks make seeking cheaper at the cost of a bigger index.
+         * @return True if the file could be created. False otherwise.
+         */
+        bool open(const std::string& path, const uint32_t& games_per_block = DEFAULT_GAMES_PER_BLOCK);
+
+        /**
+         * @brief Appends a game
+         * @return True if the game was added. False (and nothing is added) if a move is illegal or the archive is not open.
+         */
+        bool write(const GameRecord& record);
+
+        /**
+         * @brief Gets the number of games added so far
+         */
+        uint64_t size() const;
+
+        /**
+         * @brief Writes the last block, the block index and the trailer, then closes the file
+         * @return True if everything was written. False otherwise.
+         */
+        bool close();
+
+    private:
+        std::ofstream out_;
+        uint32_t games_per_block_;
+        uint64_t games_;
+        uint64_t offset_;                   // File offset where the buffered block starts
+        std::vector<uint8_t> block_;        // Encoded games of the current block
+        uint32_t block_games_;
+        std::vector<ArchiveBlock> index_;
+        std::vector<uint8_t> encoded_;      // Scratch buffer for the game being encoded
+
+        /**
+         * @brief Appends a varint to the game being encoded
+         */
+        void appendVarint(uint64_t value);
+
+        /**
+         * @brief Appends the buffered block to the file and records it in the index
+         */
+        bool flush();
+};
@@ -0,0 +1,62 @@
+#include "GameRecord.hpp"
+#include "../Notation.hpp"
+
+#include <sstream>
+
+namespace {
+    const char* const RESULT_NAMES[] = {"*", "1-0", "0-1", "1/2-1/2"};
+}
+
+/**
+ * @brief Parses a game line (see the struct description). The moves are only checked for syntax, not legality.
+ * @return True if every token was a move or a trailing result. False otherwise.
+ */
+bool GameRecord::parse(const std::string& line, GameRecord& record) {
+    record.fen.clear();
+    record.moves.clear();
+    record.result = UNFINISHED;
+
+    std::istringstream stream(line);
+    std::string token;
+    if (stream >> token && token == "fen") {
+        while (stream >> token && token != "moves") { record.fen += (record.fen.empty() ? "" : " ") + token; }
+        if (record.fen.empty()) { return false; }
+    } else {
+        stream.clear();
+        stream.seekg(0);
+    }
+
+    bool finished = false;
+    while (stream >> token) {
+        if (finished) { return false; }     // Nothing may follow the result
+
+        bool is_result = false;
+        for (uint8_t result = UNFINISHED; result <= DRAW; result++) {
+            if (token == RESULT_NAMES[result]) {
+                record.result = static_cast<Result>(result);
+                is_result = true;
+            }
+        }
+        if (is_result) {
+            finished = true;
+            continue;
+        }
+
+        Move move;
+        if (!Notation::parseMove(token, move)) { return false; }
+        record.moves.push_back(move);
+    }
+    return true;
+}
+
+/**
+ * @brief Formats a game as a line (see the struct description)
+ */
+std::string GameRecord::toString() const {
+    std::string line = fen.empty() ? "" : "fen " + fen + " moves ";
+    for (const Move& move : moves) {
+        line += Notation::moveName(move);
+        line += ' ';
+    }
+    return line + RESULT_NAMES[result];
+}
@@ -0,0 +1,44 @@
+/**
+ * @struct GameRecord
+ * @brief A finished (or abandoned) game: the position it started from, its moves and its result.
+ *
+ * As text, a game is one line of coordinate moves (see Notation) separated by whitespace, optionally followed by the
+ * result ("1-0", "0-1", "1/2-1/2" or "*"), as read by BookBuilder. eg.
+ *
+ *      e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 1-0
+ *
+ * A game that does not start from the standard starting position is prefixed with its FEN, the way UCI sets positions:
+ *
+ *      fen 4k3/8/8/8/8/8/4P3/4K3 w - - 0 1 moves e2e4 e8d7 *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Move.hpp"
+
+struct GameRecord {
+    enum Result : uint8_t {
+        UNFINISHED = 0,         // "*", or no result given
+        PLAYER_ONE_WINS = 1,    // "1-0"
+        PLAYER_TWO_WINS = 2,    // "0-1"
+        DRAW = 3                // "1/2-1/2"
+    };
+
+    std::string fen;            // Starting position (see ChessBoard::fromFen()), or empty for the standard one
+    std::vector<Move> moves;
+    Result result = UNFINISHED;
+
+    /**
+     * @brief Parses a game line (see the struct description). The moves are only checked for syntax, not legality.
+     * @return True if every token was a move or a trailing result. False otherwise.
+     */
+    static bool parse(const std::string& line, GameRecord& record);
+
+    /**
+     * @brief Formats a game as a line (see the struct description)
+     */
+    std::string toString() const;
+};
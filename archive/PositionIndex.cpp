@@ -0,0 +1,210 @@
+#include "PositionIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <utility>
+
+namespace {
+    // Results are padded so that the key table that follows is 8-byte aligned
+    uint64_t paddedResults(const uint64_t& games) {
+        return (games + 7) & ~uint64_t{7};
+    }
+}
+
+PositionIndex::PositionIndex() : header_{nullptr}, results_{nullptr}, keys_{nullptr}, postings_{nullptr} {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the index
+ */
+PositionIndex::~PositionIndex() {}
+
+/**
+ * @brief Memory-maps an index file
+ * @return True if the file exists and is a valid index. False otherwise.
+ */
+bool PositionIndex::open(const std::string& path) {
+    if (file_.isOpen()) { return false; }
+
+    // Lookups jump around the whole file
+    MappedFile file;
+    if (!file.open(path, sizeof(PositionIndexHeader), MappedFile::RANDOM)) { return false; }
+
+    const uint8_t* data = file.data();
+    const PositionIndexHeader* header = reinterpret_cast<const PositionIndexHeader*>(data);
+
+    // Compare sizes piece by piece, so that a corrupt header can't overflow the sum
+    uint64_t available = file.size() - sizeof(PositionIndexHeader);
+    bool valid = std::memcmp(header->magic, "P4PI", 4) == 0 && header->version == VERSION &&
+        header->games <= available && paddedResults(header->games) <= available;
+    if (valid) {
+        available -= paddedResults(header->games);
+        valid = header->keys <= available / sizeof(PositionKey) && header->postings_size <= available - header->keys * sizeof(PositionKey);
+    }
+    if (!valid) { return false; }
+
+    file_ = std::move(file);
+    header_ = header;
+    results_ = data + sizeof(PositionIndexHeader);
+    keys_ = reinterpret_cast<const PositionKey*>(results_ + paddedResults(header->games));
+    postings_ = reinterpret_cast<const uint8_t*>(keys_ + header->keys);
+    return true;
+}
+
+/**
+ * @brief Gets the number of distinct positions in the index
+ */
+uint64_t PositionIndex::positions() const {
+    return header_ ? header_->keys : 0;
+}
+
+/**
+ * @brief Gets the number of games in the indexed archive
+ */
+uint64_t PositionIndex::games() const {
+    return header_ ? header_->games : 0;
+}
+
+/**
+ * @brief Gets the result of a game of the indexed archive (UNFINISHED for an unknown game)
+ */
+GameRecord::Result PositionIndex::result(const uint64_t& game) const {
+    if (game >= games() || results_[game] > GameRecord::DRAW) { return GameRecord::UNFINISHED; }
+    return static_cast<GameRecord::Result>(results_[game]);
+}
+
+/**
+ * @brief Counts the games that reached a position, without decoding its posting list
+ */
+uint64_t PositionIndex::count(const uint64_t& hash) const {
+    const PositionKey* key = lookup(hash);
+    return key ? key->count : 0;
+}
+
+/**
+ * @brief Gets the games that reached a position, in increasing order
+ * @return True if the position is in the index. False otherwise (games is left empty).
+ */
+bool PositionIndex::find(const uint64_t& hash, std::vector<uint64_t>& games) const {
+    games.clear();
+    const PositionKey* key = lookup(hash);
+    if (!key) { return false; }
+    decode(*key, games);
+    return true;
+}
+
+/**
+ * @brief Gets the games that reached every one of several positions, in increasing order.
+ *     Long posting lists are decoded on separate threads, then intersected smallest first.
+ */
+void PositionIndex::findAll(const std::vector<uint64_t>& hashes, std::vector<uint64_t>& games) const {
+    games.clear();
+    std::vector<const PositionKey*> keys;
+    for (const uint64_t& hash : hashes) {
+        const PositionKey* key = lookup(hash);
+        if (!key) { return; }
+        keys.push_back(key);
+    }
+    if (keys.empty()) { return; }
+
+    // Intersecting smallest first keeps every intermediate result as short as possible
+    std::sort(keys.begin(), keys.end(), [] (const PositionKey* a, const PositionKey* b) { return a->count < b->count; });
+
+    std::vector<std::vector<uint64_t>> lists(keys.size());
+    std::vector<std::future<void>> pending;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (keys[i]->count >= PARALLEL_THRESHOLD) {
+            pending.push_back(std::async(std::launch::async, [this, &keys, &lists, i] { decode(*keys[i], lists[i]); }));
+        } else {
+            decode(*keys[i], lists[i]);
+        }
+    }
+    for (std::future<void>& task : pending) { task.get(); }
+
+    games.swap(lists[0]);
+    std::vector<uint64_t> merged;
+    for (size_t i = 1; i < lists.size() && !games.empty(); i++) {
+        merged.clear();
+        std::set_intersection(games.begin(), games.end(), lists[i].begin(), lists[i].end(), std::back_inserter(merged));
+        games.swap(merged);
+    }
+}
+
+/**
+ * @brief Counts the results of the games that reached a position
+ */
+PositionIndex::Stats PositionIndex::stats(const uint64_t& hash) const {
+    Stats stats{0, 0, 0, 0};
+    std::vector<uint64_t> games;
+    if (!find(hash, games)) { return stats; }
+
+    stats.games = games.size();
+    for (const uint64_t& game : games) {
+        switch (result(game)) {
+            case GameRecord::PLAYER_ONE_WINS: stats.player_one_wins++; break;
+            case GameRecord::PLAYER_TWO_WINS: stats.player_two_wins++; break;
+            case GameRecord::DRAW: stats.draws++; break;
+            default: break;
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Finds the key table entry of a position
+ * @return The entry, or nullptr if the position is not in the index
+ */
+const PositionKey* PositionIndex::lookup(const uint64_t& hash) const {
+    const uint64_t count = positions();
+    if (count == 0) { return nullptr; }
+
+    // Find the first key that is >= hash, within [low, high)
+    uint64_t low = 0;
+    uint64_t high = count;
+    int steps = 0;
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+
+        // Hashes are uniform, so the hash's rank among [low, high) is a good guess of where it sits
+        uint64_t low_hash = keys_[low].hash;
+        uint64_t high_hash = keys_[high - 1].hash;
+        if (steps++ < INTERPOLATION_STEPS && hash > low_hash && hash < high_hash) {
+            unsigned __int128 offset = static_cast<unsigned __int128>(hash - low_hash) * (high - 1 - low) / (high_hash - low_hash);
+            middle = low + static_cast<uint64_t>(offset);
+        }
+
+        if (keys_[middle].hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low == count || keys_[low].hash != hash) { return nullptr; }
+    const PositionKey* key = keys_ + low;
+    if (key->offset > header_->postings_size || key->size > header_->postings_size - key->offset) { return nullptr; }
+    return key;
+}
+
+/**
+ * @brief Decodes the posting list of a key into games (replacing its contents)
+ */
+void PositionIndex::decode(const PositionKey& key, std::vector<uint64_t>& games) const {
+    games.clear();
+    games.reserve(key.count);
+
+    const uint8_t* data = postings_ + key.offset;
+    const uint8_t* end = data + key.size;
+    uint64_t game = 0;
+    while (data < end && games.size() < key.count) {
+        uint64_t gap = 0;
+        for (int shift = 0; data < end && shift <= 63; shift += 7) {
+            const uint8_t byte = *data++;
+            gap |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) { break; }
+        }
+        game += gap;
+        games.push_back(game);
+    }
+}
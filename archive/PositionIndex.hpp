@@ -0,0 +1,133 @@
+/**
+ * @class PositionIndex
+ * @brief Answers "which games reached this position" over a game archive, from an index file built by PositionIndexBuilder.
+ *
+ * The index maps every ChessBoard::getHash() seen in the archive to the sorted list of games (archive numbers) that
+ * reached it. An index file (".p4pi") is laid out as
+ *
+ *      PositionIndexHeader | one GameRecord::Result byte per game (padded to 8 bytes) | PositionKey table | postings
+ *
+ * The key table is sorted by hash and searched like OpeningBook's records. Each key's posting list is stored as the
+ * varint-encoded gaps between consecutive game numbers, which takes one or two bytes per game for common positions.
+ * The file is memory-mapped, so opening it costs no parsing and a lookup touches a handful of pages.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameRecord.hpp"
+#include "../MappedFile.hpp"
+
+/**
+ * @brief Start of an index file
+ */
+struct PositionIndexHeader {
+    char magic[4];          // "P4PI"
+    uint32_t version;       // Currently 2
+    uint64_t games;         // Games in the indexed archive
+    uint64_t keys;          // Entries in the key table
+    uint64_t postings_size; // Bytes of posting lists following the key table
+};
+
+/**
+ * @brief One entry of the key table
+ */
+struct PositionKey {
+    uint64_t hash;          // ChessBoard::getHash() of the position
+    uint64_t offset;        // Offset of the posting list from the start of the postings
+    uint32_t count;         // Games in the posting list
+    uint32_t size;          // Bytes of the posting list
+};
+
+class PositionIndex {
+    public:
+        static const uint32_t VERSION = 2;
+
+        /**
+         * @brief Game counts of a position, by result
+         */
+        struct Stats {
+            uint64_t games;
+            uint64_t player_one_wins;
+            uint64_t player_two_wins;
+            uint64_t draws;
+        };
+
+        PositionIndex();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the index
+         */
+        ~PositionIndex();
+
+        PositionIndex(const PositionIndex&) = delete;
+        PositionIndex& operator=(const PositionIndex&) = delete;
+
+        /**
+         * @brief Memory-maps an index file
+         * @return True if the file exists and is a valid index. False otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Gets the number of distinct positions in the index
+         */
+        uint64_t positions() const;
+
+        /**
+         * @brief Gets the number of games in the indexed archive
+         */
+        uint64_t games() const;
+
+        /**
+         * @brief Gets the result of a game of the indexed archive (UNFINISHED for an unknown game)
+         */
+        GameRecord::Result result(const uint64_t& game) const;
+
+        /**
+         * @brief Counts the games that reached a position, without decoding its posting list
+         */
+        uint64_t count(const uint64_t& hash) const;
+
+        /**
+         * @brief Gets the games that reached a position, in increasing order
+         * @return True if the position is in the index. False otherwise (games is left empty).
+         */
+        bool find(const uint64_t& hash, std::vector<uint64_t>& games) const;
+
+        /**
+         * @brief Gets the games that reached every one of several positions, in increasing order.
+         *     Long posting lists are decoded on separate threads, then intersected smallest first.
+         */
+        void findAll(const std::vector<uint64_t>& hashes, std::vector<uint64_t>& games) const;
+
+        /**
+         * @brief Counts the results of the games that reached a position
+         */
+        Stats stats(const uint64_t& hash) const;
+
+    private:
+        // Posting lists with at least this many games are worth a thread of their own
+        static const uint32_t PARALLEL_THRESHOLD = 1 << 16;
+        static const int INTERPOLATION_STEPS = 4;
+
+        const PositionIndexHeader* header_;
+        const uint8_t* results_;
+        const PositionKey* keys_;
+        const uint8_t* postings_;
+        MappedFile file_;
+
+        /**
+         * @brief Finds the key table entry of a position
+         * @return The entry, or nullptr if the position is not in the index
+         */
+        const PositionKey* lookup(const uint64_t& hash) const;
+
+        /**
+         * @brief Decodes the posting list of a key into games (replacing its contents)
+         */
+        void decode(const PositionKey& key, std::vector<uint64_t>& games) const;
+};
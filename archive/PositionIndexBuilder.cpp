@@ -0,0 +1,152 @@
+#include "PositionIndexBuilder.hpp"
+#include "GameArchiveReader.hpp"
+#include "PositionIndex.hpp"
+#include "../Parallel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Posting = std::pair<uint64_t, uint64_t>;  // (hash, game)
+
+    // Key table & postings of one hash range, with offsets relative to the range's own postings
+    struct Range {
+        std::vector<PositionKey> keys;
+        std::vector<uint8_t> postings;
+    };
+
+    void appendVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+}
+
+/**
+ * @brief Constructs a builder
+ * @param threads The number of worker threads. 0 uses one per hardware thread.
+ */
+PositionIndexBuilder::PositionIndexBuilder(const unsigned& threads) : threads_{threads ? threads : std::thread::hardware_concurrency()} {
+    if (threads_ == 0) { threads_ = 1; }
+}
+
+/**
+ * @brief Indexes every game of an archive and writes the index file
+ * @return The number of distinct positions written, or -1 if the archive could not be read or the index written
+ */
+long long PositionIndexBuilder::build(const std::string& archive, const std::string& path) const {
+    uint64_t games = 0;
+    {
+        GameArchiveReader reader;
+        if (!reader.open(archive)) { return -1; }
+        games = reader.size();
+    }
+
+    const unsigned threads = static_cast<unsigned>(std::max<uint64_t>(1, std::min<uint64_t>(threads_, games)));
+    std::vector<std::vector<Posting>> runs(threads);
+    std::vector<uint8_t> results(games, GameRecord::UNFINISHED);
+    std::vector<char> failed(threads, 0);
+
+    // Phase 1: replay a range of games per thread into sorted (hash, game) runs
+    parallelFor(threads, [&] (const unsigned& t) {
+        const uint64_t first = games * t / threads;
+        const uint64_t last = games * (t + 1) / threads;
+        GameArchiveReader reader;
+        if (first == last) { return; }
+        if (!reader.open(archive) || !reader.seek(first)) {
+            failed[t] = 1;
+            return;
+        }
+
+        GameRecord record;
+        std::vector<uint64_t> hashes;
+        for (uint64_t game = first; game < last; game++) {
+            hashes.clear();
+            if (!reader.next(record, hashes)) {
+                failed[t] = 1;
+                return;
+            }
+            results[game] = record.result;
+
+            // A game that repeats a position is only listed once
+            std::sort(hashes.begin(), hashes.end());
+            hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+            for (const uint64_t& hash : hashes) { runs[t].emplace_back(hash, game); }
+        }
+        std::sort(runs[t].begin(), runs[t].end());
+    });
+    if (std::count(failed.begin(), failed.end(), 1) > 0) { return -1; }
+
+    // Phase 2: merge the runs one hash range per thread. Run t only holds games below those of run t + 1,
+    // so taking a hash's postings run by run keeps its list sorted.
+    std::vector<Range> ranges(threads);
+    parallelFor(threads, [&] (const unsigned& r) {
+        const unsigned __int128 span = static_cast<unsigned __int128>(1) << 64;
+        const unsigned __int128 low = span * r / threads;
+        const unsigned __int128 high = span * (r + 1) / threads;
+
+        std::vector<std::vector<Posting>::const_iterator> cursors, ends;
+        for (const std::vector<Posting>& run : runs) {
+            auto by_hash = [] (const Posting& posting, const unsigned __int128& hash) { return posting.first < hash; };
+            cursors.push_back(std::lower_bound(run.begin(), run.end(), low, by_hash));
+            ends.push_back(std::lower_bound(run.begin(), run.end(), high, by_hash));
+        }
+
+        Range& range = ranges[r];
+        while (true) {
+            bool any = false;
+            uint64_t hash = 0;
+            for (size_t i = 0; i < cursors.size(); i++) {
+                if (cursors[i] != ends[i] && (!any || cursors[i]->first < hash)) {
+                    hash = cursors[i]->first;
+                    any = true;
+                }
+            }
+            if (!any) { break; }
+
+            PositionKey key{hash, range.postings.size(), 0, 0};
+            uint64_t previous = 0;
+            for (size_t i = 0; i < cursors.size(); i++) {
+                for (; cursors[i] != ends[i] && cursors[i]->first == hash; ++cursors[i]) {
+                    appendVarint(range.postings, cursors[i]->second - previous);
+                    previous = cursors[i]->second;
+                    key.count++;
+                }
+            }
+            key.size = static_cast<uint32_t>(range.postings.size() - key.offset);
+            range.keys.push_back(key);
+        }
+    });
+    runs.clear();
+
+    // Phase 3: concatenate the ranges
+    PositionIndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "P4PI", 4);
+    header.version = PositionIndex::VERSION;
+    header.games = games;
+    for (Range& range : ranges) {
+        for (PositionKey& key : range.keys) { key.offset += header.postings_size; }
+        header.keys += range.keys.size();
+        header.postings_size += range.postings.size();
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    results.resize((games + 7) & ~uint64_t{7}, GameRecord::UNFINISHED);
+    out.write(reinterpret_cast<const char*>(results.data()), static_cast<std::streamsize>(results.size()));
+    for (const Range& range : ranges) {
+        out.write(reinterpret_cast<const char*>(range.keys.data()), static_cast<std::streamsize>(range.keys.size() * sizeof(PositionKey)));
+    }
+    for (const Range& range : ranges) {
+        out.write(reinterpret_cast<const char*>(range.postings.data()), static_cast<std::streamsize>(range.postings.size()));
+    }
+    if (!out) { return -1; }
+    return static_cast<long long>(header.keys);
+}
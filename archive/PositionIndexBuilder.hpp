@@ -0,0 +1,36 @@
+/**
+ * @class PositionIndexBuilder
+ * @brief Builds a position index (see PositionIndex) by replaying every game of a game archive.
+ *
+ * The build runs in three parallel phases:
+ * 1) The archive is split into one range of games per thread; each thread replays its games and collects a
+ *    (hash, game) pair for every distinct position of every game, then sorts its pairs.
+ * 2) The 64-bit hash space is split into one range per thread; each thread merges the pairs of every phase 1 run that fall
+ *    in its range into posting lists. Runs hold increasing game ranges, so concatenating a hash's pairs run by run
+ *    already gives a sorted list.
+ * 3) The per-range key tables and postings are concatenated into the index file.
+ *
+ * @note Every (hash, game) pair is held in memory until the index is written.
+ */
+
+#pragma once
+
+#include <string>
+
+class PositionIndexBuilder {
+    public:
+        /**
+         * @brief Constructs a builder
+         * @param threads The number of worker threads. 0 uses one per hardware thread.
+         */
+        PositionIndexBuilder(const unsigned& threads = 0);
+
+        /**
+         * @brief Indexes every game of an archive and writes the index file
+         * @return The number of distinct positions written, or -1 if the archive could not be read or the index written
+         */
+        long long build(const std::string& archive, const std::string& path) const;
+
+    private:
+        unsigned threads_;
+};
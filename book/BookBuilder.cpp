@@ -0,0 +1,115 @@
+#include "BookBuilder.hpp"
+#include "../Notation.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+/**
+ * @brief Constructs an empty builder
+ * @param max_plies How many moves of each game go into the book
+ */
+BookBuilder::BookBuilder(const int& max_plies) : max_plies_{max_plies} {}
+
+/**
+ * @brief Replays a single game, given as a line (see the class description), and records its moves
+ * @return True if every move of the game was legal. False if the game stopped early on an illegal or unreadable move
+ *     (the moves before it are still recorded).
+ */
+bool BookBuilder::addGame(const std::string& line) {
+    std::istringstream stream(line);
+    std::vector<std::string> tokens;
+    for (std::string token; stream >> token; ) { tokens.push_back(token); }
+
+    // Winning moves weigh 2, drawing moves 1 and losing moves 0. Without a result every move weighs 1.
+    int weights[2] = {1, 1};
+    if (!tokens.empty()) {
+        const std::string& result = tokens.back();
+        if (result == "1-0") { weights[0] = 2; weights[1] = 0; }
+        if (result == "0-1") { weights[0] = 0; weights[1] = 2; }
+        if (result == "1-0" || result == "0-1" || result == "1/2-1/2" || result == "*") { tokens.pop_back(); }
+    }
+
+    ChessBoard board;
+    MoveList legal;
+    for (size_t ply = 0; ply < tokens.size() && static_cast<int>(ply) < max_plies_; ply++) {
+        Move move;
+        if (!Notation::parseMove(tokens[ply], move)) { return false; }
+
+        // Only legal moves are booked. Like ChessBoard::move(), a Pawn reaching its last row without a promotion becomes a Queen.
+        legal.clear();
+        board.generateLegalMoves(legal);
+        const Move queen(move.row(), move.col(), move.targetRow(), move.targetCol(), 'Q');
+        const Move* choice = std::find_if(legal.begin(), legal.end(), [&] (const Move& candidate) {
+            return candidate.raw() == move.raw() || (!move.promotion() && candidate.raw() == queen.raw());
+        });
+        if (choice == legal.end()) { return false; }
+
+        entries_.push_back(BookEntry{board.getHash(), choice->raw(), static_cast<uint16_t>(weights[board.isPlayerOneTurn() ? 0 : 1]), 1});
+        board.move(*choice);
+    }
+    return true;
+}
+
+/**
+ * @brief Adds every game of a game file
+ * @return The number of games read, or -1 if the file could not be opened
+ */
+int BookBuilder::addGameFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) { return -1; }
+
+    int games = 0;
+    for (std::string line; std::getline(in, line); ) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') { continue; }
+        addGame(line);
+        games++;
+    }
+    return games;
+}
+
+/**
+ * @brief Gets the number of records collected so far (before duplicates are merged)
+ */
+size_t BookBuilder::size() const {
+    return entries_.size();
+}
+
+/**
+ * @brief Sorts the collected records, merges duplicate (position, move) pairs, and writes the book
+ * @return The number of records written, or -1 if the file could not be written
+ */
+long long BookBuilder::write(const std::string& path) {
+    std::sort(entries_.begin(), entries_.end(), [] (const BookEntry& a, const BookEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.move < b.move;
+    });
+
+    // Merge records of the same move in place, saturating the counters instead of wrapping around
+    size_t merged = 0;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (merged > 0 && entries_[merged - 1].key == entries_[i].key && entries_[merged - 1].move == entries_[i].move) {
+            BookEntry& into = entries_[merged - 1];
+            into.weight = static_cast<uint16_t>(std::min<uint32_t>(std::numeric_limits<uint16_t>::max(), uint32_t{into.weight} + entries_[i].weight));
+            into.games = static_cast<uint32_t>(std::min<uint64_t>(std::numeric_limits<uint32_t>::max(), uint64_t{into.games} + entries_[i].games));
+        } else {
+            entries_[merged++] = entries_[i];
+        }
+    }
+    entries_.resize(merged);
+
+    BookHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "P4BK", 4);
+    header.version = OpeningBook::VERSION;
+    header.entry_size = sizeof(BookEntry);
+    header.entries = entries_.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries_.data()), static_cast<std::streamsize>(entries_.size() * sizeof(BookEntry)));
+    if (!out) { return -1; }
+    return static_cast<long long>(entries_.size());
+}
@@ -0,0 +1,54 @@
+/**
+ * @class BookBuilder
+ * @brief Builds a binary opening book (see OpeningBook) from recorded games.
+ *
+ * Games are given one per line, as the moves of the game in coordinate notation (see Notation) separated by whitespace,
+ * optionally followed by the result ("1-0", "0-1" or "1/2-1/2"). Empty lines and lines starting with '#' are skipped. eg.
+ *
+ *      e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 1-0
+ *
+ * Every game is replayed on a ChessBoard, and each of its first max_plies moves adds a record for the position it was played from.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "OpeningBook.hpp"
+
+class BookBuilder {
+    public:
+        /**
+         * @brief Constructs an empty builder
+         * @param max_plies How many moves of each game go into the book
+         */
+        BookBuilder(const int& max_plies = 30);
+
+        /**
+         * @brief Replays a single game, given as a line (see the class description), and records its moves
+         * @return True if every move of the game was legal. False if the game stopped early on an illegal or unreadable move
+         *     (the moves before it are still recorded).
+         */
+        bool addGame(const std::string& line);
+
+        /**
+         * @brief Adds every game of a game file
+         * @return The number of games read, or -1 if the file could not be opened
+         */
+        int addGameFile(const std::string& path);
+
+        /**
+         * @brief Gets the number of records collected so far (before duplicates are merged)
+         */
+        size_t size() const;
+
+        /**
+         * @brief Sorts the collected records, merges duplicate (position, move) pairs, and writes the book
+         * @return The number of records written, or -1 if the file could not be written
+         */
+        long long write(const std::string& path);
+
+    private:
+        int max_plies_;
+        std::vector<BookEntry> entries_;
+};
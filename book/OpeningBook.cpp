@@ -0,0 +1,136 @@
+#include "OpeningBook.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+    const int INTERPOLATION_STEPS = 4; // Afterwards the search falls back to plain bisection, bounding the worst case
+}
+
+OpeningBook::OpeningBook() : entries_{nullptr}, count_{0} {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the book, if one is open
+ */
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+void OpeningBook::close() {
+    file_.close();
+    entries_ = nullptr;
+    count_ = 0;
+}
+
+/**
+ * @brief Memory-maps a book file, closing any book that was open before
+ * @return True if the file exists and is a valid book. False otherwise.
+ */
+bool OpeningBook::open(const std::string& path) {
+    close();
+
+    // Lookups land on unrelated pages, so read-ahead would only waste I/O
+    MappedFile file;
+    if (!file.open(path, sizeof(BookHeader), MappedFile::RANDOM)) { return false; }
+
+    BookHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    bool valid = std::memcmp(header.magic, "P4BK", 4) == 0 && header.version == VERSION &&
+        header.entry_size == sizeof(BookEntry) && file.size() >= sizeof(BookHeader) + header.entries * sizeof(BookEntry);
+    if (!valid) { return false; }
+
+    file_ = std::move(file);
+    entries_ = reinterpret_cast<const BookEntry*>(file_.data() + sizeof(BookHeader));
+    count_ = header.entries;
+    return true;
+}
+
+/**
+ * @brief Gets the number of records in the open book (0 if none is open)
+ */
+size_t OpeningBook::size() const {
+    return count_;
+}
+
+/**
+ * @brief Finds every record of a position
+ * @param key The hash of the position (see ChessBoard::getHash())
+ * @param count Set to the number of records found
+ * @return A pointer to the first record, straight into the mapped file, or nullptr if the position is not in the book
+ */
+const BookEntry* OpeningBook::find(const uint64_t& key, size_t& count) const {
+    count = 0;
+    if (count_ == 0) { return nullptr; }
+
+    // Find the first record whose key is >= key, within [low, high)
+    size_t low = 0;
+    size_t high = count_;
+    int steps = 0;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        // Hashes are uniform, so the key's rank among [low, high) is a good guess of where it sits
+        uint64_t low_key = entries_[low].key;
+        uint64_t high_key = entries_[high - 1].key;
+        if (steps++ < INTERPOLATION_STEPS && key > low_key && key < high_key) {
+            unsigned __int128 offset = static_cast<unsigned __int128>(key - low_key) * (high - 1 - low) / (high_key - low_key);
+            middle = low + static_cast<size_t>(offset);
+        }
+
+        if (entries_[middle].key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low == count_ || entries_[low].key != key) { return nullptr; }
+
+    size_t end = low;
+    while (end < count_ && entries_[end].key == key) { end++; }
+    count = end - low;
+    return entries_ + low;
+}
+
+/**
+ * @brief Chooses a book move for the position on the board, with a probability proportional to its weight
+ * @param random Any random number; the same number always picks the same move
+ * @return True if the position is in the book, in which case move is set. False otherwise.
+ */
+bool OpeningBook::pick(const ChessBoard& board, const uint64_t& random, Move& move) const {
+    size_t count = 0;
+    const BookEntry* entries = find(board.getHash(), count);
+    if (!entries) { return false; }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i++) { total += entries[i].weight; }
+    if (total == 0) { return best(board, move); }
+
+    uint64_t ticket = random % total;
+    for (size_t i = 0; i < count; i++) {
+        if (ticket < entries[i].weight) {
+            move = Move::fromRaw(entries[i].move);
+            return true;
+        }
+        ticket -= entries[i].weight;
+    }
+    return false;
+}
+
+/**
+ * @brief Chooses the book move with the highest weight for the position on the board
+ * @return True if the position is in the book, in which case move is set. False otherwise.
+ */
+bool OpeningBook::best(const ChessBoard& board, Move& move) const {
+    size_t count = 0;
+    const BookEntry* entries = find(board.getHash(), count);
+    if (!entries) { return false; }
+
+    const BookEntry* chosen = entries;
+    for (size_t i = 1; i < count; i++) {
+        if (entries[i].weight > chosen->weight) { chosen = entries + i; }
+    }
+    move = Move::fromRaw(chosen->move);
+    return true;
+}
@@ -0,0 +1,94 @@
+/**
+ * @class OpeningBook
+ * @brief Probes a binary opening book written by BookBuilder.
+ *
+ * A book file is a BookHeader followed by fixed-size BookEntry records sorted by (key, move), where key is the
+ * ChessBoard::getHash() of the position the move is played from. The file is memory-mapped as is, so opening a book
+ * costs no parsing regardless of its size, and a probe is an interpolation search over the (uniformly distributed)
+ * keys that touches a couple of pages and never allocates.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../ChessBoard.hpp"
+#include "../MappedFile.hpp"
+#include "../Move.hpp"
+
+/**
+ * @brief On-disk header of a book file
+ */
+struct BookHeader {
+    char magic[8];          // "P4BK" followed by zeros
+    uint32_t version;       // Currently 3
+    uint32_t entry_size;    // sizeof(BookEntry)
+    uint64_t entries;       // Number of records following the header
+    uint64_t reserved;
+};
+
+/**
+ * @brief One book move
+ */
+struct BookEntry {
+    uint64_t key;       // Hash of the position the move is played from
+    uint16_t move;      // Move::raw() of the move, promotion included
+    uint16_t weight;    // Relative preference: 2 per game won by the mover, 1 per draw (saturates at 65535)
+    uint32_t games;     // Number of games the move was played in
+};
+
+class OpeningBook {
+    public:
+        static const uint32_t VERSION = 3;  // Version 2 packed moves without their promotion
+
+        OpeningBook();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the book, if one is open
+         */
+        ~OpeningBook();
+
+        OpeningBook(const OpeningBook&) = delete;
+        OpeningBook& operator=(const OpeningBook&) = delete;
+
+        /**
+         * @brief Memory-maps a book file, closing any book that was open before
+         * @return True if the file exists and is a valid book. False otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Gets the number of records in the open book (0 if none is open)
+         */
+        size_t size() const;
+
+        /**
+         * @brief Finds every record of a position
+         * @param key The hash of the position (see ChessBoard::getHash())
+         * @param count Set to the number of records found
+         * @return A pointer to the first record, straight into the mapped file, or nullptr if the position is not in the book
+         */
+        const BookEntry* find(const uint64_t& key, size_t& count) const;
+
+        /**
+         * @brief Chooses a book move for the position on the board, with a probability proportional to its weight
+         * @param random Any random number; the same number always picks the same move
+         * @return True if the position is in the book, in which case move is set. False otherwise.
+         */
+        bool pick(const ChessBoard& board, const uint64_t& random, Move& move) const;
+
+        /**
+         * @brief Chooses the book move with the highest weight for the position on the board
+         * @return True if the position is in the book, in which case move is set. False otherwise.
+         */
+        bool best(const ChessBoard& board, Move& move) const;
+
+    private:
+        MappedFile file_;
+        const BookEntry* entries_;
+        size_t count_;
+
+        void close();
+};
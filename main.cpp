@@ -1,6 +1,21 @@
 #include "pieces_module.hpp"
 #include "ChessBoard.hpp"
+#include "tools/Commands.hpp"
+#include "uci/UciEngine.hpp"
 
-int main() {
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const Command* command = args.empty() ? nullptr : findCommand(args[0]);
+    if (command) {
+        return command->run(std::vector<std::string>(args.begin() + 1, args.end()));
+    }
+
+    // Without a mode, run as a UCI engine on stdin / stdout
+    UciEngine engine(std::cin, std::cout);
+    engine.run();
     return 0;
-}
\ No newline at end of file
+}
@@ -25,9 +25,16 @@ public:
 
     // YOUR CODE HERE
     /**
-    * @brief Determines whether the Bishop can move to the specified target position on the board.
-    * @pre The row & col members of the Bishop object match its actual position on the passed board object.
-    * 
+    * @brief Allocates a copy of this Bishop (same color, position, flags)
+    */
+    ChessPiece* clone() const;
+
+    /**
+    * @brief Computes the mask of every cell this Bishop can move to on the given board, in a single pass over its movement pattern.
+    * @pre The row & col members of the Bishop object match its actual position on the board.
+    * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
+    * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Bishop is not on the board.
+    *
     * The Bishop's movement follows these rules:
     * 1. The Bishop may move any number of squares diagonally from its current position
     * 2. The path to the target square must be unobstructed by (ie. contain) other pieces, 
@@ -35,14 +42,7 @@ public:
     * 3. The target square must either be empty (moving) or contain a piece of another color (capturing)
     * 4. The target square must stay within the board's bounds, ie. not outside [0, BOARD_LENGTH)
     * 5. The Bishop cannot move to its currently occupied position (i.e. it can't stand still).
-    * 
-    * @param target_row An integer representing the row index of the target square on the board.
-    * @param target_col An integer representing the column index of the target square on the board.
-    * @param board A 2D vector representing the current board state, 
-    *              where each cell points to a ChessPiece object or is null.
-    * 
-    * @return True if the Bishop can move to the specified position; false otherwise.
     */
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const ;
+    uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
 
 };
\ No newline at end of file
@@ -42,6 +42,13 @@ std::string ChessPiece::getColor() const {
     return color_; 
 }
 
+/**
+ * @brief Determines if the chess piece has the given color, without the copy getColor() makes
+ */
+bool ChessPiece::hasColor(const std::string& color) const {
+    return color_ == color;
+}
+
 /**
  * @brief Sets the color of the chess piece.
  * @param color A const string reference, representing the color to set the piece to. 
@@ -79,7 +86,7 @@ int ChessPiece::getRow() const {
  *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
  */
 void ChessPiece::setRow(const int& row) {
-    if (row < 0 || row >= BOARD_LENGTH) {
+    if (row < 0 || row >= Geometry::ROWS) {
         row_ = -1;
         column_ = -1;
         return ;
@@ -102,7 +109,7 @@ int ChessPiece::getColumn() const {
  *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
  */
 void ChessPiece::setColumn(const int& column) {
-    if (column < 0 || column >= BOARD_LENGTH) {
+    if (column < 0 || column >= Geometry::COLS) {
         row_ = -1;
         column_ = -1;
         return ;
@@ -153,6 +160,12 @@ std::string ChessPiece::getType() const {
     return type_;
 }
 
+char ChessPiece::getSymbol() const {
+    if (type_ == "KNIGHT") { return 'N'; }
+    if (type_ == "KING" || type_ == "QUEEN" || type_ == "ROOK" || type_ == "BISHOP" || type_ == "PAWN") { return type_[0]; }
+    return '?';
+}
+
 void ChessPiece::setSize(const int& size)  {
     piece_size_ = size;
 }
@@ -165,10 +178,52 @@ void ChessPiece::flagMoved() {
     has_moved_ = true;
 }
 
+void ChessPiece::setMoved(const bool& flag) {
+    has_moved_ = flag;
+}
+
 bool ChessPiece::hasMoved() const {
     return has_moved_;
 }
 
-// YOUR CODE HERE ===========================
+/**
+ * @brief Gets the mask bit of the cell at (row, col), ie. bit (row * BOARD_LENGTH + col)
+ * @return The single-bit mask, or 0 if (row, col) is outside the board
+ */
+uint64_t ChessPiece::cellBit(const int& row, const int& col) {
+    return Geometry::bit(row, col);
+}
+
+/**
+ * @brief Determines if this piece may end its move on a cell holding the given piece, ie. the cell is empty or the piece is an enemy
+ * @note Compares the colors in place, without the copies getColor() makes
+ */
+bool ChessPiece::canLandOn(const ChessPiece* piece) const {
+    return !piece || piece->color_ != color_;
+}
+
+/**
+ * @brief Builds the reachable mask of a sliding piece: along each of the Geometry::Direction values in [first, last),
+ *     every cell up to the first occupied one, which is included only if it holds an enemy piece
+ * @return 0 if the piece is not on the board
+ */
+uint64_t ChessPiece::slide(const int& first, const int& last, const std::vector<std::vector<ChessPiece*>>& board) const {
+    if (row_ == -1 || column_ == -1) { return 0; }
+    return Geometry::slide(Geometry::cell(row_, column_), first, last, board, [this] (const ChessPiece* piece) { return canLandOn(piece); });
+}
 
-//canMove is a pure virtual function. No implementation is neccessary. 
\ No newline at end of file
+/**
+ * @brief Builds the reachable mask of a jumping piece from a table of jump targets (eg. Geometry::KNIGHT): every target it can land on
+ * @return 0 if the piece is not on the board
+ */
+uint64_t ChessPiece::jump(const std::array<Geometry::Targets, Geometry::CELLS>& table, const std::vector<std::vector<ChessPiece*>>& board) const {
+    if (row_ == -1 || column_ == -1) { return 0; }
+    return Geometry::jump(table[Geometry::cell(row_, column_)], board, [this] (const ChessPiece* piece) { return canLandOn(piece); });
+}
+
+/**
+ * @brief Determines whether the ChessPiece can move to a specified target position on the board, ie. the target cell is set in reachableSquares()
+ */
+bool ChessPiece::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
+    return (reachableSquares(board) & cellBit(target_row, target_col)) != 0;
+}
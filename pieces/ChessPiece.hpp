@@ -8,11 +8,17 @@
 #pragma once
 #include <iostream>
 #include <cctype>
+#include <cstdint>
+#include <string>
 #include <vector>
+#include "../BoardGeometry.hpp"
 
 class ChessPiece {
    protected:
-      static const int BOARD_LENGTH = 8; // A constant value representing the number of rows & columns on the chessboard
+      using Geometry = GameBoard; // The board the pieces move on. Its dimensions are compile-time constants (see BoardGeometry).
+      static_assert(Geometry::ROWS == Geometry::COLS && Geometry::CELLS <= 64, "Pieces expect a square board that fits a 64-bit mask");
+
+      static const int BOARD_LENGTH = Geometry::ROWS; // A constant value representing the number of rows & columns on the chessboard
 
    private:
       std::string color_;  // An uppercase, alphabetic string representing the color of the chess piece.
@@ -42,6 +48,31 @@ class ChessPiece {
       void setSize(const int& size);
       void setType(const std::string& type);
 
+      /**
+       * @brief Gets the mask bit of the cell at (row, col), ie. bit (row * BOARD_LENGTH + col)
+       * @return The single-bit mask, or 0 if (row, col) is outside the board
+       */
+      static uint64_t cellBit(const int& row, const int& col);
+
+      /**
+       * @brief Determines if this piece may end its move on a cell holding the given piece, ie. the cell is empty or the piece is an enemy
+       * @note Compares the colors in place, without the copies getColor() makes
+       */
+      bool canLandOn(const ChessPiece* piece) const;
+
+      /**
+       * @brief Builds the reachable mask of a sliding piece: along each of the Geometry::Direction values in [first, last),
+       *     every cell up to the first occupied one, which is included only if it holds an enemy piece
+       * @return 0 if the piece is not on the board
+       */
+      uint64_t slide(const int& first, const int& last, const std::vector<std::vector<ChessPiece*>>& board) const;
+
+      /**
+       * @brief Builds the reachable mask of a jumping piece from a table of jump targets (eg. Geometry::KNIGHT): every target it can land on
+       * @return 0 if the piece is not on the board
+       */
+      uint64_t jump(const std::array<Geometry::Targets, Geometry::CELLS>& table, const std::vector<std::vector<ChessPiece*>>& board) const;
+
    public:
 
    // =============== Constructors ===============
@@ -69,6 +100,11 @@ class ChessPiece {
     */
    ChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& size = 0, const std::string& type="NONE");
 
+   /**
+    * @brief Virtual destructor, so that derived pieces can be deallocated through a ChessPiece pointer (eg. when captured)
+    */
+   virtual ~ChessPiece() = default;
+
    // =============== Getters and Setters ===============
 
    /**
@@ -77,6 +113,11 @@ class ChessPiece {
     */
    std::string getColor() const;
 
+   /**
+    * @brief Determines if the chess piece has the given color, without the copy getColor() makes
+    */
+   bool hasColor(const std::string& color) const;
+
    /**
     * @brief Sets the color of the chess piece.
     * @param color A const string reference, representing the color to set the piece to. 
@@ -146,6 +187,12 @@ class ChessPiece {
     */
    std::string getType() const;
 
+   /**
+    * @brief Gets the single-letter symbol of the piece's type, as used in chess notation
+    * @return One of 'K', 'Q', 'R', 'B', 'N' (KNIGHT) or 'P'. '?' if the type is not a standard chess piece
+    */
+   char getSymbol() const;
+
    /**
     * @brief Getter for the has_moved_ member
     */
@@ -155,13 +202,38 @@ class ChessPiece {
     * @brief Updates the has_moved_ member to indicate that a ChessPiece has moved from its original position
     */
    void flagMoved();
+
+   /**
+    * @brief Sets the has_moved_ member directly (eg. to restore it when a move is taken back)
+    * @param flag A const reference to a boolean representing whether the piece has moved from its original position
+    */
+   void setMoved(const bool& flag);
    
-   // YOUR CODE HERE ==================================
+   /**
+   * @brief Allocates a copy of the piece, of the same derived type (eg. so that a ChessBoard can copy a piece it shares before moving it)
+   * @note This function is pure virtual and must be implemented by derived classes.
+   */
+   virtual ChessPiece* clone() const = 0;
+
+   /**
+   * @brief Computes the mask of every cell the ChessPiece can move to on the board, in a single pass over its movement pattern.
+   *
+   * @param board A const reference to a 2D vector of ChessPiece pointers 
+   *              representing the chessboard, where each cell contains a
+   *              pointer to a ChessPiece or nullptr if the cell is empty.
+   * 
+   * @return A mask with bit (row * BOARD_LENGTH + col) set for every cell the piece can move to. 0 if the piece is not on the board.
+   * 
+   * @note This function is pure virtual and must be implemented by derived classes for specific 
+   *       piece behavior (e.g., King, Queen, Knight, etc.).
+   */
+   virtual uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const = 0;
+
    /**
    * @brief Determines whether the ChessPiece can move to a specified target position on the board.
    *
-   * The validity of the move is determined dynamically at 
-   * runtime and depends on the specific implementation in derived classes.
+   * The move is valid if the target cell is set in reachableSquares(). Callers that test many cells of one piece should
+   * compute that mask once instead.
    *
    * @param target_row An integer representing the row of the target position on the board.
    * @param target_col An integer representing the col of the target position on the board.
@@ -170,9 +242,6 @@ class ChessPiece {
    *              pointer to a ChessPiece or nullptr if the cell is empty.
    * 
    * @return True if the piece can move to the specified position; false otherwise.
-   * 
-   * @note This function is pure virtual and must be implemented by derived classes for specific 
-   *       piece behavior (e.g., King, Queen, Knight, etc.).
    */
-   virtual bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const = 0;
+   virtual bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const;
 };
\ No newline at end of file
@@ -18,49 +18,24 @@ King::King(const std::string& color, const int& row, const int& col, const bool&
 
 // YOUR CODE HERE 
 /**
- * @brief Determines whether the King can move to the specified target position on the board.
- * @pre The row & col members of the Rook object match its actual position on the passed board object.
- * 
+ * @brief Allocates a copy of this King (same color, position, flags)
+ */
+ChessPiece* King::clone() const {
+    return new King(*this);
+}
+
+/**
+ * @brief Computes the mask of every cell this King can move to on the given board, in a single pass over its movement pattern.
+ * @pre The row & col members of the King object match its actual position on the board.
+ * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
+ * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the King is not on the board.
+ *
  * The King's movement follows these rules:
  * 1. The King can move only one square in any direction.
  * 2. The target square must either be empty (moving) or contain a piece of another color (capturing)
  * 3. The target square must stay within the board's bounds, ie. not outside [0, BOARD_LENGTH)
  * 4. The King cannot move to its currently occupied position (ie. it can't stand still).
- * 
- * @param target_row An integer reprsenting the row index of the target square on the board.
- * @param target_col An integer reprsenting the column index of the target square on the board.
- * @param board A 2D vector representing the current board state, 
- *              where each cell points to a ChessPiece object or is null.
- * 
- * @return True if the King can move to the specified position; false otherwise.
  */
-bool King::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Find the current position of the King
-    int current_row = getRow();
-    int current_col = getColumn();
-
-    // Check if target is within bounds
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) {
-        return false;
-    }
-
-    // Cannot move to the same position
-    if (target_row == current_row && target_col == current_col) {
-        return false;
-    }
-
-    // King can move only one square in any direction
-    int row_diff = std::abs(target_row - current_row);
-    int col_diff = std::abs(target_col - current_col);
-    if (row_diff > 1 || col_diff > 1) {
-        return false;
-    }
-
-    // Check if the target square is empty or occupied by an enemy piece
-    ChessPiece* destination = board[target_row][target_col];
-    if (destination == nullptr) {
-        return true; // Empty square
-    } else {
-        return destination->getColor() != getColor(); // Capture only if enemy (ie. different colors)
-    }
- }
\ No newline at end of file
+uint64_t King::reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const {
+    return jump(Geometry::KING, board);
+}
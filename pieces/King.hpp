@@ -27,21 +27,21 @@ public:
 
     // YOUR CODE HERE 
     /**
-    * @brief Determines whether the King can move to the specified target position on the board.
-    * @pre The row & col members of the Rook object match its actual position on the passed board object.
-    * 
+    * @brief Allocates a copy of this King (same color, position, flags)
+    */
+    ChessPiece* clone() const;
+
+    /**
+    * @brief Computes the mask of every cell this King can move to on the given board, in a single pass over its movement pattern.
+    * @pre The row & col members of the King object match its actual position on the board.
+    * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
+    * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the King is not on the board.
+    *
     * The King's movement follows these rules:
     * 1. The King can move only one square in any direction.
     * 2. The target square must either be empty (moving) or contain a piece of another color (capturing)
     * 3. The target square must stay within the board's bounds, ie. not outside [0, BOARD_LENGTH)
     * 4. The King cannot move to its currently occupied position (ie. it can't stand still).
-    * 
-    * @param target_row An integer reprsenting the row index of the target square on the board.
-    * @param target_col An integer reprsenting the column index of the target square on the board.
-    * @param board A 2D vector representing the current board state, 
-    *              where each cell points to a ChessPiece object or is null.
-    * 
-    * @return True if the King can move to the specified position; false otherwise.
     */
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const;
+    uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
 };
\ No newline at end of file
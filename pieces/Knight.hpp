@@ -26,21 +26,22 @@ public:
     Knight(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
 
     /**
-     * @brief Determines if this Knight piece can move to the cell specified by (target_row, target_col) on the given board.
-     * @pre The row & col members of the calling Knight object are set to its actual stored location on the board.
-     * @param target_row The row index to move to.
-     * @param target_col The column index to move to.
+     * @brief Allocates a copy of this Knight (same color, position, flags)
+     */
+    ChessPiece* clone() const;
+
+    /**
+     * @brief Computes the mask of every cell this Knight can move to on the given board, in a single pass over its movement pattern.
+     * @pre The row & col members of the Knight object match its actual position on the board.
      * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
-     * @return Returns true if the Knight can legally move to the specified space on the board; false otherwise.
-     * 
+     * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Knight is not on the board.
+     *
      * The Knight's movement follows these rules:
      * 1. The move must follow an "L" shape: two squares in one direction (vertical or horizontal) and one square perpendicular,
      *    or one square in one direction and two squares perpendicular.
      * 2. The Knight can jump over other pieces, so intervening pieces between its starting and target positions are ignored.
      * 3. The move is valid if the target square is empty or contains a piece of a different color (capturing).
      * 4. The move is invalid if the target square is outside the bounds of the board.
-     * 
-     * @note Capturing an opponent's piece by landing on its position is considered a valid move.
      */
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const;
+    uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
 };
\ No newline at end of file
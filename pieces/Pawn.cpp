@@ -43,41 +43,44 @@ bool Pawn::canPromote() const {
 }
 
 /**
- * @brief Determines if this Pawn piece can move to the cell specified by (target_row, target_col) on the given board.
+ * @brief Allocates a copy of this Pawn (same color, position, flags)
+ */
+ChessPiece* Pawn::clone() const {
+    return new Pawn(*this);
+}
+
+/**
+ * @brief Computes the mask of every cell this Pawn can move to on the given board, in a single pass over its movement pattern.
  * @pre The row & col members of the Pawn object match its actual position on the board.
- * @param target_row The row index to move to.
- * @param target_col The column index to move to.
  * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
- * @return Returns true if the Pawn can legally move to the specified space; false otherwise.
- * 
+ * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Pawn is not on the board.
+ *
  * The Pawn's movement follows these rules:
- * 1. The Pawn moves forward one square, or captures one square diagonally forward.
+ * 1. The Pawn moves forward one square, but captures one square diagonally forward.
  * 2. The Pawn may move two squares forward on its first move, provided both squares are unoccupied.
  * 3. The move is invalid if the target square is outside the bounds of the board.
  */
-bool Pawn::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Not on the board 
-    if (getRow() == -1 || getColumn() == -1) { return false; } 
-
-    // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; };
+uint64_t Pawn::reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const {
+    const int row = getRow();
+    const int col = getColumn();
+    const int direction = isMovingUp() ? 1 : -1;
+    const int forward = row + direction;
+    if (row == -1 || col == -1 || !Geometry::contains(forward, col)) { return 0; }
 
-    // Non-empty & same-color piece
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
+    uint64_t squares = 0;
 
+    // Moving straight needs empty cells, and the double jump an empty cell in between
+    if (!board[forward][col]) {
+        squares |= cellBit(forward, col);
+        const int jump = forward + direction;
+        if (canDoubleJump() && Geometry::contains(jump, col) && !board[jump][col]) { squares |= cellBit(jump, col); }
+    }
 
-    int direction = isMovingUp() ? 1 : -1;
-    bool moves_straight = 
-        (!target_piece && getColumn() == target_col) && // Is moving straight (and there is no obstructing piece)
-            ((getRow() + direction == target_row) ||    // Moving one space forward
-            (getRow() + direction * 2 == target_row && !board[target_row - direction][target_col])); // Moves 2 rows (depending on the canDoubleJump flag && if there are no obstructions)
-
-
-    bool captures_diagonal =
-        (target_piece && std::abs(getColumn() - target_col) == 1) && // Moving along some diagonal
-        (getRow() + direction == target_row); // Moving along a diagonal they are facing
-
-
-    return moves_straight || captures_diagonal;
-}
\ No newline at end of file
+    // Capturing diagonally forward needs an enemy piece
+    const Geometry::Targets& captures = Geometry::PAWN_CAPTURES[isMovingUp() ? 0 : 1][Geometry::cell(row, col)];
+    for (int i = 0; i < captures.count; i++) {
+        const ChessPiece* target = board[Geometry::rowOf(captures.cells[i])][Geometry::colOf(captures.cells[i])];
+        if (target && canLandOn(target)) { squares |= Geometry::bit(captures.cells[i]); }
+    }
+    return squares;
+}
@@ -43,18 +43,20 @@ class Pawn : public ChessPiece {
         bool canPromote() const;
 
         /**
-         * @brief Determines if this Pawn piece can move to the cell specified by (target_row, target_col) on the given board.
+         * @brief Allocates a copy of this Pawn (same color, position, flags)
+         */
+        ChessPiece* clone() const;
+
+        /**
+         * @brief Computes the mask of every cell this Pawn can move to on the given board, in a single pass over its movement pattern.
          * @pre The row & col members of the Pawn object match its actual position on the board.
-         * @param target_row The row index to move to.
-         * @param target_col The column index to move to.
          * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
-         * @return Returns true if the Pawn can legally move to the specified space; false otherwise.
-         * 
+         * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Pawn is not on the board.
+         *
          * The Pawn's movement follows these rules:
          * 1. The Pawn moves forward one square, but captures one square diagonally forward.
          * 2. The Pawn may move two squares forward on its first move, provided both squares are unoccupied.
          * 3. The move is invalid if the target square is outside the bounds of the board.
-         * 
          */
-        bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const;
+        uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
 };
\ No newline at end of file
@@ -54,62 +54,24 @@ bool Rook::canCastle(const ChessPiece& target) const {
 }
 
 /**
- * @brief Determines if this Rook piece can move to the cell specified by (target_row, target_col) on the given board.
+ * @brief Allocates a copy of this Rook (same color, position, flags)
+ */
+ChessPiece* Rook::clone() const {
+    return new Rook(*this);
+}
+
+/**
+ * @brief Computes the mask of every cell this Rook can move to on the given board, in a single pass over its movement pattern.
  * @pre The row & col members of the Rook object match its actual position on the board.
- * @param target_row The row index to move to.
- * @param target_col The column index to move to.
  * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
- * @return Returns true if the Rook can legally move to the specified space; false otherwise.
- * 
+ * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Rook is not on the board.
+ *
  * The Rook's movement follows these rules:
- * 1. The Rook may move any number of squares in a straight line, either vertically or horizontally or castle with pieces that are laterally adjacent.
+ * 1. The Rook may move any number of squares in a straight line, either vertically or horizontally.
  * 2. The path to the target square must be unobstructed by other pieces, except for the target square itself.
- * 3. The move is valid if the target square is empty or contains a piece of a different color (capturing) or if it is castling with a laterally adjacent piece.
- * 4. The move is invalid if the target square is outside the bounds of the board.
+ * 3. The target square must either be empty (moving) or contain a piece of a different color (capturing).
+ * 4. The target square must stay within the board's bounds.
  */
-bool Rook::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Not on the board 
-    if (getRow() == -1 || getColumn() == -1) { return false; } 
-    // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; };
-    
-
-    // Account for castle in ChessBoard move()
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece) {
-        if (target_piece->getColor() == getColor()) { return false; }
-        if (canCastle(*target_piece)) { return true; } // It can only castle if it is adjacent anyway
-    }
-    
-    // Get the difference between the current position and the target position
-    // -,0,+  -->  represents left, no movement, right
-    int row_difference = target_row - getRow(); 
-    // -,0,+  -->  represents down, no movement, up
-    int col_difference = target_col - getColumn(); 
-
-    // Same cell OR not a horizontal / vertical line
-    bool stays_in_same_position = (row_difference == 0) && (col_difference == 0);
-    bool moves_straight = (row_difference == 0) || (col_difference == 0);
-    if (stays_in_same_position || !moves_straight) { return false; }
-
-    // Find what direction we should step 
-    int increment_row = 0;
-    int increment_col = 0;
-    if (row_difference > 0) { increment_row = 1; }  // Moving right
-    if (row_difference < 0) { increment_row = -1; } // Moving left
-
-    if (col_difference > 0) { increment_col = 1; }  // Moving up
-    if (col_difference < 0) { increment_col = -1; } // Moving down
-    
-    // Iterate from the original space to target space and check if there is any obstructing Chess Piece
-    int temp_row = getRow();
-    int temp_col = getColumn();
-
-    while (temp_row != target_row || temp_col != target_col) {
-        temp_row += increment_row;
-        temp_col += increment_col;
-        if (board[temp_row][temp_col]) { return false; }
-    }
-
-    return true;
+uint64_t Rook::reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const {
+    return slide(Geometry::NORTH, Geometry::NORTH_EAST, board);
 }
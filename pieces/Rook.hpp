@@ -51,18 +51,21 @@ class Rook : public ChessPiece {
         int getCastleMovesLeft() const;
 
         /**
-         * @brief Determines if this Rook piece can move to the cell specified by (target_row, target_col) on the given board.
+         * @brief Allocates a copy of this Rook (same color, position, flags)
+         */
+        ChessPiece* clone() const;
+
+        /**
+         * @brief Computes the mask of every cell this Rook can move to on the given board, in a single pass over its movement pattern.
          * @pre The row & col members of the Rook object match its actual position on the board.
-         * @param target_row The row index to move to.
-         * @param target_col The column index to move to.
          * @param board A 2D vector representing the current board state, where each cell points to a ChessPiece object or is null.
-         * @return Returns true if the Rook can legally move to the specified space; false otherwise.
-         * 
+         * @return A mask with bit (row * BOARD_LENGTH + col) set for every reachable cell. 0 if the Rook is not on the board.
+         *
          * The Rook's movement follows these rules:
-         * 1. The Rook may move any number of squares in a straight line, either vertically or horizontally or castle with pieces that are laterally adjacent.
+         * 1. The Rook may move any number of squares in a straight line, either vertically or horizontally.
          * 2. The path to the target square must be unobstructed by other pieces, except for the target square itself.
-         * 3. The move is valid if the target square is empty or contains a piece of a different color (capturing) or if it is castling with a laterally adjacent piece.
-         * 4. The move is invalid if the target square is outside the bounds of the board.
+         * 3. The target square must either be empty (moving) or contain a piece of a different color (capturing).
+         * 4. The target square must stay within the board's bounds.
          */
-        bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const;
+        uint64_t reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "Evaluator.hpp"
+
+#include <algorithm>
+
+namespace {
+    using Geometry = GameBoard;
+
+    // 0 on the rim, 3 on the four center cells
+    int centrality(const int& row, const int& col) {
+        return std::min(std::min(row, Geometry::ROWS - 1 - row), std::min(col, Geometry::COLS - 1 - col));
+    }
+}
+
+/**
+ * @brief Scores the position on the board
+ * @return The score in centipawns, from the point of view of the player whose turn it is (positive is good for them)
+ */
+int Evaluator::evaluate(const ChessBoard& board) {
+    const std::string p1_color = board.getPlayerColor(true);
+    int score = 0; // From player one's point of view
+
+    for (int row = 0; row < Geometry::ROWS; row++) {
+        for (int col = 0; col < Geometry::COLS; col++) {
+            const ChessPiece* piece = board.getCell(row, col);
+            if (!piece) { continue; }
+
+            const bool player_one = piece->getColor() == p1_color;
+            const char symbol = piece->getSymbol();
+            int value = symbol == 'K' ? 0 : piece->size() * PAWN_VALUE;
+
+            if (symbol == 'P') {
+                // Rows advanced from the starting row
+                value += 5 * (player_one ? row - 1 : Geometry::ROWS - 2 - row);
+            }
+            if (symbol == 'N' || symbol == 'B') {
+                value += 5 * centrality(row, col);
+            }
+
+            score += player_one ? value : -value;
+        }
+    }
+
+    return board.isPlayerOneTurn() ? score : -score;
+}
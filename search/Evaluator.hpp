@@ -0,0 +1,22 @@
+/**
+ * @class Evaluator
+ * @brief Static evaluation of a ChessBoard position, used at the leaves of the search.
+ *
+ * Material is counted with ChessPiece::size() (PAWN_VALUE centipawns per unit), plus small bonuses for advanced pawns
+ * and centralized minor pieces. Kings are not counted as material.
+ */
+
+#pragma once
+
+#include "../ChessBoard.hpp"
+
+class Evaluator {
+    public:
+        static const int PAWN_VALUE = 100; // Centipawns per unit of ChessPiece::size()
+
+        /**
+         * @brief Scores the position on the board
+         * @return The score in centipawns, from the point of view of the player whose turn it is (positive is good for them)
+         */
+        static int evaluate(const ChessBoard& board);
+};
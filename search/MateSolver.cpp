@@ -0,0 +1,269 @@
+#include "MateSolver.hpp"
+
+#include <algorithm>
+
+namespace {
+    const uint32_t INFINITE = 100000000;    // Proof number of a disproven node, disproof number of a proven one
+    const size_t BUCKET = 4;                // Entries a position may be stored in
+
+    uint32_t saturate(const uint64_t& value) {
+        return static_cast<uint32_t>(std::min<uint64_t>(value, INFINITE));
+    }
+}
+
+/**
+ * @brief Constructs a solver whose table takes (at most) the given memory
+ */
+MateSolver::MateSolver(const size_t& hash_megabytes, const bool& checks_only) : checks_only_{checks_only}, board_{nullptr}, nodes_{0}, max_nodes_{0}, stopped_{false} {
+    const size_t wanted = hash_megabytes * 1024 * 1024 / sizeof(Entry);
+    size_t size = BUCKET;
+    while (size * 2 <= wanted) { size *= 2; }
+    entries_.resize(size);
+    clear();
+}
+
+/**
+ * @brief Determines if the player to move can force mate in at most the given number of moves
+ * @param board Changed while searching & restored before returning
+ * @param max_nodes Nodes to search before giving up, or 0 for no limit
+ * @param line Set to the mating line (both players' moves, the mating move last) when PROVEN. The defender
+ *     resists as long as it can, and the attacker mates as fast as it can within the tree searched.
+ * @return UNKNOWN if the node limit was reached first
+ */
+MateSolver::Result MateSolver::solve(ChessBoard& board, const int& moves, const long long& max_nodes, std::vector<Move>& line) {
+    board_ = &board;
+    nodes_ = 0;
+    max_nodes_ = max_nodes;
+    stopped_ = false;
+    line.clear();
+
+    const int depth = std::max(0, std::min(moves, MAX_MOVES));
+    search(true, depth, INFINITE, INFINITE);
+    const Numbers root = lookup(board.getHash(), depth);
+    if (root.pn == 0) {
+        extractLine(true, depth, line);
+        return PROVEN;
+    }
+    return root.dn == 0 ? DISPROVEN : UNKNOWN;
+}
+
+/**
+ * @brief Finds the shortest forced mate of the player to move, by asking for a mate in 1, 2, ... up to max_moves
+ * @param line Set to the mating line when PROVEN; its length gives the mate's length
+ * @return DISPROVEN if there is no mate within max_moves, UNKNOWN if the node limit was reached first
+ */
+MateSolver::Result MateSolver::findMate(ChessBoard& board, const int& max_moves, const long long& max_nodes, std::vector<Move>& line) {
+    // Shorter queries are cheap next to the longer ones, and leave their disproofs in the table for them
+    long long total = 0;
+    Result result = DISPROVEN;
+    for (int moves = 1; moves <= std::min(max_moves, MAX_MOVES); moves++) {
+        result = solve(board, moves, max_nodes > 0 ? std::max(1LL, max_nodes - total) : 0, line);
+        total += nodes_;
+        if (result != DISPROVEN) { break; }
+    }
+    nodes_ = total;
+    return result;
+}
+
+/**
+ * @brief Gets the number of nodes searched by the last query
+ */
+long long MateSolver::getNodes() const {
+    return nodes_;
+}
+
+/**
+ * @brief Empties the table
+ */
+void MateSolver::clear() {
+    std::fill(entries_.begin(), entries_.end(), Entry{0, 0, 0, 0, 0, 0, false, 0});
+}
+
+/**
+ * @brief Expands a node until its numbers reach the thresholds, the node is solved or the search stops
+ * @param attacking True at attacker nodes (OR nodes), false at defender nodes (AND nodes)
+ * @param depth Attacker moves left
+ */
+void MateSolver::search(const bool& attacking, const int& depth, const uint32_t& pn_limit, const uint32_t& dn_limit) {
+    const long long start = nodes_++;
+    if (max_nodes_ > 0 && nodes_ >= max_nodes_) { stopped_ = true; }
+    const uint64_t hash = board_->getHash();
+
+    MoveList moves;
+    generate(attacking, depth, moves);
+    if (!attacking) {
+        if (moves.empty()) {
+            // Checkmate or stalemate
+            const bool mated = board_->isInCheck(board_->isPlayerOneTurn());
+            store(hash, depth, mated ? Numbers{0, INFINITE, 0} : Numbers{INFINITE, 0, 0}, 1);
+            return;
+        }
+    }
+    // No check to give, or no attacker move left after the defender's
+    if (moves.empty() || (!attacking && depth == 0)) {
+        store(hash, depth, Numbers{INFINITE, 0, 0}, 1);
+        return;
+    }
+
+    // Children are identified by their hashes, worked out once
+    const int child_depth = attacking ? depth - 1 : depth;
+    uint64_t children[MoveList::CAPACITY];
+    for (size_t i = 0; i < moves.size(); i++) {
+        MoveUndo undo;
+        board_->makeMove(moves[i], undo);
+        children[i] = board_->getHash();
+        board_->unmakeMove(moves[i], undo);
+    }
+
+    Numbers node{1, 1, 0};
+    while (true) {
+        // OR node: the easiest child to prove proves it, all children disprove it. AND node: the other way round.
+        uint64_t sum = 0;
+        uint32_t best = INFINITE + 1;
+        uint32_t second = INFINITE;
+        size_t best_index = 0;
+        int plies = attacking ? MAX_MOVES * 2 + 1 : 0;
+        for (size_t i = 0; i < moves.size(); i++) {
+            const Numbers child = lookup(children[i], child_depth);
+            const uint32_t mine = attacking ? child.pn : child.dn;      // Decides which child is most proving
+            sum += attacking ? child.dn : child.pn;
+            if (mine < best) {
+                second = best;
+                best = mine;
+                best_index = i;
+            } else if (mine < second) {
+                second = mine;
+            }
+            if (child.pn == 0) { plies = attacking ? std::min(plies, child.plies + 1) : std::max(plies, child.plies + 1); }
+        }
+        const uint32_t total = saturate(sum);
+        node = attacking ? Numbers{best, total, 0} : Numbers{total, best, 0};
+        if (node.pn == 0) { node.plies = plies; }
+
+        if (node.pn >= pn_limit || node.dn >= dn_limit || stopped_) { break; }
+
+        // Thresholds of the chosen child: solve it, or stop once it is no longer the most proving one
+        const Numbers child = lookup(children[best_index], child_depth);
+        uint32_t child_pn_limit, child_dn_limit;
+        if (attacking) {
+            child_pn_limit = std::min(pn_limit, saturate(uint64_t{second} + 1));
+            child_dn_limit = saturate(uint64_t{dn_limit} - node.dn + child.dn);
+        } else {
+            child_dn_limit = std::min(dn_limit, saturate(uint64_t{second} + 1));
+            child_pn_limit = saturate(uint64_t{pn_limit} - node.pn + child.pn);
+        }
+
+        MoveUndo undo;
+        board_->makeMove(moves[best_index], undo);
+        search(!attacking, child_depth, child_pn_limit, child_dn_limit);
+        board_->unmakeMove(moves[best_index], undo);
+    }
+
+    store(hash, depth, node, static_cast<uint32_t>(std::min<long long>(nodes_ - start, INFINITE)));
+}
+
+/**
+ * @brief Generates the moves of a node
+ */
+void MateSolver::generate(const bool& attacking, const int& depth, MoveList& moves) {
+    if (!attacking) {
+        board_->generateLegalMoves(moves);
+    } else if (depth == 1 || (checks_only_ && depth > 0)) {
+        board_->generateChecks(moves);
+    } else if (depth > 0) {
+        board_->generateLegalMoves(moves);
+    }
+}
+
+/**
+ * @brief Reads the mating line of a proven node from the table
+ */
+void MateSolver::extractLine(const bool& attacking, const int& depth, std::vector<Move>& line) {
+    MoveList moves;
+    generate(attacking, depth, moves);
+    if (moves.empty()) { return; }    // Checkmate
+
+    // The attacker picks its shortest proven mate, the defender its longest resistance. Every defence was proven, and
+    // at least one attack; entries replaced since then are proven again (for the attacker, only if none is left).
+    const int child_depth = attacking ? depth - 1 : depth;
+    Move chosen{};
+    int chosen_plies = 0;
+    for (int pass = 0; pass < 2 && chosen.isNone(); pass++) {
+        const bool prove = !attacking || pass == 1;
+        for (const Move& move : moves) {
+            MoveUndo undo;
+            board_->makeMove(move, undo);
+            Numbers child = lookup(board_->getHash(), child_depth);
+            if (prove && child.pn != 0 && child.dn != 0) {
+                search(!attacking, child_depth, INFINITE, INFINITE);
+                child = lookup(board_->getHash(), child_depth);
+            }
+            board_->unmakeMove(move, undo);
+
+            if (child.pn != 0) { continue; }
+            if (chosen.isNone() || (attacking ? child.plies < chosen_plies : child.plies > chosen_plies)) {
+                chosen = move;
+                chosen_plies = child.plies;
+            }
+            if (attacking && pass == 1) { break; }
+        }
+    }
+    if (chosen.isNone()) { return; }
+
+    line.push_back(chosen);
+    MoveUndo undo;
+    board_->makeMove(chosen, undo);
+    extractLine(!attacking, child_depth, line);
+    board_->unmakeMove(chosen, undo);
+}
+
+/**
+ * @brief Looks up a node. Unknown nodes start with both numbers at 1.
+ */
+MateSolver::Numbers MateSolver::lookup(const uint64_t& hash, const int& depth) const {
+    const size_t first = bucket(hash, depth);
+    for (size_t i = first; i < first + BUCKET; i++) {
+        const Entry& entry = entries_[i];
+        if (entry.used && entry.key == hash && entry.depth == depth) { return Numbers{entry.pn, entry.dn, entry.plies}; }
+    }
+    return Numbers{1, 1, 0};
+}
+
+/**
+ * @brief Records the numbers of a node, in place of the bucket's entry that took the least work if it has none
+ */
+void MateSolver::store(const uint64_t& hash, const int& depth, const Numbers& numbers, const uint32_t& work) {
+    const size_t first = bucket(hash, depth);
+    Entry* target = &entries_[first];
+    bool same = false;
+    for (size_t i = first; i < first + BUCKET; i++) {
+        Entry& entry = entries_[i];
+        if (entry.used && entry.key == hash && entry.depth == depth) {
+            target = &entry;
+            same = true;
+            break;
+        }
+        // Otherwise the least work to redo: an empty entry, or the cheapest subtree (solved ones last)
+        const bool solved = entry.pn == 0 || entry.dn == 0;
+        const bool target_solved = target->pn == 0 || target->dn == 0;
+        if (!entry.used || (target->used && (solved < target_solved || (solved == target_solved && entry.work < target->work)))) {
+            target = &entry;
+        }
+    }
+
+    target->key = hash;
+    target->pn = numbers.pn;
+    target->dn = numbers.dn;
+    target->work = same ? std::max(work, target->work) : work;
+    target->depth = static_cast<uint8_t>(depth);
+    target->plies = static_cast<uint8_t>(std::min(numbers.plies, 255));
+    target->used = true;
+}
+
+/**
+ * @brief Gets the first entry of the bucket a hash lives in
+ */
+size_t MateSolver::bucket(const uint64_t& hash, const int& depth) const {
+    const uint64_t mixed = hash ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+    return static_cast<size_t>(mixed & (entries_.size() - 1)) & ~(BUCKET - 1);
+}
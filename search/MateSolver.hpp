@@ -0,0 +1,123 @@
+/**
+ * @class MateSolver
+ * @brief Proves or disproves forced mates with a depth-first proof-number search (df-pn).
+ *
+ * The tree only holds what matters to a mate. The defender plays every legal move (its evasions when in check, see
+ * ChessBoard::generateLegalMoves()). The attacker (the player to move at the root) only plays checking moves (see
+ * ChessBoard::generateChecks()) on its last move, since only a check can mate; with checks_only, it plays nothing but
+ * checks throughout, which proves mates by successive checks far faster but misses mates with a quiet move. Every node carries a proof number (how many more
+ * leaves at least must be proven to prove it) and a disproof number; df-pn always descends into the most-proving
+ * child, going back up only once the child's numbers pass thresholds derived from its siblings. The search is
+ * therefore drawn towards narrow lines of forcing checks & few evasions, and proves mates that an alpha-beta search
+ * of the same length only finds at full width.
+ *
+ * A query asks for a mate within a number of attacker moves, which also keeps the tree acyclic (a node's entry holds
+ * the moves left at it). Proof & disproof numbers live in a table of bounded size; when a bucket is full, the entry
+ * whose subtree took the least work to search is replaced. Proven entries also remember the length of their mate, so
+ * that the mating line can be read back from the table, re-proving any part of it that was replaced.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../ChessBoard.hpp"
+
+class MateSolver {
+    public:
+        static constexpr int MAX_MOVES = 64;    // Longest mate that can be asked for, in attacker moves
+
+        enum Result { PROVEN, DISPROVEN, UNKNOWN };
+
+        /**
+         * @brief Constructs a solver whose table takes (at most) the given memory
+         */
+        MateSolver(const size_t& hash_megabytes, const bool& checks_only = false);
+
+        /**
+         * @brief Determines if the player to move can force mate in at most the given number of moves
+         * @param board Changed while searching & restored before returning
+         * @param max_nodes Nodes to search before giving up, or 0 for no limit
+         * @param line Set to the mating line (both players' moves, the mating move last) when PROVEN. The defender
+         *     resists as long as it can, and the attacker mates as fast as it can within the tree searched.
+         * @return UNKNOWN if the node limit was reached first
+         */
+        Result solve(ChessBoard& board, const int& moves, const long long& max_nodes, std::vector<Move>& line);
+
+        /**
+         * @brief Finds the shortest forced mate of the player to move, by asking for a mate in 1, 2, ... up to max_moves
+         * @param line Set to the mating line when PROVEN; its length gives the mate's length
+         * @return DISPROVEN if there is no mate within max_moves, UNKNOWN if the node limit was reached first
+         */
+        Result findMate(ChessBoard& board, const int& max_moves, const long long& max_nodes, std::vector<Move>& line);
+
+        /**
+         * @brief Gets the number of nodes searched by the last query
+         */
+        long long getNodes() const;
+
+        /**
+         * @brief Empties the table
+         */
+        void clear();
+
+    private:
+        struct Entry {
+            uint64_t key;       // Position hash
+            uint32_t pn;        // Proof number
+            uint32_t dn;        // Disproof number
+            uint32_t work;      // Nodes searched below the entry, which decides what gets replaced
+            uint8_t depth;      // Attacker moves left at the node
+            uint8_t plies;      // Length of the mate from the node, once proven
+            bool used;
+            uint8_t reserved;
+        };
+
+        /**
+         * @brief Proof & disproof numbers of a node, as looked up
+         */
+        struct Numbers {
+            uint32_t pn;
+            uint32_t dn;
+            int plies;
+        };
+
+        std::vector<Entry> entries_;
+        bool checks_only_;
+        ChessBoard* board_;
+        long long nodes_;
+        long long max_nodes_;
+        bool stopped_;
+
+        /**
+         * @brief Expands a node until its numbers reach the thresholds, the node is solved or the search stops
+         * @param attacking True at attacker nodes (OR nodes), false at defender nodes (AND nodes)
+         * @param depth Attacker moves left
+         */
+        void search(const bool& attacking, const int& depth, const uint32_t& pn_limit, const uint32_t& dn_limit);
+
+        /**
+         * @brief Generates the moves of a node
+         */
+        void generate(const bool& attacking, const int& depth, MoveList& moves);
+
+        /**
+         * @brief Reads the mating line of a proven node from the table
+         */
+        void extractLine(const bool& attacking, const int& depth, std::vector<Move>& line);
+
+        /**
+         * @brief Looks up a node. Unknown nodes start with both numbers at 1.
+         */
+        Numbers lookup(const uint64_t& hash, const int& depth) const;
+
+        /**
+         * @brief Records the numbers of a node, in place of the bucket's entry that took the least work if it has none
+         */
+        void store(const uint64_t& hash, const int& depth, const Numbers& numbers, const uint32_t& work);
+
+        /**
+         * @brief Gets the first entry of the bucket a hash lives in
+         */
+        size_t bucket(const uint64_t& hash, const int& depth) const;
+};
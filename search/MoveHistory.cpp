@@ -0,0 +1,70 @@
+#include "MoveHistory.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    const Move NO_MOVE{};
+}
+
+MoveHistory::MoveHistory() {
+    clear();
+}
+
+/**
+ * @brief Forgets everything, eg. before a new game
+ */
+void MoveHistory::clear() {
+    for (auto& slots : killers_) { slots[0] = slots[1] = NO_MOVE; }
+    for (auto& cells : counters_) { std::fill(std::begin(cells), std::end(cells), NO_MOVE); }
+    for (auto& side : history_) {
+        for (auto& cells : side) { std::fill(std::begin(cells), std::end(cells), 0); }
+    }
+}
+
+/**
+ * @brief Records a beta cutoff caused by a quiet move
+ * @param side 0 if player one made the move, 1 otherwise
+ * @param tried The quiet moves searched before it at the same node, which did not cut off
+ * @param previous The move that led to the node, "no move" at the root
+ */
+void MoveHistory::update(const int& side, const int& depth, const int& ply, const Move& move, const MoveList& tried,
+    const Move& previous) {
+    if (ply < MAX_PLY && killers_[ply][0] != move) {
+        killers_[ply][1] = killers_[ply][0];
+        killers_[ply][0] = move;
+    }
+    if (!previous.isNone()) { counters_[previous.from()][previous.to()] = move; }
+
+    const int bonus = std::min(depth * depth, MAX_SCORE / 16);
+    adjust(history_[side][move.from()][move.to()], bonus);
+    for (const Move& quiet : tried) { adjust(history_[side][quiet.from()][quiet.to()], -bonus); }
+}
+
+/**
+ * @brief Gets the killer moves of a ply ("no move" for an empty slot)
+ */
+const Move* MoveHistory::killers(const int& ply) const {
+    return killers_[std::min(ply, MAX_PLY - 1)];
+}
+
+/**
+ * @brief Gets the history score of a quiet move
+ */
+int MoveHistory::score(const int& side, const Move& move) const {
+    return history_[side][move.from()][move.to()];
+}
+
+/**
+ * @brief Gets the quiet move that last refuted previous, or "no move" (see Move)
+ */
+Move MoveHistory::counter(const Move& previous) const {
+    return !previous.isNone() ? counters_[previous.from()][previous.to()] : NO_MOVE;
+}
+
+/**
+ * @brief Moves a history score by bonus, shrinking the step as the score nears MAX_SCORE
+ */
+void MoveHistory::adjust(int16_t& entry, const int& bonus) {
+    entry = static_cast<int16_t>(entry + bonus - entry * std::abs(bonus) / MAX_SCORE);
+}
@@ -0,0 +1,63 @@
+/**
+ * @class MoveHistory
+ * @brief What a search has learned about quiet moves (neither captures nor promotions), used to order them (see MovePicker).
+ *
+ * - Killers: per ply, the last two quiet moves that caused a beta cutoff. A move refuting one line often refutes its siblings.
+ * - History: per side, a "butterfly" table of (from cell, to cell) scores. A quiet move causing a cutoff gains depth^2,
+ *   and the quiet moves tried before it lose as much. Scores decay towards the bound as they grow, so they track recent results.
+ * - Counter-moves: per (from cell, to cell) of the previous move, the quiet move that last refuted it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "../BoardGeometry.hpp"
+#include "../MoveList.hpp"
+
+class MoveHistory {
+    public:
+        static const int MAX_PLY = 128;
+        static const int CELLS = GameBoard::CELLS;
+        static const int MAX_SCORE = 16384;     // History scores stay within [-MAX_SCORE, MAX_SCORE]
+
+        MoveHistory();
+
+        /**
+         * @brief Forgets everything, eg. before a new game
+         */
+        void clear();
+
+        /**
+         * @brief Records a beta cutoff caused by a quiet move
+         * @param side 0 if player one made the move, 1 otherwise
+         * @param tried The quiet moves searched before it at the same node, which did not cut off
+         * @param previous The move that led to the node, "no move" at the root
+         */
+        void update(const int& side, const int& depth, const int& ply, const Move& move, const MoveList& tried,
+            const Move& previous);
+
+        /**
+         * @brief Gets the killer moves of a ply ("no move" for an empty slot)
+         */
+        const Move* killers(const int& ply) const;
+
+        /**
+         * @brief Gets the history score of a quiet move
+         */
+        int score(const int& side, const Move& move) const;
+
+        /**
+         * @brief Gets the quiet move that last refuted previous, or "no move" (see Move)
+         */
+        Move counter(const Move& previous) const;
+
+    private:
+        Move killers_[MAX_PLY][2];
+        int16_t history_[2][CELLS][CELLS];
+        Move counters_[CELLS][CELLS];
+
+        /**
+         * @brief Moves a history score by bonus, shrinking the step as the score nears MAX_SCORE
+         */
+        static void adjust(int16_t& entry, const int& bonus);
+};
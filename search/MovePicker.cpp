@@ -0,0 +1,147 @@
+#include "MovePicker.hpp"
+#include "StaticExchange.hpp"
+
+#include <utility>
+
+namespace {
+    const int QUEEN_PROMOTION = 1000;       // Ahead of every capture (at most 10 * 4 - 1)
+    const int UNDERPROMOTION = -1000;       // Behind every capture
+}
+
+/**
+ * @brief Constructs a picker for the position on the board, which must not change until the picker is done
+ * @param hash_move The move to try first, or "no move" (see Move)
+ * @param previous The move that led to the position, or "no move" (see Move)
+ */
+MovePicker::MovePicker(const ChessBoard& board, const Move& hash_move, const MoveHistory& history, const int& ply,
+    const Move& previous) : board_{board}, history_{history}, quiescence_{false}, stage_{HASH_MOVE}, hash_move_{hash_move},
+    refutation_count_{0}, refutation_index_{0}, index_{0}, losing_index_{0} {
+    if (!hash_move_.isNone() && !board_.isPseudoLegal(hash_move_)) { hash_move_ = Move(); }
+
+    const Move* killers = history_.killers(ply);
+    const Move candidates[3] = {killers[0], killers[1], history_.counter(previous)};
+    for (const Move& candidate : candidates) {
+        if (candidate.isNone() || candidate == hash_move_) { continue; }
+        bool repeated = false;
+        for (int i = 0; i < refutation_count_; i++) { repeated = repeated || refutations_[i] == candidate; }
+        if (repeated || !board_.isPseudoLegal(candidate) || board_.isCapture(candidate)) { continue; }
+        refutations_[refutation_count_++] = candidate;
+    }
+}
+
+/**
+ * @brief Constructs a quiescence search picker, which only hands out captures that do not lose material & Queen promotions
+ */
+MovePicker::MovePicker(const ChessBoard& board, const MoveHistory& history) : board_{board}, history_{history}, quiescence_{true},
+    stage_{GENERATE_CAPTURES}, hash_move_{}, refutation_count_{0}, refutation_index_{0}, index_{0}, losing_index_{0} {}
+
+/**
+ * @brief Gets the next move
+ * @return True if move was set. False once every move has been handed out.
+ */
+bool MovePicker::next(Move& move) {
+    switch (stage_) {
+        case HASH_MOVE:
+            stage_ = GENERATE_CAPTURES;
+            if (!hash_move_.isNone()) {
+                move = hash_move_;
+                return true;
+            }
+            // Fall through
+        case GENERATE_CAPTURES:
+            moves_.clear();
+            board_.generateCaptures(moves_);
+            for (size_t i = 0; i < moves_.size(); i++) { scores_[i] = captureScore(moves_[i]); }
+            index_ = 0;
+            stage_ = CAPTURES;
+            // Fall through
+        case CAPTURES:
+            while (pickBest(move)) {
+                if (move == hash_move_) { continue; }
+                if (move.promotion()) {
+                    if (move.promotion() == 'Q' || !quiescence_) { return true; }
+                    continue;
+                }
+                if (!StaticExchange::isLosing(board_, move)) { return true; }
+                if (!quiescence_) { losing_captures_.push_back(move); }
+            }
+            if (quiescence_) {
+                stage_ = DONE;
+                return false;
+            }
+            stage_ = REFUTATIONS;
+            // Fall through
+        case REFUTATIONS:
+            if (refutation_index_ < refutation_count_) {
+                move = refutations_[refutation_index_++];
+                return true;
+            }
+            stage_ = GENERATE_QUIETS;
+            // Fall through
+        case GENERATE_QUIETS: {
+            moves_.clear();
+            board_.generateQuiets(moves_);
+            const int side = board_.isPlayerOneTurn() ? 0 : 1;
+            for (size_t i = 0; i < moves_.size(); i++) { scores_[i] = history_.score(side, moves_[i]); }
+            index_ = 0;
+            stage_ = QUIETS;
+        }
+            // Fall through
+        case QUIETS:
+            while (pickBest(move)) {
+                if (!handedOut(move)) { return true; }
+            }
+            stage_ = LOSING_CAPTURES;
+            // Fall through
+        case LOSING_CAPTURES:
+            if (losing_index_ < losing_captures_.size()) {
+                move = losing_captures_[losing_index_++];
+                return true;
+            }
+            stage_ = DONE;
+            // Fall through
+        case DONE:
+            break;
+    }
+    return false;
+}
+
+/**
+ * @brief Moves the best scored move left into position index_ & hands it out
+ * @return False if every move of the stage has been handed out
+ */
+bool MovePicker::pickBest(Move& move) {
+    if (index_ >= moves_.size()) { return false; }
+
+    size_t best = index_;
+    for (size_t i = index_ + 1; i < moves_.size(); i++) {
+        if (scores_[i] > scores_[best]) { best = i; }
+    }
+    std::swap(moves_[index_], moves_[best]);
+    std::swap(scores_[index_], scores_[best]);
+    move = moves_[index_++];
+    return true;
+}
+
+/**
+ * @brief Determines if a move was handed out by an earlier stage
+ */
+bool MovePicker::handedOut(const Move& move) const {
+    if (move == hash_move_) { return true; }
+    for (int i = 0; i < refutation_count_; i++) {
+        if (refutations_[i] == move) { return true; }
+    }
+    return false;
+}
+
+/**
+ * @brief Scores a capture or promotion for MVV-LVA ordering
+ */
+int MovePicker::captureScore(const Move& move) const {
+    if (move.promotion()) { return move.promotion() == 'Q' ? QUEEN_PROMOTION : UNDERPROMOTION; }
+
+    const ChessPiece* attacker = board_.getCell(move.row(), move.col());
+    const ChessPiece* victim = board_.getCell(move.targetRow(), move.targetCol());
+    if (!victim) { victim = board_.getCell(move.row(), move.targetCol()); }    // En passant
+    return 10 * victim->size() - attacker->size();
+}
@@ -0,0 +1,80 @@
+/**
+ * @class MovePicker
+ * @brief Hands out the pseudo-legal moves of a position one at a time, most promising first, generating them in stages
+ *     so that a node cut off early never generates (or sorts) its quiet moves at all.
+ *
+ * Stages, in order:
+ * 1) The hash move (see TranspositionTable), if it is pseudo-legal in this position.
+ * 2) Captures & promotions, most valuable victim first, then least valuable attacker (MVV-LVA, with ChessPiece::size()).
+ *    Queen promotions come before every capture, underpromotions after them. Captures that lose material
+ *    (see StaticExchange) are set aside.
+ * 3) Refutations: the ply's two killer moves, then the counter-move of the previous move (see MoveHistory), if they are
+ *    pseudo-legal quiet moves here.
+ * 4) The remaining quiet moves, by history score.
+ * 5) The losing captures set aside in stage 2.
+ * A move is only ever handed out once. Moves are picked by selection rather than sorted, since most nodes only look at a few.
+ *
+ * For quiescence search, a picker only hands out stage 2: winning & even captures, and Queen promotions.
+ */
+
+#pragma once
+
+#include "MoveHistory.hpp"
+#include "../ChessBoard.hpp"
+
+class MovePicker {
+    public:
+        /**
+         * @brief Constructs a picker for the position on the board, which must not change until the picker is done
+         * @param hash_move The move to try first, or "no move" (see Move)
+         * @param previous The move that led to the position, or "no move" (see Move)
+         */
+        MovePicker(const ChessBoard& board, const Move& hash_move, const MoveHistory& history, const int& ply, const Move& previous);
+
+        /**
+         * @brief Constructs a quiescence search picker, which only hands out captures that do not lose material & Queen promotions
+         */
+        MovePicker(const ChessBoard& board, const MoveHistory& history);
+
+        /**
+         * @brief Gets the next move
+         * @return True if move was set. False once every move has been handed out.
+         */
+        bool next(Move& move);
+
+    private:
+        enum Stage { HASH_MOVE, GENERATE_CAPTURES, CAPTURES, REFUTATIONS, GENERATE_QUIETS, QUIETS, LOSING_CAPTURES, DONE };
+
+        const ChessBoard& board_;
+        const MoveHistory& history_;
+        const bool quiescence_;
+        Stage stage_;
+        Move hash_move_;
+        Move refutations_[3];
+        int refutation_count_;
+        int refutation_index_;
+
+        // The moves of the current stage & their scores. Moves before index_ have been handed out.
+        MoveList moves_;
+        int scores_[MoveList::CAPACITY];
+        size_t index_;
+
+        MoveList losing_captures_;      // In the order they were set aside, ie. MVV-LVA
+        size_t losing_index_;
+
+        /**
+         * @brief Moves the best scored move left into position index_ & hands it out
+         * @return False if every move of the stage has been handed out
+         */
+        bool pickBest(Move& move);
+
+        /**
+         * @brief Determines if a move was handed out by an earlier stage
+         */
+        bool handedOut(const Move& move) const;
+
+        /**
+         * @brief Scores a capture or promotion for MVV-LVA ordering
+         */
+        int captureScore(const Move& move) const;
+};
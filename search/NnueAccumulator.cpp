@@ -0,0 +1,112 @@
+#include "NnueAccumulator.hpp"
+
+#include <cstdlib>
+
+namespace {
+    const size_t INITIAL_DEPTH = 128;   // Plies the stack holds before it grows
+}
+
+/**
+ * @brief Constructs an empty stack
+ * @param network Must stay loaded as long as the accumulator is used
+ */
+NnueAccumulator::NnueAccumulator(const NnueNetwork& network) : network_{network}, stack_(INITIAL_DEPTH), top_{0} {
+    stack_[0].stale = true;
+}
+
+/**
+ * @brief Empties the stack & computes the accumulators of the board's position from scratch
+ */
+void NnueAccumulator::reset(const ChessBoard& board) {
+    top_ = 0;
+    refresh(board, stack_[0]);
+}
+
+/**
+ * @brief Pushes the accumulators of the position reached by a move
+ * @pre makeMove(move, undo) was just called on the board, which was in the position on top of the stack
+ */
+void NnueAccumulator::push(const ChessBoard& board, const Move& move, const MoveUndo& undo) {
+    if (top_ + 1 == stack_.size()) { stack_.resize(stack_.size() * 2); }
+    const Entry& parent = stack_[top_];
+    Entry& entry = stack_[++top_];
+
+    const int from = move.from();
+    const int to = move.to();
+    const char placed = board.getCell(move.targetRow(), move.targetCol())->getSymbol();
+    const char moved = undo.promoted ? 'P' : placed;
+    if (parent.stale || (moved == 'K' && std::abs(move.targetCol() - move.col()) == 2)) {
+        refresh(board, entry);
+        return;
+    }
+    entry.stale = false;
+
+    const int mover = board.isPlayerOneTurn() ? 1 : 0;  // The turn has already passed to the other player
+    for (int perspective = 0; perspective < 2; perspective++) {
+        int added[1] = {NnueNetwork::input(perspective, mover, placed, to)};
+        int removed[2] = {NnueNetwork::input(perspective, mover, moved, from), -1};
+        int removed_count = 1;
+        if (undo.captured) {
+            // En passant takes the Pawn beside the target cell
+            const int captured = (moved == 'P' && undo.en_passant_cell == to) ? GameBoard::cell(move.row(), move.targetCol()) : to;
+            removed[removed_count++] = NnueNetwork::input(perspective, mover ^ 1, undo.captured->getSymbol(), captured);
+        }
+        network_.addRows(parent.values[perspective], entry.values[perspective], added, 1, removed, removed_count);
+    }
+}
+
+/**
+ * @brief Pops the accumulators of the last pushed position, eg. before the move is taken back
+ */
+void NnueAccumulator::pop() {
+    if (top_ > 0) { top_--; }
+}
+
+/**
+ * @brief Evaluates the position on top of the stack
+ * @pre The board is in that position
+ * @return The score in centipawns for the player to move
+ */
+int NnueAccumulator::evaluate(const ChessBoard& board) {
+    Entry& entry = stack_[top_];
+    if (entry.stale) { refresh(board, entry); }
+
+    const int side = board.isPlayerOneTurn() ? 0 : 1;
+    return network_.output(entry.values[side], entry.values[side ^ 1]);
+}
+
+/**
+ * @brief Evaluates the board's position by computing its accumulators from scratch, without using the stack
+ * @return The score in centipawns for the player to move
+ */
+int NnueAccumulator::evaluateFromScratch(const ChessBoard& board) const {
+    Entry entry;
+    refresh(board, entry);
+    const int side = board.isPlayerOneTurn() ? 0 : 1;
+    return network_.output(entry.values[side], entry.values[side ^ 1]);
+}
+
+/**
+ * @brief Computes the accumulators of the board's position from scratch
+ */
+void NnueAccumulator::refresh(const ChessBoard& board, Entry& entry) const {
+    const std::string p1_color = board.getPlayerColor(true);
+    int inputs[2][NnueNetwork::CELLS];
+    int count = 0;
+    for (int cell = 0; cell < NnueNetwork::CELLS; cell++) {
+        const ChessPiece* piece = board.getCell(GameBoard::rowOf(cell), GameBoard::colOf(cell));
+        if (!piece) { continue; }
+
+        const int side = piece->getColor() == p1_color ? 0 : 1;
+        for (int perspective = 0; perspective < 2; perspective++) {
+            inputs[perspective][count] = NnueNetwork::input(perspective, side, piece->getSymbol(), cell);
+        }
+        count++;
+    }
+
+    for (int perspective = 0; perspective < 2; perspective++) {
+        network_.initialize(entry.values[perspective]);
+        network_.addRows(entry.values[perspective], entry.values[perspective], inputs[perspective], count, nullptr, 0);
+    }
+    entry.stale = false;
+}
@@ -0,0 +1,70 @@
+/**
+ * @class NnueAccumulator
+ * @brief A stack of first-layer accumulators of an NnueNetwork, one per ply of the line being searched, kept in step with
+ *     ChessBoard::makeMove() & ChessBoard::unmakeMove().
+ *
+ * push() after each makeMove() derives the new accumulators from the ones below them by adding the weight rows of the pieces
+ * the move put down and subtracting those of the pieces it took away (at most two of each); pop() before each unmakeMove()
+ * simply goes back to the accumulators below. Castling moves four pieces' worth of inputs, and is rare enough that its
+ * accumulators are instead recomputed from the board.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "NnueNetwork.hpp"
+#include "../ChessBoard.hpp"
+
+class NnueAccumulator {
+    public:
+        /**
+         * @brief Constructs an empty stack
+         * @param network Must stay loaded as long as the accumulator is used
+         */
+        NnueAccumulator(const NnueNetwork& network);
+
+        /**
+         * @brief Empties the stack & computes the accumulators of the board's position from scratch
+         */
+        void reset(const ChessBoard& board);
+
+        /**
+         * @brief Pushes the accumulators of the position reached by a move
+         * @pre makeMove(move, undo) was just called on the board, which was in the position on top of the stack
+         */
+        void push(const ChessBoard& board, const Move& move, const MoveUndo& undo);
+
+        /**
+         * @brief Pops the accumulators of the last pushed position, eg. before the move is taken back
+         */
+        void pop();
+
+        /**
+         * @brief Evaluates the position on top of the stack
+         * @pre The board is in that position
+         * @return The score in centipawns for the player to move
+         */
+        int evaluate(const ChessBoard& board);
+
+        /**
+         * @brief Evaluates the board's position by computing its accumulators from scratch, without using the stack
+         * @return The score in centipawns for the player to move
+         */
+        int evaluateFromScratch(const ChessBoard& board) const;
+
+    private:
+        struct Entry {
+            alignas(32) int16_t values[2][NnueNetwork::HIDDEN];    // [perspective][neuron]
+            bool stale;     // The values must be recomputed from the board before use
+        };
+
+        const NnueNetwork& network_;
+        std::vector<Entry> stack_;
+        size_t top_;
+
+        /**
+         * @brief Computes the accumulators of the board's position from scratch
+         */
+        void refresh(const ChessBoard& board, Entry& entry) const;
+};
@@ -0,0 +1,245 @@
+#include "NnueNetwork.hpp"
+#include "Evaluator.hpp"
+#include "../pieces_module.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <immintrin.h>
+#include <utility>
+#include <vector>
+
+namespace {
+    const char SYMBOLS[6] = {'P', 'N', 'B', 'R', 'Q', 'K'};
+
+    const size_t BIASES_OFFSET = sizeof(NnueHeader);
+    const size_t WEIGHTS_OFFSET = BIASES_OFFSET + NnueNetwork::HIDDEN * sizeof(int16_t);
+    const size_t OUTPUT_OFFSET = WEIGHTS_OFFSET + static_cast<size_t>(NnueNetwork::INPUTS) * NnueNetwork::HIDDEN * sizeof(int16_t);
+    const size_t FILE_SIZE = OUTPUT_OFFSET + 2 * NnueNetwork::HIDDEN;
+
+    static_assert(sizeof(NnueHeader) == 64 && WEIGHTS_OFFSET % 64 == 0 && OUTPUT_OFFSET % 64 == 0, "Arrays must be 64-byte aligned");
+    static_assert(NnueNetwork::HIDDEN % 32 == 0, "The AVX2 kernels work on 32 neurons at a time");
+
+    bool cpuHasAvx2() {
+        __builtin_cpu_init();   // May run before the runtime's own CPU detection, being a static initializer
+        return __builtin_cpu_supports("avx2");
+    }
+
+    const bool HAS_AVX2 = cpuHasAvx2();
+    bool use_avx2 = HAS_AVX2;
+
+    void addRowsScalar(const int16_t* source, int16_t* target, const int16_t* weights, const int* added, const int& added_count,
+        const int* removed, const int& removed_count) {
+        for (int j = 0; j < NnueNetwork::HIDDEN; j++) {
+            int16_t value = source[j];
+            for (int i = 0; i < added_count; i++) { value += weights[added[i] * NnueNetwork::HIDDEN + j]; }
+            for (int i = 0; i < removed_count; i++) { value -= weights[removed[i] * NnueNetwork::HIDDEN + j]; }
+            target[j] = value;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void addRowsAvx2(const int16_t* source, int16_t* target, const int16_t* weights, const int* added, const int& added_count,
+        const int* removed, const int& removed_count) {
+        for (int j = 0; j < NnueNetwork::HIDDEN; j += 16) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + j));
+            for (int i = 0; i < added_count; i++) {
+                const __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + added[i] * NnueNetwork::HIDDEN + j));
+                value = _mm256_add_epi16(value, row);
+            }
+            for (int i = 0; i < removed_count; i++) {
+                const __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + removed[i] * NnueNetwork::HIDDEN + j));
+                value = _mm256_sub_epi16(value, row);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + j), value);
+        }
+    }
+
+    int32_t dotScalar(const int16_t* accumulator, const int8_t* weights) {
+        int32_t sum = 0;
+        for (int j = 0; j < NnueNetwork::HIDDEN; j++) {
+            const int16_t activation = std::min<int16_t>(std::max<int16_t>(accumulator[j], 0), NnueNetwork::CLAMP);
+            sum += activation * weights[j];
+        }
+        return sum;
+    }
+
+    __attribute__((target("avx2")))
+    int32_t dotAvx2(const int16_t* accumulator, const int8_t* weights) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i clamp = _mm256_set1_epi16(NnueNetwork::CLAMP);
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i sum = _mm256_setzero_si256();
+        for (int j = 0; j < NnueNetwork::HIDDEN; j += 32) {
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + j));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + j + 16));
+            low = _mm256_min_epi16(_mm256_max_epi16(low, zero), clamp);
+            high = _mm256_min_epi16(_mm256_max_epi16(high, zero), clamp);
+
+            // packus interleaves the 128-bit halves of its operands; the permute puts the 32 activations back in order
+            const __m256i activations = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+            const __m256i products = _mm256_maddubs_epi16(activations, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + j)));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+        }
+        const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        const __m128i quarter = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        return _mm_cvtsi128_si32(_mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0xB1)));
+    }
+}
+
+NnueNetwork::NnueNetwork() : header_{}, biases_{nullptr}, weights_{nullptr},
+    output_weights_{nullptr} {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the weights file, if one is loaded
+ */
+NnueNetwork::~NnueNetwork() {}
+
+/**
+ * @brief Memory-maps a weights file, replacing the network loaded before (if any)
+ * @return True if the file exists and is a valid weights file. False otherwise (nothing changes).
+ */
+bool NnueNetwork::load(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path, FILE_SIZE)) { return false; }
+
+    NnueHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "P4NN", 4) != 0 || header.version != VERSION || header.inputs != static_cast<uint32_t>(INPUTS) ||
+        header.hidden != static_cast<uint32_t>(HIDDEN) || header.output_shift < 0 || header.output_shift > 30) {
+        return false;
+    }
+
+    file_ = std::move(file);
+    header_ = header;
+    const uint8_t* base = file_.data();
+    biases_ = reinterpret_cast<const int16_t*>(base + BIASES_OFFSET);
+    weights_ = reinterpret_cast<const int16_t*>(base + WEIGHTS_OFFSET);
+    output_weights_ = reinterpret_cast<const int8_t*>(base + OUTPUT_OFFSET);
+    return true;
+}
+
+/**
+ * @brief Determines if a weights file is loaded
+ */
+bool NnueNetwork::isLoaded() const {
+    return file_.isOpen();
+}
+
+/**
+ * @brief Writes a weights file whose network computes exactly what Evaluator does (material & placement bonuses
+ *     summed over the pieces), as a starting point until trained weights are available
+ * @return True if the file was written
+ */
+bool NnueNetwork::writeMaterialNetwork(const std::string& path) {
+    // Every Evaluator term is a multiple of 5 centipawns, so the network counts in units of 5
+    const int UNIT = 5;
+    const int sizes[6] = {Pawn().size(), Knight().size(), Bishop().size(), Rook().size(), Queen().size(), 0};
+
+    // Neurons come in pairs per (relative side, type, column): clamp(x) + clamp(x - 127) = x for any x in [0, 254], so a
+    // pair sums the values of up to three Queens on a column exactly
+    auto neuron = [] (const int& relative, const int& type, const int& col, const int& half) {
+        return ((relative * 6 + type) * GameBoard::COLS + col) * 2 + half;
+    };
+
+    std::vector<int16_t> biases(HIDDEN, 0);
+    std::vector<int16_t> weights(static_cast<size_t>(INPUTS) * HIDDEN, 0);
+    std::vector<int8_t> output_weights(2 * HIDDEN, 0);
+    for (int relative = 0; relative < 2; relative++) {
+        for (int type = 0; type < 6; type++) {
+            for (int cell = 0; cell < CELLS; cell++) {
+                // Rows are counted from the perspective's back row, so the other side's Pawns advance towards row 0
+                const int row = relative == 0 ? GameBoard::rowOf(cell) : GameBoard::ROWS - 1 - GameBoard::rowOf(cell);
+                const int col = GameBoard::colOf(cell);
+                int value = sizes[type] * Evaluator::PAWN_VALUE;
+                if (SYMBOLS[type] == 'P') { value += 5 * (row - 1); }
+                if (SYMBOLS[type] == 'N' || SYMBOLS[type] == 'B') { value += 5 * std::min(std::min(row, GameBoard::ROWS - 1 - row), std::min(col, GameBoard::COLS - 1 - col)); }
+
+                const int index = (relative * 6 + type) * CELLS + cell;
+                for (int half = 0; half < 2; half++) {
+                    weights[static_cast<size_t>(index) * HIDDEN + neuron(relative, type, col, half)] = static_cast<int16_t>(value / UNIT);
+                }
+            }
+            for (int col = 0; col < GameBoard::COLS; col++) {
+                biases[neuron(relative, type, col, 1)] = -CLAMP;
+                for (int half = 0; half < 2; half++) { output_weights[neuron(relative, type, col, half)] = relative == 0 ? 1 : -1; }
+            }
+        }
+    }
+
+    NnueHeader header{};
+    std::memcpy(header.magic, "P4NN", 4);
+    header.version = VERSION;
+    header.inputs = INPUTS;
+    header.hidden = HIDDEN;
+    header.output_bias = 0;
+    header.output_scale = UNIT;
+    header.output_shift = 0;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(biases.data()), biases.size() * sizeof(int16_t));
+    out.write(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(int16_t));
+    out.write(reinterpret_cast<const char*>(output_weights.data()), output_weights.size());
+    return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Gets the input index of a piece as seen from a perspective
+ * @param perspective 0 for player one, 1 for player two
+ * @param side The side the piece belongs to (0 for player one, 1 for player two)
+ * @param symbol The piece's symbol ('P', 'N', 'B', 'R', 'Q' or 'K')
+ * @param cell The piece's cell (see GameBoard)
+ * @return The input index, or -1 for an unknown symbol
+ */
+int NnueNetwork::input(const int& perspective, const int& side, const char& symbol, const int& cell) {
+    const char* type = std::find(SYMBOLS, SYMBOLS + 6, symbol);
+    if (type == SYMBOLS + 6) { return -1; }
+
+    // Player two sees the board upside down: its back row becomes row 0
+    const int relative_cell = perspective == 0 ? cell : GameBoard::cell(GameBoard::ROWS - 1 - GameBoard::rowOf(cell), GameBoard::colOf(cell));
+    return ((side ^ perspective) * 6 + static_cast<int>(type - SYMBOLS)) * CELLS + relative_cell;
+}
+
+/**
+ * @brief Copies the first layer's biases into an accumulator
+ */
+void NnueNetwork::initialize(int16_t* accumulator) const {
+    std::memcpy(accumulator, biases_, HIDDEN * sizeof(int16_t));
+}
+
+/**
+ * @brief Computes target = source + the weight rows of added - the weight rows of removed
+ * @param source May equal target
+ */
+void NnueNetwork::addRows(const int16_t* source, int16_t* target, const int* added, const int& added_count, const int* removed,
+    const int& removed_count) const {
+    if (use_avx2) {
+        addRowsAvx2(source, target, weights_, added, added_count, removed, removed_count);
+    } else {
+        addRowsScalar(source, target, weights_, added, added_count, removed, removed_count);
+    }
+}
+
+/**
+ * @brief Runs the output layer
+ * @param us The accumulator of the side to move's perspective
+ * @param them The accumulator of the other perspective
+ * @return The score in centipawns for the side to move
+ */
+int NnueNetwork::output(const int16_t* us, const int16_t* them) const {
+    const int32_t dot = use_avx2 ? dotAvx2(us, output_weights_) + dotAvx2(them, output_weights_ + HIDDEN) :
+        dotScalar(us, output_weights_) + dotScalar(them, output_weights_ + HIDDEN);
+    return static_cast<int>((static_cast<int64_t>(dot + header_.output_bias) * header_.output_scale) >> header_.output_shift);
+}
+
+/**
+ * @brief Turns the AVX2 kernels on (if the CPU supports AVX2) or off, eg. to compare them with the scalar ones.
+ *     Both give identical results. Must not be called while networks are in use on other threads.
+ * @return True if the AVX2 kernels are now in use
+ */
+bool NnueNetwork::setAvx2(const bool& enabled) {
+    use_avx2 = enabled && HAS_AVX2;
+    return use_avx2;
+}
@@ -0,0 +1,122 @@
+/**
+ * @class NnueNetwork
+ * @brief A quantized, efficiently updatable neural network (NNUE) for evaluating positions, memory-mapped from a weights file.
+ *
+ * Architecture: 768 binary inputs -> HIDDEN int16 neurons, computed once per perspective -> 1 output.
+ * - An input is a (piece side relative to the perspective, piece type, cell) triple. Player two's perspective sees the
+ *   board flipped vertically, so both perspectives share one set of weights.
+ * - The first layer's output for one perspective, the "accumulator", is the bias plus the weight rows of the active inputs.
+ *   A move only switches a few inputs on & off, so NnueAccumulator updates it by adding & subtracting a few rows
+ *   instead of recomputing it (see addRows()).
+ * - The output layer clamps both accumulators to [0, 127] ("clipped ReLU"), takes their dot product with int8 weights
+ *   (the side to move's accumulator first), and scales the int32 sum to centipawns.
+ * The int16 row updates & the output dot product have AVX2 kernels, chosen at run time when the CPU supports AVX2,
+ * and scalar ones giving identical results otherwise.
+ *
+ * File layout (host byte order): an NnueHeader, then int16 biases[HIDDEN], int16 weights[INPUTS][HIDDEN] and
+ * int8 output_weights[2][HIDDEN]. Every array starts on a 64-byte boundary.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../BoardGeometry.hpp"
+#include "../MappedFile.hpp"
+
+/**
+ * @brief On-disk header of a weights file
+ */
+struct NnueHeader {
+    char magic[8];          // "P4NN" followed by zeros
+    uint32_t version;       // Currently 1
+    uint32_t inputs;        // Must be NnueNetwork::INPUTS
+    uint32_t hidden;        // Must be NnueNetwork::HIDDEN
+    int32_t output_bias;    // Added to the output dot product
+    int32_t output_scale;   // Centipawns = ((dot product + output_bias) * output_scale) >> output_shift
+    int32_t output_shift;
+    uint8_t reserved[32];
+};
+
+class NnueNetwork {
+    public:
+        static const uint32_t VERSION = 1;
+        static const int CELLS = GameBoard::CELLS;
+        static const int INPUTS = 2 * 6 * CELLS;
+        static const int HIDDEN = 256;
+        static constexpr int16_t CLAMP = 127;   // Upper bound of the clipped ReLU
+
+        NnueNetwork();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the weights file, if one is loaded
+         */
+        ~NnueNetwork();
+
+        NnueNetwork(const NnueNetwork&) = delete;
+        NnueNetwork& operator=(const NnueNetwork&) = delete;
+
+        /**
+         * @brief Memory-maps a weights file, replacing the network loaded before (if any)
+         * @return True if the file exists and is a valid weights file. False otherwise (nothing changes).
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Determines if a weights file is loaded
+         */
+        bool isLoaded() const;
+
+        /**
+         * @brief Writes a weights file whose network computes exactly what Evaluator does (material & placement bonuses
+         *     summed over the pieces), as a starting point until trained weights are available
+         * @return True if the file was written
+         */
+        static bool writeMaterialNetwork(const std::string& path);
+
+        /**
+         * @brief Gets the input index of a piece as seen from a perspective
+         * @param perspective 0 for player one, 1 for player two
+         * @param side The side the piece belongs to (0 for player one, 1 for player two)
+         * @param symbol The piece's symbol ('P', 'N', 'B', 'R', 'Q' or 'K')
+         * @param cell The piece's cell (see GameBoard)
+         * @return The input index, or -1 for an unknown symbol
+         */
+        static int input(const int& perspective, const int& side, const char& symbol, const int& cell);
+
+        /**
+         * @brief Copies the first layer's biases into an accumulator
+         */
+        void initialize(int16_t* accumulator) const;
+
+        /**
+         * @brief Computes target = source + the weight rows of added - the weight rows of removed
+         * @param source May equal target
+         */
+        void addRows(const int16_t* source, int16_t* target, const int* added, const int& added_count, const int* removed,
+            const int& removed_count) const;
+
+        /**
+         * @brief Runs the output layer
+         * @param us The accumulator of the side to move's perspective
+         * @param them The accumulator of the other perspective
+         * @return The score in centipawns for the side to move
+         */
+        int output(const int16_t* us, const int16_t* them) const;
+
+        /**
+         * @brief Turns the AVX2 kernels on (if the CPU supports AVX2) or off, eg. to compare them with the scalar ones.
+         *     Both give identical results. Must not be called while networks are in use on other threads.
+         * @return True if the AVX2 kernels are now in use
+         */
+        static bool setAvx2(const bool& enabled);
+
+    private:
+        MappedFile file_;
+        NnueHeader header_;
+        const int16_t* biases_;
+        const int16_t* weights_;
+        const int8_t* output_weights_;
+};
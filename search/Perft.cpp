@@ -0,0 +1,182 @@
+#include "Perft.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // A subtree to count: the one after playing roots[root] then reply
+    struct Task {
+        size_t root;
+        Move reply;
+    };
+
+    /**
+     * One deque of tasks per worker. A worker takes its own tasks from the back and, once it has none left, steals
+     * from the front of the others', so thieves and owners rarely contend for the same end.
+     * Every task is queued before the workers start, so a worker that finds every deque empty is done.
+     */
+    class TaskQueues {
+        public:
+            TaskQueues(const unsigned& workers) : queues_(workers), locks_(new std::mutex[workers]) {}
+
+            void push(const unsigned& worker, const Task& task) { queues_[worker].push_back(task); }
+
+            bool next(const unsigned& worker, Task& task) {
+                const unsigned workers = static_cast<unsigned>(queues_.size());
+                for (unsigned i = 0; i < workers; i++) {
+                    const unsigned victim = (worker + i) % workers;
+                    std::lock_guard<std::mutex> lock(locks_[victim]);
+                    std::deque<Task>& queue = queues_[victim];
+                    if (queue.empty()) { continue; }
+                    if (i == 0) {
+                        task = queue.back();
+                        queue.pop_back();
+                    } else {
+                        task = queue.front();
+                        queue.pop_front();
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            std::vector<std::deque<Task>> queues_;
+            std::unique_ptr<std::mutex[]> locks_;
+    };
+}
+
+/**
+ * @brief Counts the legal move sequences of exactly depth plies from the position on the board
+ * @post The board is back in its original position
+ */
+uint64_t Perft::count(ChessBoard& board, const int& depth) {
+    if (depth <= 0) { return 1; }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (depth == 1) { return moves.size(); }   // Leaves are counted, not played
+
+    uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        MoveUndo undo;
+        board.makeMove(move, undo);
+        nodes += count(board, depth - 1);
+        board.unmakeMove(move, undo);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Counts the sequences of depth plies starting with each legal move, in generateLegalMoves() order
+ * @pre depth >= 1
+ */
+std::vector<std::pair<Move, uint64_t>> Perft::divide(ChessBoard& board, const int& depth) {
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    std::vector<std::pair<Move, uint64_t>> counts;
+    for (const Move& move : moves) {
+        MoveUndo undo;
+        board.makeMove(move, undo);
+        counts.emplace_back(move, count(board, depth - 1));
+        board.unmakeMove(move, undo);
+    }
+    return counts;
+}
+
+/**
+ * @brief Counts like divide(), splitting the tree across worker threads that share a hash table of subtree counts
+ * @param threads The number of worker threads. 0 uses one per hardware thread.
+ * @param stats Set to the probes & hits of the hash table during this count
+ * @pre depth >= 1
+ */
+std::vector<std::pair<Move, uint64_t>> Perft::divide(ChessBoard& board, const int& depth, const unsigned& threads,
+    PerftHash& hash, Stats& stats) {
+    stats = Stats();
+    if (depth < 3) { return divide(board, depth); }    // Too few nodes to be worth a thread
+
+    MoveList roots;
+    board.generateLegalMoves(roots);
+
+    // One task per (root move, reply) pair: a few hundred subtrees of uneven size for the workers to balance
+    std::vector<Task> tasks;
+    for (size_t root = 0; root < roots.size(); root++) {
+        MoveUndo undo;
+        MoveList replies;
+        board.makeMove(roots[root], undo);
+        board.generateLegalMoves(replies);
+        board.unmakeMove(roots[root], undo);
+        for (const Move& reply : replies) { tasks.push_back({root, reply}); }
+    }
+
+    const unsigned wanted = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    const unsigned workers = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(wanted, tasks.size())));
+
+    // Neighbouring tasks share their root move, so each worker starts on a contiguous range of them
+    TaskQueues queues(workers);
+    for (size_t i = 0; i < tasks.size(); i++) { queues.push(static_cast<unsigned>(i * workers / tasks.size()), tasks[i]); }
+
+    // Snapshots are taken here, before any thread starts; each worker then only touches its own
+    std::vector<std::unique_ptr<ChessBoard>> boards;
+    for (unsigned t = 0; t < workers; t++) { boards.push_back(board.snapshot()); }
+
+    std::vector<std::atomic<uint64_t>> counts(roots.size());
+    std::vector<Stats> worker_stats(workers);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < workers; t++) {
+        pool.emplace_back([&, t] () {
+            ChessBoard& own = *boards[t];
+            Task task;
+            while (queues.next(t, task)) {
+                MoveUndo root_undo;
+                MoveUndo reply_undo;
+                own.makeMove(roots[task.root], root_undo);
+                own.makeMove(task.reply, reply_undo);
+                counts[task.root].fetch_add(count(own, depth - 2, hash, worker_stats[t]), std::memory_order_relaxed);
+                own.unmakeMove(task.reply, reply_undo);
+                own.unmakeMove(roots[task.root], root_undo);
+            }
+        });
+    }
+    for (std::thread& worker : pool) { worker.join(); }
+
+    for (const Stats& worker : worker_stats) {
+        stats.probes += worker.probes;
+        stats.hits += worker.hits;
+    }
+
+    std::vector<std::pair<Move, uint64_t>> result;
+    for (size_t root = 0; root < roots.size(); root++) { result.emplace_back(roots[root], counts[root].load()); }
+    return result;
+}
+
+/**
+ * @brief Counts like count(), looking subtrees of two or more plies up in hash before counting them
+ */
+uint64_t Perft::count(ChessBoard& board, const int& depth, PerftHash& hash, Stats& stats) {
+    if (depth < 2) { return count(board, depth); }
+
+    uint64_t nodes = 0;
+    stats.probes++;
+    if (hash.probe(board.getHash(), depth, nodes)) {
+        stats.hits++;
+        return nodes;
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    for (const Move& move : moves) {
+        MoveUndo undo;
+        board.makeMove(move, undo);
+        nodes += count(board, depth - 1, hash, stats);
+        board.unmakeMove(move, undo);
+    }
+
+    hash.store(board.getHash(), depth, nodes);
+    return nodes;
+}
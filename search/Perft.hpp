@@ -0,0 +1,58 @@
+/**
+ * @class Perft
+ * @brief Counts the leaves of the legal move tree to a fixed depth (perft), to check move generation against known counts.
+ *
+ * Published counts for positions such as "kiwipete" exercise castling, en passant, promotions and pins, which random
+ * games rarely reach. divide() splits the count by root move, so that a mismatch can be narrowed down one move at a time.
+ *
+ * The threaded divide() deals the subtrees after each (root move, reply) pair out to worker threads, each playing them
+ * on its own snapshot of the board. A worker that runs out of subtrees steals from the others, so a few large subtrees
+ * do not leave threads idle. Workers share a PerftHash, so a subtree reached again by transposition, on any thread,
+ * is looked up rather than recounted.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "PerftHash.hpp"
+#include "../ChessBoard.hpp"
+
+class Perft {
+    public:
+        /**
+         * @brief Hash table activity of a threaded divide()
+         */
+        struct Stats {
+            uint64_t probes = 0;
+            uint64_t hits = 0;
+        };
+
+        /**
+         * @brief Counts the legal move sequences of exactly depth plies from the position on the board
+         * @post The board is back in its original position
+         */
+        static uint64_t count(ChessBoard& board, const int& depth);
+
+        /**
+         * @brief Counts the sequences of depth plies starting with each legal move, in generateLegalMoves() order
+         * @pre depth >= 1
+         */
+        static std::vector<std::pair<Move, uint64_t>> divide(ChessBoard& board, const int& depth);
+
+        /**
+         * @brief Counts like divide(), splitting the tree across worker threads that share a hash table of subtree counts
+         * @param threads The number of worker threads. 0 uses one per hardware thread.
+         * @param stats Set to the probes & hits of the hash table during this count
+         * @pre depth >= 1
+         */
+        static std::vector<std::pair<Move, uint64_t>> divide(ChessBoard& board, const int& depth, const unsigned& threads,
+            PerftHash& hash, Stats& stats);
+
+    private:
+        /**
+         * @brief Counts like count(), looking subtrees of two or more plies up in hash before counting them
+         */
+        static uint64_t count(ChessBoard& board, const int& depth, PerftHash& hash, Stats& stats);
+};
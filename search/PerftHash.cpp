@@ -0,0 +1,61 @@
+#include "PerftHash.hpp"
+
+/**
+ * @brief Constructs a table of (at most) the given size, rounded down to a power of two entries
+ * @param megabytes The table size. 0 makes a table that never hits.
+ */
+PerftHash::PerftHash(const size_t& megabytes) : size_{0} {
+    const size_t wanted = megabytes * 1024 * 1024 / sizeof(Entry);
+    if (wanted == 0) { return; }
+
+    size_ = 1;
+    while (size_ * 2 <= wanted) { size_ *= 2; }
+
+    // Value-initialised, so every entry starts as (0, 0): depth 0 is never stored, so empty slots never hit
+    entries_.reset(new Entry[size_]());
+}
+
+/**
+ * @brief Looks up the count of a subtree
+ * @param nodes Set to the stored count on a hit
+ * @return True if a count for the position at this depth was found
+ */
+bool PerftHash::probe(const uint64_t& hash, const int& depth, uint64_t& nodes) const {
+    if (!size_) { return false; }
+
+    const Entry& entry = entries_[slot(hash, depth)];
+    const uint64_t data = entry.data.load(std::memory_order_relaxed);
+    const uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != hash || static_cast<int>(data & 0xFF) != depth) { return false; }
+
+    nodes = data >> 8;
+    return true;
+}
+
+/**
+ * @brief Records the count of a subtree, replacing whatever was in its slot
+ * @pre 0 < depth < 256 and nodes < 2^56
+ */
+void PerftHash::store(const uint64_t& hash, const int& depth, const uint64_t& nodes) {
+    if (!size_) { return; }
+
+    Entry& entry = entries_[slot(hash, depth)];
+    const uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+    entry.check.store(hash ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of entries
+ */
+size_t PerftHash::size() const {
+    return size_;
+}
+
+/**
+ * @brief Gets the slot of a (hash, depth) pair. The depth is mixed in so that the counts of one position at
+ *     different depths do not evict each other.
+ */
+size_t PerftHash::slot(const uint64_t& hash, const int& depth) const {
+    return static_cast<size_t>((hash ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL)) & (size_ - 1));
+}
@@ -0,0 +1,58 @@
+/**
+ * @class PerftHash
+ * @brief A lock-free table of perft subtree counts, keyed by (position hash, depth), shared by every perft thread.
+ *
+ * Each entry is a pair of 64-bit words: the data (node count & depth) and the position hash XORed with the data.
+ * Threads read & write the words without locks; an entry torn by two concurrent stores fails the XOR check on probe
+ * and simply counts as a miss, so a race can only cost a recount, never a wrong count.
+ * New counts always replace the entry in their slot.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class PerftHash {
+    public:
+        /**
+         * @brief Constructs a table of (at most) the given size, rounded down to a power of two entries
+         * @param megabytes The table size. 0 makes a table that never hits.
+         */
+        PerftHash(const size_t& megabytes);
+
+        /**
+         * @brief Looks up the count of a subtree
+         * @param nodes Set to the stored count on a hit
+         * @return True if a count for the position at this depth was found
+         */
+        bool probe(const uint64_t& hash, const int& depth, uint64_t& nodes) const;
+
+        /**
+         * @brief Records the count of a subtree, replacing whatever was in its slot
+         * @pre 0 < depth < 256 and nodes < 2^56
+         */
+        void store(const uint64_t& hash, const int& depth, const uint64_t& nodes);
+
+        /**
+         * @brief Gets the number of entries
+         */
+        size_t size() const;
+
+    private:
+        struct Entry {
+            std::atomic<uint64_t> check;    // hash ^ data
+            std::atomic<uint64_t> data;     // (nodes << 8) | depth
+        };
+
+        std::unique_ptr<Entry[]> entries_;
+        size_t size_;
+
+        /**
+         * @brief Gets the slot of a (hash, depth) pair. The depth is mixed in so that the counts of one position at
+         *     different depths do not evict each other.
+         */
+        size_t slot(const uint64_t& hash, const int& depth) const;
+};
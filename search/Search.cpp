@@ -0,0 +1,277 @@
+#include "Search.hpp"
+#include "Evaluator.hpp"
+#include "MovePicker.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    const long long REPORT_INTERVAL = 1000;    // Milliseconds between two progress reports
+}
+
+/**
+ * @brief Constructs a search over board. The board is changed while searching & restored before run() returns.
+ * @param table The table to read & store results in, kept by the caller so that later searches can reuse them
+ */
+Search::Search(ChessBoard& board, TranspositionTable& table) : board_{board}, table_{table}, stop_{false}, nodes_{0}, node_limit_{0},
+    iteration_{0}, root_hint_{}, report_{nullptr}, pv_length_{} {}
+
+/**
+ * @brief Searches the position until a limit is reached or stop() is called
+ * @param report Called with every finished iteration & periodic progress
+ * @return The best move found, or "no move" (see Move) if the player to move has no legal move
+ */
+Move Search::run(const SearchLimits& limits, const std::function<void(const SearchInfo&)>& report) {
+    report_ = &report;
+    nodes_.store(0, std::memory_order_relaxed);
+    MoveList root_moves;
+    board_.generateLegalMoves(root_moves);
+
+    const int side = board_.isPlayerOneTurn() ? 0 : 1;
+    if (limits.infinite) {
+        time_.start(0, 0, 0, 0, static_cast<int>(root_moves.size()));
+    } else {
+        time_.start(limits.movetime, limits.time[side], limits.increment[side], limits.moves_to_go, static_cast<int>(root_moves.size()));
+    }
+    last_report_ = std::chrono::steady_clock::now();
+    node_limit_ = limits.infinite ? 0 : limits.nodes;
+    const int max_depth = (!limits.infinite && limits.depth > 0) ? std::min(limits.depth, MAX_PLY) : MAX_PLY;
+    if (root_moves.empty()) { return Move(); }
+
+    if (nnue_) { nnue_->reset(board_); }
+
+    const int lines = std::max(1, std::min(limits.multi_pv, static_cast<int>(root_moves.size())));
+    std::vector<Move> previous(lines);  // Each variation's move in the last finished iteration
+    Move best = root_moves.front();
+    for (iteration_ = 1; iteration_ <= max_depth; iteration_++) {
+        int score = 0;
+        excluded_.clear();
+        for (int line = 0; line < lines; line++) {
+            root_hint_ = previous[line];
+            const int line_score = negamax(iteration_, -INFINITE_SCORE, INFINITE_SCORE, 0);
+            if (stop_.load(std::memory_order_relaxed)) { break; } // Unfinished searches can't be trusted
+
+            // The first variation saw every root move, so its move is the best even if the iteration stops after it
+            if (line == 0) {
+                best = pv_[0][0];
+                score = line_score;
+            }
+            previous[line] = pv_[0][0];
+            excluded_.push_back(pv_[0][0]);
+            report(SearchInfo{iteration_, line_score, getNodes(), elapsed(), std::vector<Move>(pv_[0], pv_[0] + pv_length_[0]), line + 1});
+        }
+        if (stop_.load(std::memory_order_relaxed)) { break; }
+
+        // Stop on a mate that no deeper iteration can shorten, or when the time manager sees no use in another iteration.
+        // An infinite search only stops when asked to.
+        if (limits.infinite) { continue; }
+        if (isMateScore(score) && MATE_SCORE - std::abs(score) <= iteration_) { break; }
+        if (time_.onIteration(best, score)) { break; }
+    }
+
+    report_ = nullptr;
+    return best;
+}
+
+/**
+ * @brief Evaluates positions with a network instead of Evaluator
+ * @param network A loaded network, which must outlive the search, or nullptr to go back to Evaluator
+ * @pre No search is running
+ */
+void Search::setNetwork(const NnueNetwork* network) {
+    nnue_.reset(network ? new NnueAccumulator(*network) : nullptr);
+}
+
+/**
+ * @brief Asks a running search to return as soon as possible. Safe to call from any thread.
+ */
+void Search::stop() {
+    std::lock_guard<std::mutex> lock(stop_mutex_);
+    stop_.store(true, std::memory_order_relaxed);
+    stopped_.notify_all();
+}
+
+/**
+ * @brief Waits until stop() is called, returning at once if it already was. An infinite search may end on its own
+ *     (at MAX_PLY, or with no legal move), but UCI front-ends must not report its move before they are told to stop.
+ */
+void Search::waitForStop() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    stopped_.wait(lock, [this] () { return stop_.load(std::memory_order_relaxed); });
+}
+
+/**
+ * @brief Gets the number of nodes searched by the last (or current) call to run()
+ */
+long long Search::getNodes() const {
+    return nodes_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Determines if a score announces a forced mate
+ */
+bool Search::isMateScore(const int& score) {
+    return std::abs(score) >= MATE_SCORE - MAX_PLY;
+}
+
+/**
+ * @brief Searches the current position to depth, returning its score for the player to move within [alpha, beta]
+ */
+int Search::negamax(int depth, int alpha, int beta, const int& ply) {
+    pv_length_[ply] = ply;
+    if (checkLimits()) { return 0; }
+    if (ply >= MAX_PLY) { return evaluate(); }
+    if (depth <= 0) { return quiescence(alpha, beta, ply); }
+
+    const uint64_t hash = board_.getHash();
+    TranspositionTable::Entry entry;
+    Move hash_move{};
+    if (table_.probe(hash, entry)) {
+        hash_move = entry.move;
+
+        // The root always searches, so that it has a best move & principal variation to report
+        const int score = TranspositionTable::fromTable(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth && (entry.bound == TranspositionTable::EXACT ||
+            (entry.bound == TranspositionTable::LOWER && score >= beta) || (entry.bound == TranspositionTable::UPPER && score <= alpha))) {
+            return score;
+        }
+    }
+    // At the root, the variation's move of the previous iteration is searched first
+    if (ply == 0 && !root_hint_.isNone()) { hash_move = root_hint_; }
+
+    const Move none{};
+    MovePicker picker(board_, hash_move, history_, ply, ply > 0 ? played_[ply - 1] : none);
+    const bool mover = board_.isPlayerOneTurn();
+    const int original_alpha = alpha;
+    Move best = none;
+    MoveList quiets;   // Quiet moves searched without a cutoff, which lose history if another one cuts off
+    int legal_moves = 0;
+    for (Move move; picker.next(move); ) {
+        if (board_.castlesThroughCheck(move)) { continue; }
+        if (ply == 0 && std::find(excluded_.begin(), excluded_.end(), move) != excluded_.end()) { continue; }
+        const bool quiet = !board_.isCapture(move);
+
+        MoveUndo undo;
+        board_.makeMove(move, undo);
+        if (board_.isInCheck(mover)) {
+            board_.unmakeMove(move, undo);
+            continue;
+        }
+        legal_moves++;
+        if (nnue_) { nnue_->push(board_, move, undo); }
+
+        played_[ply] = move;
+        int score = -negamax(depth - 1, -beta, -alpha, ply + 1);
+        if (nnue_) { nnue_->pop(); }
+        board_.unmakeMove(move, undo);
+        if (stop_.load(std::memory_order_relaxed)) { return 0; }
+
+        if (score > alpha) {
+            alpha = score;
+            best = move;
+            pv_[ply][ply] = move;
+            for (int i = ply + 1; i < pv_length_[ply + 1]; i++) { pv_[ply][i] = pv_[ply + 1][i]; }
+            pv_length_[ply] = std::max(ply + 1, pv_length_[ply + 1]);
+            if (alpha >= beta) {
+                if (quiet) { history_.update(mover ? 0 : 1, depth, ply, move, quiets, ply > 0 ? played_[ply - 1] : none); }
+                break;
+            }
+        }
+        if (quiet) { quiets.push_back(move); }
+    }
+
+    if (legal_moves == 0) {
+        // Checkmate (the sooner the better for the winner) or stalemate
+        return board_.isInCheck(mover) ? -MATE_SCORE + ply : 0;
+    }
+
+    // A root missing the moves of earlier variations is not the real position
+    if (ply == 0 && !excluded_.empty()) { return alpha; }
+
+    const TranspositionTable::Bound bound = alpha >= beta ? TranspositionTable::LOWER :
+        alpha > original_alpha ? TranspositionTable::EXACT : TranspositionTable::UPPER;
+    table_.store(hash, depth, TranspositionTable::toTable(alpha, ply), bound, best);
+    return alpha;
+}
+
+/**
+ * @brief Searches captures only (see MovePicker) until the position is quiet, so that positions are never evaluated
+ *     in the middle of an exchange. The player to move may instead "stand pat" on the static evaluation, unless in
+ *     check, in which case every move is searched.
+ */
+int Search::quiescence(int alpha, int beta, const int& ply) {
+    pv_length_[ply] = ply;
+    if (checkLimits()) { return 0; }
+    if (ply >= MAX_PLY) { return evaluate(); }
+
+    const bool mover = board_.isPlayerOneTurn();
+    const bool in_check = board_.isInCheck(mover);
+    if (!in_check) {
+        const int stand_pat = evaluate();
+        if (stand_pat >= beta) { return beta; }
+        alpha = std::max(alpha, stand_pat);
+    }
+
+    const Move none{};
+    MovePicker picker = in_check ? MovePicker(board_, none, history_, ply, none) : MovePicker(board_, history_);
+    int legal_moves = 0;
+    for (Move move; picker.next(move); ) {
+        if (board_.castlesThroughCheck(move)) { continue; }
+
+        MoveUndo undo;
+        board_.makeMove(move, undo);
+        if (board_.isInCheck(mover)) {
+            board_.unmakeMove(move, undo);
+            continue;
+        }
+        legal_moves++;
+        if (nnue_) { nnue_->push(board_, move, undo); }
+
+        int score = -quiescence(-beta, -alpha, ply + 1);
+        if (nnue_) { nnue_->pop(); }
+        board_.unmakeMove(move, undo);
+        if (stop_.load(std::memory_order_relaxed)) { return 0; }
+
+        if (score > alpha) {
+            alpha = score;
+            if (alpha >= beta) { break; }
+        }
+    }
+
+    // Only an evasion search saw every move
+    if (in_check && legal_moves == 0) { return -MATE_SCORE + ply; }
+    return alpha;
+}
+
+/**
+ * @brief Counts a node, and checks the node limit at every node & the time every few thousand nodes
+ * @return True if the search must stop
+ */
+bool Search::checkLimits() {
+    long long nodes = nodes_.load(std::memory_order_relaxed) + 1;
+    nodes_.store(nodes, std::memory_order_relaxed);
+    if (node_limit_ > 0 && nodes >= node_limit_) { stop(); }
+
+    // Only the clock read is spread out
+    if (TimeManager::shouldCheck(nodes)) {
+        auto now = std::chrono::steady_clock::now();
+        if (time_.isHardLimitReached(now)) { stop(); }
+
+        if (report_ && now - last_report_ >= std::chrono::milliseconds(REPORT_INTERVAL)) {
+            last_report_ = now;
+            (*report_)(SearchInfo{iteration_, 0, nodes, elapsed(), {}});
+        }
+    }
+    return stop_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Evaluates the current position for the player to move, with the network if one is set
+ */
+int Search::evaluate() {
+    return nnue_ ? nnue_->evaluate(board_) : Evaluator::evaluate(board_);
+}
+
+long long Search::elapsed() const {
+    return time_.elapsed();
+}
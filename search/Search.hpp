@@ -0,0 +1,157 @@
+/**
+ * @class Search
+ * @brief Iterative-deepening alpha-beta (negamax) search over a ChessBoard.
+ *
+ * run() searches one depth at a time until a limit of SearchLimits is reached or stop() is called, reporting every finished
+ * iteration (and, during long iterations, progress about once a second) through a callback. With multi_pv > 1, each
+ * iteration searches the root once per variation, leaving out the root moves of the variations already found, and
+ * reports each variation as it completes. stop() may be called from
+ * any thread, which is how a front-end such as UciEngine runs the search on a worker thread while it keeps reading input.
+ *
+ * Time limits are worked out by a TimeManager, which checks the clock every few thousand nodes and decides after each
+ * iteration whether another one is worth starting.
+ *
+ * Nodes store their result in a TranspositionTable, which may outlive the search (eg. across the moves of a game):
+ * a stored bound that settles a node cuts it off, and the stored move is searched first otherwise. Moves come from a
+ * MovePicker, which orders the rest by captures, then killer & counter-moves, then history (see MoveHistory).
+ * At depth 0, a quiescence search resolves pending captures before the position is evaluated, by Evaluator or, when
+ * one is set, by an NnueNetwork whose accumulators follow every move made & taken back (see NnueAccumulator).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "MoveHistory.hpp"
+#include "NnueAccumulator.hpp"
+#include "TimeManager.hpp"
+#include "TranspositionTable.hpp"
+#include "../ChessBoard.hpp"
+
+/**
+ * @brief When a search has to stop. Zero means "no limit" for every field.
+ */
+struct SearchLimits {
+    int depth = 0;                      // Deepest iteration to search
+    long long nodes = 0;                // Nodes to search
+    long long movetime = 0;             // Milliseconds to search
+    long long time[2] = {0, 0};         // Milliseconds left on player one's [0] & player two's [1] clock
+    long long increment[2] = {0, 0};    // Milliseconds added to each clock per move
+    int moves_to_go = 0;                // Moves until the next time control
+    bool infinite = false;              // Search until stop() is called, ignoring every other limit & forced mates
+    int multi_pv = 1;                   // Principal variations to search, each with the best move the others leave out
+};
+
+/**
+ * @brief A report of the search's progress
+ */
+struct SearchInfo {
+    int depth;              // Iteration the report belongs to
+    int score;              // Centipawns for the player to move, or +/- (MATE_SCORE - plies) for a forced mate
+    long long nodes;        // Nodes searched so far
+    long long time;         // Milliseconds elapsed so far
+    std::vector<Move> pv;   // Principal variation. Empty for progress reports sent in the middle of an iteration.
+    int multi_pv = 1;       // Rank of the variation among those of the iteration, best first
+};
+
+class Search {
+    public:
+        static constexpr int INFINITE_SCORE = 32000;
+        static constexpr int MATE_SCORE = 31000;
+        static constexpr int MAX_PLY = 64;
+
+        /**
+         * @brief Constructs a search over board. The board is changed while searching & restored before run() returns.
+         * @param table The table to read & store results in, kept by the caller so that later searches can reuse them
+         */
+        Search(ChessBoard& board, TranspositionTable& table);
+
+        /**
+         * @brief Searches the position until a limit is reached or stop() is called
+         * @param report Called with every finished iteration & periodic progress
+         * @return The best move found, or "no move" (see Move) if the player to move has no legal move
+         */
+        Move run(const SearchLimits& limits, const std::function<void(const SearchInfo&)>& report);
+
+        /**
+         * @brief Evaluates positions with a network instead of Evaluator
+         * @param network A loaded network, which must outlive the search, or nullptr to go back to Evaluator
+         * @pre No search is running
+         */
+        void setNetwork(const NnueNetwork* network);
+
+        /**
+         * @brief Asks a running search to return as soon as possible. Safe to call from any thread.
+         */
+        void stop();
+
+        /**
+         * @brief Waits until stop() is called, returning at once if it already was. An infinite search may end on its own
+         *     (at MAX_PLY, or with no legal move), but UCI front-ends must not report its move before they are told to stop.
+         */
+        void waitForStop();
+
+        /**
+         * @brief Gets the number of nodes searched by the last (or current) call to run()
+         */
+        long long getNodes() const;
+
+        /**
+         * @brief Determines if a score announces a forced mate
+         */
+        static bool isMateScore(const int& score);
+
+    private:
+        ChessBoard& board_;
+        TranspositionTable& table_;
+        MoveHistory history_;
+        std::unique_ptr<NnueAccumulator> nnue_;     // Kept in step with the board while searching, if a network is set
+        std::atomic<bool> stop_;
+        std::mutex stop_mutex_;             // Guards stop() against waitForStop() missing its notification
+        std::condition_variable stopped_;
+        std::atomic<long long> nodes_;
+        long long node_limit_;
+        TimeManager time_;
+        std::chrono::steady_clock::time_point last_report_;
+        int iteration_;
+        Move root_hint_;        // Searched first at the root: the same variation's move in the previous iteration
+        MoveList excluded_;     // Root moves of the variations already found in this iteration
+        const std::function<void(const SearchInfo&)>* report_;
+
+        // Triangular principal variation table: pv_[ply] holds the best line found from ply onward
+        Move pv_[MAX_PLY + 1][MAX_PLY + 1];
+        int pv_length_[MAX_PLY + 1];
+
+        // The move played at each ply of the current line, for counter-moves
+        Move played_[MAX_PLY + 1];
+
+        /**
+         * @brief Searches the current position to depth, returning its score for the player to move within [alpha, beta]
+         */
+        int negamax(int depth, int alpha, int beta, const int& ply);
+
+        /**
+         * @brief Searches captures only (see MovePicker) until the position is quiet, so that positions are never evaluated
+         *     in the middle of an exchange. The player to move may instead "stand pat" on the static evaluation, unless in
+         *     check, in which case every move is searched.
+         */
+        int quiescence(int alpha, int beta, const int& ply);
+
+        /**
+         * @brief Counts a node, and checks the node limit at every node & the time every few thousand nodes
+         * @return True if the search must stop
+         */
+        bool checkLimits();
+
+        /**
+         * @brief Evaluates the current position for the player to move, with the network if one is set
+         */
+        int evaluate();
+
+        long long elapsed() const;
+};
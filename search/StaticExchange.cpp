@@ -0,0 +1,97 @@
+#include "StaticExchange.hpp"
+
+#include <algorithm>
+
+namespace {
+    using Geometry = GameBoard;
+    using Mask = Geometry::Mask;
+
+    const int MAX_EXCHANGE = 32;    // Captures in one exchange: there are at most 32 pieces
+}
+
+/**
+ * @brief Evaluates a capture
+ * @pre move is a pseudo-legal capture (en passant included) of the player whose turn it is
+ * @return The material won (positive) or lost (negative) by the player making the capture, in ChessPiece::size() units
+ */
+int StaticExchange::evaluate(const ChessBoard& board, const Move& move) {
+    const std::string p1_color = board.getPlayerColor(true);
+    Mask sides[2] = {0, 0};
+    Mask pawns = 0, knights = 0, kings = 0, orthogonal = 0, diagonal = 0;
+    int values[Geometry::CELLS] = {};
+    for (int cell = 0; cell < Geometry::CELLS; cell++) {
+        const ChessPiece* piece = board.getCell(Geometry::rowOf(cell), Geometry::colOf(cell));
+        if (!piece) { continue; }
+
+        const Mask bit = Geometry::bit(cell);
+        sides[piece->getColor() == p1_color ? 0 : 1] |= bit;
+        values[cell] = piece->size();
+        switch (piece->getSymbol()) {
+            case 'P': pawns |= bit; break;
+            case 'N': knights |= bit; break;
+            case 'B': diagonal |= bit; break;
+            case 'R': orthogonal |= bit; break;
+            case 'Q': orthogonal |= bit; diagonal |= bit; break;
+            case 'K': kings |= bit; break;
+        }
+    }
+
+    const int from = Geometry::cell(move.row(), move.col());
+    const int target = Geometry::cell(move.targetRow(), move.targetCol());
+    Mask occupied = (sides[0] | sides[1]) & ~Geometry::bit(from);
+
+    int gain[MAX_EXCHANGE];
+    if (values[target]) {
+        gain[0] = values[target];
+    } else {
+        // En passant: the captured Pawn stands beside the target, & leaves the board at once
+        const int captured = Geometry::cell(move.row(), move.targetCol());
+        gain[0] = values[captured];
+        occupied &= ~Geometry::bit(captured);
+    }
+
+    // Player one's Pawns capture onto target from the cells a player two Pawn on target would capture on, & vice versa
+    const Mask pawn_attackers = (Geometry::PAWN_CAPTURES[1][target].mask & pawns & sides[0]) |
+        (Geometry::PAWN_CAPTURES[0][target].mask & pawns & sides[1]);
+    const Mask jump_attackers = pawn_attackers | (Geometry::KNIGHT[target].mask & knights) | (Geometry::KING[target].mask & kings);
+
+    // gain[depth] is the balance for the side making the depth-th capture, if the exchange stopped right after it
+    int side = (sides[0] & Geometry::bit(from)) ? 1 : 0;   // The side to recapture next
+    int on_target = values[from];
+    int depth = 0;
+    while (depth + 1 < MAX_EXCHANGE) {
+        const Mask attackers = (jump_attackers | Geometry::sliders(target, occupied, orthogonal, diagonal)) & occupied;
+        const Mask own = attackers & sides[side];
+        if (!own) { break; }
+
+        // The cheapest attacker recaptures; the King only goes last, & only onto an undefended cell
+        int cheapest = -1;
+        for (Mask cells = own; cells; cells &= cells - 1) {
+            const int cell = Geometry::lowest(cells);
+            if (cheapest < 0 || (kings & Geometry::bit(cheapest)) || (!(kings & Geometry::bit(cell)) && values[cell] < values[cheapest])) {
+                cheapest = cell;
+            }
+        }
+        if ((kings & Geometry::bit(cheapest)) && (attackers & sides[side ^ 1])) { break; }
+
+        depth++;
+        gain[depth] = on_target - gain[depth - 1];
+        on_target = values[cheapest];
+        occupied &= ~Geometry::bit(cheapest);
+        side ^= 1;
+    }
+
+    // Each side only makes its capture if that beats stopping before it
+    for (; depth > 0; depth--) { gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]); }
+    return gain[0];
+}
+
+/**
+ * @brief Determines if a capture loses material. Cheaper than evaluate() when the victim is worth at least the attacker.
+ * @pre move is a pseudo-legal capture (en passant included) of the player whose turn it is
+ */
+bool StaticExchange::isLosing(const ChessBoard& board, const Move& move) {
+    const ChessPiece* victim = board.getCell(move.targetRow(), move.targetCol());
+    if (!victim || victim->size() >= board.getCell(move.row(), move.col())->size()) { return false; }   // En passant is Pawn for Pawn
+    return evaluate(board, move) < 0;
+}
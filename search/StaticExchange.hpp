@@ -0,0 +1,30 @@
+/**
+ * @class StaticExchange
+ * @brief Static exchange evaluation (SEE): the material a capture wins or loses once every piece attacking its target cell
+ *     has had the chance to recapture, cheapest first, each side stopping whenever recapturing would lose more.
+ *
+ * The exchange is worked out on attack masks rather than by making moves. The occupancy, piece and side masks are read off
+ * the board once; each capture then just clears the capturing piece's bit, which uncovers any slider lined up behind it
+ * (see BoardGeometry::sliders()). Values are ChessPiece::size(). A King only recaptures when the other side has no
+ * attacker left.
+ */
+
+#pragma once
+
+#include "../ChessBoard.hpp"
+
+class StaticExchange {
+    public:
+        /**
+         * @brief Evaluates a capture
+         * @pre move is a pseudo-legal capture (en passant included) of the player whose turn it is
+         * @return The material won (positive) or lost (negative) by the player making the capture, in ChessPiece::size() units
+         */
+        static int evaluate(const ChessBoard& board, const Move& move);
+
+        /**
+         * @brief Determines if a capture loses material. Cheaper than evaluate() when the victim is worth at least the attacker.
+         * @pre move is a pseudo-legal capture (en passant included) of the player whose turn it is
+         */
+        static bool isLosing(const ChessBoard& board, const Move& move);
+};
@@ -0,0 +1,119 @@
+#include "TimeManager.hpp"
+
+#include <algorithm>
+
+namespace {
+    const double SOFT_SHARE = 0.6;          // Part of the clock's share at which no new iteration starts
+    const double HARD_SHARE = 3.0;          // Multiple of the clock's share at which the search is stopped
+    const double MAX_CLOCK_USE = 0.4;       // Most of the clock a single move may use before the last move of a control
+    const int MAX_MOVES_TO_GO = 50;
+
+    const int STABLE_ITERATIONS = 4;        // Same best move for this many iterations: a clear choice
+    const double STABLE_SCALE = 0.5;
+    const double INSTABILITY_SCALE = 0.6;   // Added per (decayed) best move change
+    const int SCORE_DROP = 30;              // Centipawns lost in an iteration that call for more time
+    const double SCORE_DROP_SCALE = 1.4;
+    const double MAX_SCALE = 2.5;
+}
+
+TimeManager::TimeManager() : soft_limit_{0}, hard_limit_{0}, fixed_{false}, single_move_{false}, iterations_{0}, last_best_{},
+    last_score_{0}, stable_iterations_{0}, instability_{0}, scale_{1} {}
+
+/**
+ * @brief Starts timing a search. Zero means "no limit" for every argument.
+ * @param movetime A fixed time for the move, in milliseconds. Takes precedence over the clock.
+ * @param time The milliseconds left on the clock of the player to move
+ * @param increment The milliseconds added to that clock per move
+ * @param moves_to_go The moves until the next time control
+ * @param legal_moves The number of legal moves at the root
+ */
+void TimeManager::start(const long long& movetime, const long long& time, const long long& increment, const int& moves_to_go,
+    const int& legal_moves) {
+    start_ = std::chrono::steady_clock::now();
+    fixed_ = movetime > 0;
+    single_move_ = legal_moves == 1;
+    iterations_ = 0;
+    last_best_ = Move();
+    last_score_ = 0;
+    stable_iterations_ = 0;
+    instability_ = 0;
+    scale_ = 1;
+
+    if (fixed_) {
+        // The next iteration takes longer than all the previous ones together: don't start one past half the time
+        hard_limit_ = movetime;
+        soft_limit_ = movetime / 2;
+    } else if (time > 0) {
+        const int moves = moves_to_go > 0 ? std::min(moves_to_go, MAX_MOVES_TO_GO) : DEFAULT_MOVES_TO_GO;
+        const long long available = std::max(1LL, time - SAFETY_MARGIN);
+        const long long most = moves == 1 ? available : std::max(1LL, static_cast<long long>(available * MAX_CLOCK_USE));
+        const long long share = time / moves + increment * 3 / 4;
+        soft_limit_ = std::max(1LL, std::min(most, static_cast<long long>(share * SOFT_SHARE)));
+        hard_limit_ = std::max(soft_limit_, std::min(most, static_cast<long long>(share * HARD_SHARE)));
+    } else {
+        soft_limit_ = 0;
+        hard_limit_ = 0;
+    }
+    hard_deadline_ = start_ + std::chrono::milliseconds(hard_limit_);
+}
+
+/**
+ * @brief Determines if the search has a time limit at all
+ */
+bool TimeManager::isLimited() const {
+    return hard_limit_ > 0;
+}
+
+/**
+ * @brief Determines if the hard limit is reached at a time read from the clock
+ */
+bool TimeManager::isHardLimitReached(const std::chrono::steady_clock::time_point& now) const {
+    return hard_limit_ > 0 && now >= hard_deadline_;
+}
+
+/**
+ * @brief Records a finished iteration & decides whether to start another one
+ * @param best The iteration's best move
+ * @param score The iteration's score
+ * @return True if the search should stop
+ */
+bool TimeManager::onIteration(const Move& best, const int& score) {
+    iterations_++;
+    if (!isLimited()) { return false; }
+    if (single_move_) { return true; }
+
+    if (!fixed_) {
+        const bool changed = iterations_ > 1 && !(best == last_best_);
+        instability_ = instability_ / 2 + (changed ? 1 : 0);
+        stable_iterations_ = changed ? 0 : stable_iterations_ + 1;
+
+        scale_ = 1 + INSTABILITY_SCALE * instability_;
+        if (iterations_ > 1 && score <= last_score_ - SCORE_DROP) { scale_ *= SCORE_DROP_SCALE; }
+        if (stable_iterations_ >= STABLE_ITERATIONS && instability_ < 0.5) { scale_ = STABLE_SCALE; }
+        scale_ = std::min(scale_, MAX_SCALE);
+    }
+    last_best_ = best;
+    last_score_ = score;
+    return elapsed() >= getSoftLimit();
+}
+
+/**
+ * @brief Gets the milliseconds elapsed since start()
+ */
+long long TimeManager::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+}
+
+/**
+ * @brief Gets the soft limit in milliseconds, as currently scaled, or 0 without a time limit
+ */
+long long TimeManager::getSoftLimit() const {
+    return std::min(hard_limit_, static_cast<long long>(soft_limit_ * scale_));
+}
+
+/**
+ * @brief Gets the hard limit in milliseconds, or 0 without a time limit
+ */
+long long TimeManager::getHardLimit() const {
+    return hard_limit_;
+}
@@ -0,0 +1,96 @@
+/**
+ * @class TimeManager
+ * @brief Decides how long a search may run, from a fixed move time or the player's clock.
+ *
+ * Two limits are worked out when the search starts:
+ * - the soft limit, after which no new iteration is started. A clock's share is its remaining time over the moves to go
+ *   (DEFAULT_MOVES_TO_GO when unknown) plus most of the increment; the soft limit is part of that share.
+ * - the hard limit, at which the search is stopped in the middle of an iteration. It leaves room for an iteration
+ *   started just before the soft limit, but never more than a fraction of the clock (all of it, less SAFETY_MARGIN,
+ *   when the time control ends after this move).
+ * After each iteration, the soft limit is scaled by how settled the search looks: it grows while the best move keeps
+ * changing or the score drops, and shrinks once the same move has been best for several iterations. The search stops
+ * after the first iteration when there is a single legal move.
+ *
+ * The clock is only read by shouldCheck() callers every CHECK_NODES nodes; steady_clock reads through the vDSO, so even
+ * those reads cost no system call.
+ */
+
+#pragma once
+
+#include <chrono>
+#include "../Move.hpp"
+
+class TimeManager {
+    public:
+        static const long long CHECK_NODES = 2048;          // Nodes between two looks at the clock; a power of two
+        static const long long SAFETY_MARGIN = 50;          // Milliseconds kept on the clock for communication overhead
+        static const int DEFAULT_MOVES_TO_GO = 30;
+
+        TimeManager();
+
+        /**
+         * @brief Starts timing a search. Zero means "no limit" for every argument.
+         * @param movetime A fixed time for the move, in milliseconds. Takes precedence over the clock.
+         * @param time The milliseconds left on the clock of the player to move
+         * @param increment The milliseconds added to that clock per move
+         * @param moves_to_go The moves until the next time control
+         * @param legal_moves The number of legal moves at the root
+         */
+        void start(const long long& movetime, const long long& time, const long long& increment, const int& moves_to_go,
+            const int& legal_moves);
+
+        /**
+         * @brief Determines if the search has a time limit at all
+         */
+        bool isLimited() const;
+
+        /**
+         * @brief Determines if the clock should be read after a node count, ie. every CHECK_NODES nodes
+         */
+        static bool shouldCheck(const long long& nodes) {
+            return (nodes & (CHECK_NODES - 1)) == 0;
+        }
+
+        /**
+         * @brief Determines if the hard limit is reached at a time read from the clock
+         */
+        bool isHardLimitReached(const std::chrono::steady_clock::time_point& now) const;
+
+        /**
+         * @brief Records a finished iteration & decides whether to start another one
+         * @param best The iteration's best move
+         * @param score The iteration's score
+         * @return True if the search should stop
+         */
+        bool onIteration(const Move& best, const int& score);
+
+        /**
+         * @brief Gets the milliseconds elapsed since start()
+         */
+        long long elapsed() const;
+
+        /**
+         * @brief Gets the soft limit in milliseconds, as currently scaled, or 0 without a time limit
+         */
+        long long getSoftLimit() const;
+
+        /**
+         * @brief Gets the hard limit in milliseconds, or 0 without a time limit
+         */
+        long long getHardLimit() const;
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::steady_clock::time_point hard_deadline_;
+        long long soft_limit_;      // Before scaling
+        long long hard_limit_;
+        bool fixed_;                // A fixed move time, which is not scaled
+        bool single_move_;
+        int iterations_;
+        Move last_best_;
+        int last_score_;
+        int stable_iterations_;     // Iterations in a row with the same best move
+        double instability_;        // Best move changes, halved every iteration
+        double scale_;              // Applied to soft_limit_
+};
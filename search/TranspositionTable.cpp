@@ -0,0 +1,253 @@
+#include "TranspositionTable.hpp"
+#include "Search.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+    const uint32_t SHARED_VERSION = 1;
+    const int SHARED_WAIT_MS = 1000;    // Longest wait for another process to finish creating a segment
+
+    /**
+     * @brief Header of a shared-memory segment, followed by the slots
+     */
+    struct SharedHeader {
+        char magic[8];                  // "P4TT" followed by zeros
+        uint32_t version;
+        std::atomic<uint32_t> ready;    // Set by the creator once the other fields are written
+        uint64_t slots;                 // A power of two
+        uint8_t reserved[40];
+    };
+
+    static_assert(sizeof(SharedHeader) == 64, "The slots must start on a cache line");
+
+    /**
+     * @brief Waits until a condition holds, for at most SHARED_WAIT_MS
+     * @return True if the condition held in time
+     */
+    template <typename Condition>
+    bool waitFor(const Condition& condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHARED_WAIT_MS);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() >= deadline) { return false; }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Constructs a table of (at most) the given size, rounded down to a power of two entries (at least one)
+ */
+TranspositionTable::TranspositionTable(const size_t& megabytes) {
+    static_assert(sizeof(Slot) == 16, "Four entries per cache line");
+    resize(megabytes);
+}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps the shared segment, if one is open. The segment itself is kept.
+ */
+TranspositionTable::~TranspositionTable() {}
+
+/**
+ * @brief Replaces the slots with empty ones of (at most) the given size, rounded down to a power of two entries (at least one).
+ *     A shared table goes back to slots of the process's own; the segment itself is kept.
+ * @pre No search is using the table
+ */
+void TranspositionTable::resize(const size_t& megabytes) {
+    segment_.close();
+
+    const size_t wanted = megabytes * 1024 * 1024 / sizeof(Slot);
+    size_t size = 1;
+    while (size * 2 <= wanted) { size *= 2; }
+    private_slots_.reset(); // Let go of the old slots before allocating the new ones
+    private_slots_.reset(new Slot[size]);
+    slots_ = private_slots_.get();
+    mask_ = size - 1;
+    clear();
+}
+
+/**
+ * @brief Moves the table into a named shared-memory segment, replacing its current slots. A missing segment is
+ *     created with the table's size (and empty); an existing one is used as it is, whatever its size.
+ * @param name The segment's name, eg. "p4-hash" (a leading '/' is added if missing)
+ * @pre No search is using the table
+ * @return True if the segment was opened. False otherwise (nothing changes), eg. if it is not a table.
+ */
+bool TranspositionTable::openShared(const std::string& name) {
+    const std::string path = (name.empty() || name[0] != '/') ? "/" + name : name;
+    bool created = true;
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = shm_open(path.c_str(), O_RDWR, 0);
+    }
+    if (fd < 0) { return false; }
+
+    // A new segment is sized at once, and ftruncate() fills it with zeros: slots that are all empty entries
+    size_t size = sizeof(SharedHeader) + (mask_ + 1) * sizeof(Slot);
+    if (created && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    if (!created) {
+        // The process creating the segment may not have sized it yet
+        struct stat info;
+        const bool sized = waitFor([&] { return fstat(fd, &info) == 0 && info.st_size > 0; });
+        size = sized ? static_cast<size_t>(info.st_size) : 0;
+        if (size < sizeof(SharedHeader) + sizeof(Slot)) {
+            close(fd);
+            return false;
+        }
+    }
+
+    MappedFile segment;
+    const bool mapped = segment.map(fd, size, MappedFile::HUGE_PAGES);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (!mapped) {
+        if (created) { shm_unlink(path.c_str()); }
+        return false;
+    }
+
+    SharedHeader* header = reinterpret_cast<SharedHeader*>(segment.data());
+    const size_t slots = (size - sizeof(SharedHeader)) / sizeof(Slot);
+    if (created) {
+        std::memcpy(header->magic, "P4TT", 4);
+        header->version = SHARED_VERSION;
+        header->slots = slots;
+        header->ready.store(1, std::memory_order_release);
+    } else if (!waitFor([&] { return header->ready.load(std::memory_order_acquire) != 0; }) ||
+            std::memcmp(header->magic, "P4TT", 4) != 0 || header->version != SHARED_VERSION || header->slots != slots ||
+            (slots & (slots - 1)) != 0) {
+        return false;
+    }
+
+    private_slots_.reset();
+    segment_ = std::move(segment);
+    slots_ = reinterpret_cast<Slot*>(segment_.data() + sizeof(SharedHeader));
+    mask_ = slots - 1;
+    return true;
+}
+
+/**
+ * @brief Leaves the shared segment, if one is open, for empty slots of the process's own of the same size
+ * @pre No search is using the table
+ */
+void TranspositionTable::closeShared() {
+    if (!segment_.isOpen()) { return; }
+    segment_.close();
+    private_slots_.reset(new Slot[mask_ + 1]);
+    slots_ = private_slots_.get();
+    clear();
+}
+
+/**
+ * @brief Determines if the table lives in a shared-memory segment
+ */
+bool TranspositionTable::isShared() const {
+    return segment_.isOpen();
+}
+
+/**
+ * @brief Gets the size of the slots in megabytes: the size asked for, rounded down to a power of two entries, or the
+ *     size of the shared segment in use (which an existing segment keeps, whatever size was asked for)
+ */
+size_t TranspositionTable::getMegabytes() const {
+    return (mask_ + 1) * sizeof(Slot) / (1024 * 1024);
+}
+
+/**
+ * @brief Looks up a position
+ * @return True if the table holds an entry for hash, in which case entry is set
+ */
+bool TranspositionTable::probe(const uint64_t& hash, Entry& entry) const {
+    const Slot& slot = slots_[hash & mask_];
+    const uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != hash) { return false; }
+
+    const Entry stored = unpack(hash, data);
+    if (stored.bound == NONE) { return false; }
+    entry = stored;
+    return true;
+}
+
+/**
+ * @brief Records the result of a search of a position
+ * @param score The score, already converted with toTable()
+ * @param move The best move, or "no move" (see Move) to keep the one already stored for the position
+ */
+void TranspositionTable::store(const uint64_t& hash, const int& depth, const int& score, const Bound& bound, const Move& move) {
+    Slot& slot = slots_[hash & mask_];
+    Entry entry;
+    const bool same = probe(hash, entry);
+    if (same && entry.depth > depth && bound != EXACT) { return; }
+
+    if (!move.isNone() || !same) { entry.move = move; }
+    entry.key = hash;
+    entry.score = static_cast<int16_t>(score);
+    entry.depth = static_cast<int8_t>(depth);
+    entry.bound = bound;
+
+    const uint64_t data = pack(entry);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(hash ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Empties the table, eg. before a new game. A shared table is emptied for every process using it.
+ */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask_; i++) {
+        slots_[i].data.store(0, std::memory_order_relaxed);
+        slots_[i].check.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Converts a score from the root's perspective (mates counted from the root) into one stored at ply
+ */
+int TranspositionTable::toTable(const int& score, const int& ply) {
+    if (score >= Search::MATE_SCORE - Search::MAX_PLY) { return score + ply; }
+    if (score <= -Search::MATE_SCORE + Search::MAX_PLY) { return score - ply; }
+    return score;
+}
+
+/**
+ * @brief Converts a stored score back for a node at ply
+ */
+int TranspositionTable::fromTable(const int& score, const int& ply) {
+    if (score >= Search::MATE_SCORE - Search::MAX_PLY) { return score - ply; }
+    if (score <= -Search::MATE_SCORE + Search::MAX_PLY) { return score + ply; }
+    return score;
+}
+
+/**
+ * @brief Encodes the move, score, depth & bound of an entry into a data word
+ */
+uint64_t TranspositionTable::pack(const Entry& entry) {
+    return uint64_t{entry.move.raw()} | uint64_t{static_cast<uint16_t>(entry.score)} << 16 |
+        uint64_t{static_cast<uint8_t>(entry.depth)} << 32 | uint64_t{entry.bound} << 40;
+}
+
+/**
+ * @brief Decodes a data word into the entry of a position
+ */
+TranspositionTable::Entry TranspositionTable::unpack(const uint64_t& key, const uint64_t& data) {
+    Entry entry;
+    entry.key = key;
+    entry.move = Move::fromRaw(static_cast<uint16_t>(data));
+    entry.score = static_cast<int16_t>(data >> 16);
+    entry.depth = static_cast<int8_t>(data >> 32);
+    entry.bound = static_cast<Bound>((data >> 40) & 0xFF);
+    return entry;
+}
@@ -0,0 +1,144 @@
+/**
+ * @class TranspositionTable
+ * @brief Remembers, per position hash, the outcome of the last search of that position: its best move, depth & score bound.
+ *
+ * The table is a power-of-two array of entries indexed by the low bits of the hash, each keeping the full hash to reject
+ * other positions sharing its slot. A new result replaces the slot's entry unless that entry is a deeper search of the same
+ * position. The search plays the stored move first (see MovePicker) and cuts off when the stored bound already settles the node.
+ *
+ * Mate scores are stored relative to the node rather than the root (see toTable() & fromTable()), so that an entry stays
+ * correct when the position is reached again at another ply.
+ *
+ * Several searches may share a table from different threads without locking. Each slot stores its entry as two 64-bit
+ * words, the data and the key XORed with the data; a slot two threads wrote at once holds words of different entries,
+ * whose XOR matches neither key, so probe() rejects it instead of returning a mix of both.
+ *
+ * The slots normally live in the process's own memory. openShared() moves them to a named POSIX shared-memory segment
+ * instead, so that several engine processes on a host probe & store into one table through the same lock-free protocol.
+ * The segment starts with a 64-byte header (magic "P4TT", version & slot count) followed by the slots; it outlives the
+ * processes using it, so a restarted process finds the table as it was left, until the segment is removed
+ * (eg. rm /dev/shm/<name> on Linux). Transparent huge pages are requested for it where the system allows them for shared
+ * memory.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "../MappedFile.hpp"
+#include "../Move.hpp"
+
+class TranspositionTable {
+    public:
+        /**
+         * @brief How a stored score relates to the true score of the position
+         */
+        enum Bound : uint8_t { NONE, UPPER, LOWER, EXACT };
+
+        struct Entry {
+            uint64_t key = 0;
+            Move move{};  // Best (or refuting) move found, or "no move" (see Move)
+            int16_t score = 0;
+            int8_t depth = 0;
+            Bound bound = NONE;
+        };
+
+        /**
+         * @brief Constructs a table of (at most) the given size, rounded down to a power of two entries (at least one)
+         */
+        TranspositionTable(const size_t& megabytes);
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps the shared segment, if one is open. The segment itself is kept.
+         */
+        ~TranspositionTable();
+
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+        /**
+         * @brief Replaces the slots with empty ones of (at most) the given size, rounded down to a power of two entries (at least one).
+         *     A shared table goes back to slots of the process's own; the segment itself is kept.
+         * @pre No search is using the table
+         */
+        void resize(const size_t& megabytes);
+
+        /**
+         * @brief Moves the table into a named shared-memory segment, replacing its current slots. A missing segment is
+         *     created with the table's size (and empty); an existing one is used as it is, whatever its size.
+         * @param name The segment's name, eg. "p4-hash" (a leading '/' is added if missing)
+         * @pre No search is using the table
+         * @return True if the segment was opened. False otherwise (nothing changes), eg. if it is not a table.
+         */
+        bool openShared(const std::string& name);
+
+        /**
+         * @brief Leaves the shared segment, if one is open, for empty slots of the process's own of the same size
+         * @pre No search is using the table
+         */
+        void closeShared();
+
+        /**
+         * @brief Determines if the table lives in a shared-memory segment
+         */
+        bool isShared() const;
+
+        /**
+         * @brief Gets the size of the slots in megabytes: the size asked for, rounded down to a power of two entries, or the
+         *     size of the shared segment in use (which an existing segment keeps, whatever size was asked for)
+         */
+        size_t getMegabytes() const;
+
+        /**
+         * @brief Looks up a position
+         * @return True if the table holds an entry for hash, in which case entry is set
+         */
+        bool probe(const uint64_t& hash, Entry& entry) const;
+
+        /**
+         * @brief Records the result of a search of a position
+         * @param score The score, already converted with toTable()
+         * @param move The best move, or "no move" (see Move) to keep the one already stored for the position
+         */
+        void store(const uint64_t& hash, const int& depth, const int& score, const Bound& bound, const Move& move);
+
+        /**
+         * @brief Empties the table, eg. before a new game. A shared table is emptied for every process using it.
+         */
+        void clear();
+
+        /**
+         * @brief Converts a score from the root's perspective (mates counted from the root) into one stored at ply
+         */
+        static int toTable(const int& score, const int& ply);
+
+        /**
+         * @brief Converts a stored score back for a node at ply
+         */
+        static int fromTable(const int& score, const int& ply);
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> check;    // key ^ data
+            std::atomic<uint64_t> data;     // Move, score, depth & bound of the entry
+        };
+
+        std::unique_ptr<Slot[]> private_slots_;     // Null while the table is shared
+        MappedFile segment_;                        // The shared segment, if one is open
+        Slot* slots_;                               // Private or shared
+        size_t mask_;                               // Number of slots - 1
+
+        /**
+         * @brief Encodes the move, score, depth & bound of an entry into a data word
+         */
+        static uint64_t pack(const Entry& entry);
+
+        /**
+         * @brief Decodes a data word into the entry of a position
+         */
+        static Entry unpack(const uint64_t& key, const uint64_t& data);
+};
@@ -0,0 +1,232 @@
+/**
+ * @class VariantPerft
+ * @brief Counts the leaves of the legal move tree (perft) of a position on any BoardGeometry, for variants played on
+ *     boards ChessBoard does not handle (eg. Capablanca chess on CapablancaBoard, Los Alamos chess on MiniBoard).
+ *
+ * A position is a plain grid of FEN letters, walked with the geometry's own generators (slide(), jump(), isAttacked())
+ * and tables, so that every geometry instantiation is built and checked against known counts (see "main perftsuite").
+ * Besides the standard pieces it knows Capablanca's compounds: the Archbishop ('A', Bishop + Knight) and the Chancellor
+ * ('C', Rook + Knight). Pawns step twice from their starting row when the rules allow it, capture en passant, and
+ * promote to any piece the rules list. Castling is not generated.
+ *
+ * As on ChessBoard, row 0 is player one's (FEN White's) back row and FEN file 'a' is the last column.
+ */
+
+#pragma once
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+template <class Geometry>
+class VariantPerft {
+    public:
+        /**
+         * @brief The rules that differ between variants
+         */
+        struct Rules {
+            bool double_steps;          // Pawns may step twice from their starting row (and be taken en passant)
+            const char* promotions;     // The pieces a Pawn reaching the last row may become, eg. "QRBN"
+        };
+
+        /**
+         * @brief A position: the piece on every cell as a FEN letter (0 for an empty cell), and the state around it
+         */
+        struct Position {
+            std::array<std::array<char, Geometry::COLS>, Geometry::ROWS> grid;
+            int side;           // 0 when player one is to move
+            int en_passant;     // The cell a Pawn that just stepped twice passed over, -1 if none
+            int kings[2];       // Each side's King cell
+        };
+
+        /**
+         * @brief Parses a FEN position on the geometry's board, eg. "rnqknr/pppppp/6/6/PPPPPP/RNQKNR w - - 0 1".
+         *     Empty runs may take two digits (eg. "10" on CapablancaBoard).
+         * @return True if the text is a valid position (exactly one King per player, no castling rights), in which case
+         *     position is set. False otherwise.
+         */
+        static bool fromFen(const std::string& fen, Position& position) {
+            std::istringstream fields(fen);
+            std::string placement, side, castling = "-", en_passant = "-";
+            fields >> placement >> side >> castling >> en_passant;
+            if ((side != "w" && side != "b") || castling != "-") { return false; }
+
+            Position result{};
+            result.side = side == "w" ? 0 : 1;
+            result.kings[0] = result.kings[1] = -1;
+
+            // Ranks are listed from the last row down to row 0, files from 'a' (the last column) to column 0
+            int row = Geometry::ROWS - 1;
+            int file = 0;
+            for (size_t i = 0; i < placement.size(); i++) {
+                const char symbol = placement[i];
+                if (symbol == '/') {
+                    if (file != Geometry::COLS || row == 0) { return false; }
+                    row--;
+                    file = 0;
+                    continue;
+                }
+                if (std::isdigit(static_cast<unsigned char>(symbol))) {
+                    int run = symbol - '0';
+                    if (i + 1 < placement.size() && std::isdigit(static_cast<unsigned char>(placement[i + 1]))) {
+                        run = run * 10 + (placement[++i] - '0');
+                    }
+                    file += run;
+                    if (file > Geometry::COLS) { return false; }
+                    continue;
+                }
+                if (file >= Geometry::COLS || PIECES.find(static_cast<char>(std::toupper(symbol))) == std::string::npos) { return false; }
+
+                const int col = Geometry::COLS - 1 - file;
+                result.grid[row][col] = symbol;
+                if (std::toupper(symbol) == 'K') {
+                    if (result.kings[sideOf(symbol)] >= 0) { return false; }
+                    result.kings[sideOf(symbol)] = Geometry::cell(row, col);
+                }
+                file++;
+            }
+            if (row != 0 || file != Geometry::COLS || result.kings[0] < 0 || result.kings[1] < 0) { return false; }
+
+            result.en_passant = -1;
+            if (en_passant != "-") {
+                const int col = Geometry::COLS - 1 - (en_passant[0] - 'a');
+                const int rank = std::atoi(en_passant.c_str() + 1) - 1;
+                if (!Geometry::contains(rank, col)) { return false; }
+                result.en_passant = Geometry::cell(rank, col);
+            }
+
+            position = result;
+            return true;
+        }
+
+        /**
+         * @brief Counts the legal move sequences of exactly depth plies from a position
+         */
+        static uint64_t count(const Position& position, const Rules& rules, const int& depth) {
+            if (depth == 0) { return 1; }
+
+            uint64_t nodes = 0;
+            forEachLegal(position, rules, [&] (const Position& next) { nodes += count(next, rules, depth - 1); });
+            return nodes;
+        }
+
+    private:
+        using Mask = typename Geometry::Mask;
+
+        static inline const std::string PIECES = "PNBRQKAC";
+
+        static int sideOf(const char& letter) { return std::isupper(static_cast<unsigned char>(letter)) ? 0 : 1; }
+
+        /**
+         * @brief Determines if a piece of by_side could capture on cell. A compound attacks like each of its parts, so
+         *     the grid is looked at twice: once with compounds seen as their slider, once with them seen as Knights.
+         */
+        static bool attacked(const Position& position, const int& cell, const int& by_side) {
+            auto as_slider = [&by_side] (const char& letter) -> char {
+                if (sideOf(letter) != by_side) { return 0; }
+                const char symbol = static_cast<char>(std::toupper(letter));
+                return symbol == 'A' ? 'B' : symbol == 'C' ? 'R' : symbol;
+            };
+            auto as_knight = [&by_side] (const char& letter) -> char {
+                const char symbol = static_cast<char>(std::toupper(letter));
+                return sideOf(letter) == by_side && (symbol == 'A' || symbol == 'C') ? 'N' : 0;
+            };
+            return Geometry::isAttacked(cell, by_side, position.grid, as_slider) ||
+                Geometry::isAttacked(cell, by_side, position.grid, as_knight);
+        }
+
+        /**
+         * @brief Builds the position after moving the piece on from to target
+         * @param promotion The piece a Pawn becomes (uppercase), 0 otherwise
+         */
+        static Position play(const Position& position, const int& from, const int& target, const char& promotion) {
+            Position next = position;
+            const int side = position.side;
+            const char piece = next.grid[Geometry::rowOf(from)][Geometry::colOf(from)];
+            const char symbol = static_cast<char>(std::toupper(piece));
+
+            // En passant takes the Pawn beside the target cell, on the moving Pawn's row
+            if (symbol == 'P' && target == position.en_passant) {
+                next.grid[Geometry::rowOf(from)][Geometry::colOf(target)] = 0;
+            }
+            next.grid[Geometry::rowOf(target)][Geometry::colOf(target)] =
+                promotion ? static_cast<char>(side == 0 ? promotion : std::tolower(promotion)) : piece;
+            next.grid[Geometry::rowOf(from)][Geometry::colOf(from)] = 0;
+
+            if (symbol == 'K') { next.kings[side] = target; }
+            next.en_passant = symbol == 'P' && std::abs(Geometry::rowOf(target) - Geometry::rowOf(from)) == 2 ?
+                (from + target) / 2 : -1;
+            next.side = side ^ 1;
+            return next;
+        }
+
+        /**
+         * @brief Calls visit with the position after each legal move of the player to move
+         */
+        template <class Visit>
+        static void forEachLegal(const Position& position, const Rules& rules, const Visit& visit) {
+            const int side = position.side;
+            auto enemy = [&side] (const char& occupant) { return sideOf(occupant) != side; };
+            auto visitLegal = [&] (const int& from, const int& target, const char& promotion) {
+                const Position next = play(position, from, target, promotion);
+                if (!attacked(next, next.kings[side], side ^ 1)) { visit(next); }
+            };
+
+            for (int from = 0; from < Geometry::CELLS; from++) {
+                const char piece = position.grid[Geometry::rowOf(from)][Geometry::colOf(from)];
+                if (!piece || sideOf(piece) != side) { continue; }
+
+                const char symbol = static_cast<char>(std::toupper(piece));
+                if (symbol == 'P') {
+                    forEachPawnMove(position, rules, from, [&] (const int& target) {
+                        const int last_row = side == 0 ? Geometry::ROWS - 1 : 0;
+                        if (Geometry::rowOf(target) != last_row) {
+                            visitLegal(from, target, 0);
+                            return;
+                        }
+                        for (const char* type = rules.promotions; *type; type++) { visitLegal(from, target, *type); }
+                    });
+                    continue;
+                }
+
+                Mask targets = 0;
+                if (symbol == 'N' || symbol == 'A' || symbol == 'C') { targets |= Geometry::jump(Geometry::KNIGHT[from], position.grid, enemy); }
+                if (symbol == 'K') { targets |= Geometry::jump(Geometry::KING[from], position.grid, enemy); }
+                if (symbol == 'R' || symbol == 'Q' || symbol == 'C') {
+                    targets |= Geometry::slide(from, Geometry::NORTH, Geometry::NORTH_EAST, position.grid, enemy);
+                }
+                if (symbol == 'B' || symbol == 'Q' || symbol == 'A') {
+                    targets |= Geometry::slide(from, Geometry::NORTH_EAST, Geometry::DIRECTIONS, position.grid, enemy);
+                }
+                for (; targets; targets &= targets - 1) { visitLegal(from, Geometry::lowest(targets), 0); }
+            }
+        }
+
+        /**
+         * @brief Calls visit with each target cell of the Pawn on from: one step, two from its starting row, and captures
+         */
+        template <class Visit>
+        static void forEachPawnMove(const Position& position, const Rules& rules, const int& from, const Visit& visit) {
+            const int side = position.side;
+            const int row = Geometry::rowOf(from);
+            const int col = Geometry::colOf(from);
+            const int step = side == 0 ? 1 : -1;
+            auto empty = [&position] (const int& row, const int& col) { return !position.grid[row][col]; };
+
+            if (Geometry::contains(row + step, col) && empty(row + step, col)) {
+                visit(Geometry::cell(row + step, col));
+                const int start_row = side == 0 ? 1 : Geometry::ROWS - 2;
+                if (rules.double_steps && row == start_row && empty(row + 2 * step, col)) { visit(Geometry::cell(row + 2 * step, col)); }
+            }
+
+            const typename Geometry::Targets& captures = Geometry::PAWN_CAPTURES[side][from];
+            for (int i = 0; i < captures.count; i++) {
+                const int target = captures.cells[i];
+                const char occupant = position.grid[Geometry::rowOf(target)][Geometry::colOf(target)];
+                if ((occupant && sideOf(occupant) != side) || target == position.en_passant) { visit(target); }
+            }
+        }
+};
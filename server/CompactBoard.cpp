@@ -0,0 +1,67 @@
+#include "CompactBoard.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <string>
+
+namespace {
+    const std::string SYMBOLS = " PNBRQK";
+}
+
+/**
+ * @brief Gets the type code of a piece symbol (see ChessPiece::getSymbol()), or EMPTY for an unknown symbol
+ */
+uint8_t CompactBoard::typeCode(const char& symbol) {
+    size_t code = SYMBOLS.find(symbol);
+    return (code == std::string::npos || code == 0) ? EMPTY : static_cast<uint8_t>(code);
+}
+
+/**
+ * @brief Gets the piece symbol of a cell code (ignoring its player), or ' ' for an empty cell
+ */
+char CompactBoard::symbolOf(const uint8_t& code) {
+    size_t type = code & (PLAYER_TWO - 1);
+    return type < SYMBOLS.size() ? SYMBOLS[type] : ' ';
+}
+
+/**
+ * @brief Packs the position on a ChessBoard
+ */
+CompactBoard CompactBoard::fromBoard(const ChessBoard& board) {
+    CompactBoard compact;
+    std::memset(&compact, 0, sizeof(compact));
+    compact.castling_rights = static_cast<uint8_t>(board.getCastlingRights());
+    compact.en_passant_cell = static_cast<int8_t>(board.getEnPassantCell());
+    compact.player_one_turn = board.isPlayerOneTurn();
+
+    const std::string p1_color = board.getPlayerColor(true);
+    for (int cell = 0; cell < CELLS; cell++) {
+        const ChessPiece* piece = board.getCell(GameBoard::rowOf(cell), GameBoard::colOf(cell));
+        if (!piece) { continue; }
+
+        compact.set(cell, static_cast<uint8_t>(typeCode(piece->getSymbol()) | (piece->getColor() == p1_color ? 0 : PLAYER_TWO)));
+    }
+    return compact;
+}
+
+/**
+ * @brief Unpacks the position onto a new ChessBoard (see ChessBoard::fromCells())
+ * @return The board, or nullptr if the position is not a valid one (eg. a player has no King)
+ */
+std::unique_ptr<ChessBoard> CompactBoard::toBoard() const {
+    char symbols[CELLS];
+    for (int cell = 0; cell < CELLS; cell++) {
+        const uint8_t code = get(cell);
+        const char symbol = symbolOf(code);
+        symbols[cell] = symbol == ' ' ? '\0' : ((code & PLAYER_TWO) ? static_cast<char>(std::tolower(symbol)) : symbol);
+    }
+    return ChessBoard::fromCells(symbols, player_one_turn, castling_rights, en_passant_cell);
+}
+
+/**
+ * @brief Gets the standard starting position (see ChessBoard::ChessBoard())
+ */
+const CompactBoard& CompactBoard::start() {
+    static const CompactBoard position = fromBoard(ChessBoard());
+    return position;
+}
@@ -0,0 +1,70 @@
+/**
+ * @struct CompactBoard
+ * @brief A ChessBoard position packed into a small, trivially copyable value, so that thousands of games fit in one slab.
+ *
+ * Each cell (numbered as in GameBoard) takes 4 bits: 0 when empty, otherwise the piece's type code (1 to 6 for P, N, B, R, Q, K)
+ * with PLAYER_TWO set for player two's pieces. The castling rights & en passant cell are kept alongside, so that
+ * toBoard() gives back a ChessBoard that plays exactly like the packed one.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "../ChessBoard.hpp"
+
+struct CompactBoard {
+    static const int CELLS = GameBoard::CELLS;
+    static constexpr uint8_t EMPTY = 0;
+    static const uint8_t PLAYER_TWO = 8;
+
+    uint8_t cells[CELLS / 2];   // Two cells per byte, the lower cell in the low nibble
+    uint8_t castling_rights;    // ChessBoard::CastlingRight flags
+    int8_t en_passant_cell;     // See ChessBoard::getEnPassantCell()
+    bool player_one_turn;
+
+    /**
+     * @brief Gets the code of a cell (see the struct description)
+     */
+    uint8_t get(const int& cell) const {
+        return (cells[cell / 2] >> (4 * (cell % 2))) & 0x0F;
+    }
+
+    /**
+     * @brief Sets the code of a cell (see the struct description)
+     */
+    void set(const int& cell, const uint8_t& code) {
+        cells[cell / 2] = static_cast<uint8_t>((cells[cell / 2] & ~(0x0F << (4 * (cell % 2)))) | (code << (4 * (cell % 2))));
+    }
+
+    bool operator==(const CompactBoard& other) const {
+        return std::memcmp(this, &other, sizeof(CompactBoard)) == 0;
+    }
+
+    /**
+     * @brief Gets the type code of a piece symbol (see ChessPiece::getSymbol()), or EMPTY for an unknown symbol
+     */
+    static uint8_t typeCode(const char& symbol);
+
+    /**
+     * @brief Gets the piece symbol of a cell code (ignoring its player), or ' ' for an empty cell
+     */
+    static char symbolOf(const uint8_t& code);
+
+    /**
+     * @brief Packs the position on a ChessBoard
+     */
+    static CompactBoard fromBoard(const ChessBoard& board);
+
+    /**
+     * @brief Unpacks the position onto a new ChessBoard (see ChessBoard::fromCells())
+     * @return The board, or nullptr if the position is not a valid one (eg. a player has no King)
+     */
+    std::unique_ptr<ChessBoard> toBoard() const;
+
+    /**
+     * @brief Gets the standard starting position (see ChessBoard::ChessBoard())
+     */
+    static const CompactBoard& start();
+};
@@ -0,0 +1,178 @@
+#include "GameServer.hpp"
+
+#include "ScratchBoard.hpp"
+
+/**
+ * @brief Constructs a server and starts its workers
+ * @param capacity The maximum number of concurrent games
+ * @param threads The number of worker threads. 0 uses one per hardware thread.
+ */
+GameServer::GameServer(const int& capacity, const unsigned& threads) :
+    slots_{new GameSlot[capacity > 0 ? capacity : 0]}, capacity_{capacity > 0 ? capacity : 0}, active_games_{0}, stopping_{false} {
+    // Hand out low ids first
+    for (int slot = capacity_ - 1; slot >= 0; slot--) { free_slots_.push_back(slot); }
+
+    unsigned count = threads ? threads : std::thread::hardware_concurrency();
+    if (count == 0) { count = 1; }
+    for (unsigned i = 0; i < count; i++) {
+        workers_.emplace_back(&GameServer::work, this);
+    }
+}
+
+/**
+ * @brief Destructor.
+ * @post Stops the workers once every queued move has been processed
+ */
+GameServer::~GameServer() {
+    {
+        std::lock_guard<std::mutex> guard(queue_lock_);
+        stopping_ = true;
+    }
+    queue_ready_.notify_all();
+    for (std::thread& worker : workers_) { worker.join(); }
+}
+
+/**
+ * @brief Starts a new game from the standard starting position
+ * @return The id of the game, or -1 if the server is full
+ */
+int GameServer::createGame() {
+    int game;
+    {
+        std::lock_guard<std::mutex> guard(free_lock_);
+        if (free_slots_.empty()) { return -1; }
+        game = free_slots_.back();
+        free_slots_.pop_back();
+    }
+
+    GameSlot& slot = slots_[game];
+    std::lock_guard<std::mutex> guard(slot.lock);
+    slot.board = CompactBoard::start();
+    slot.active = true;
+    active_games_++;
+    return game;
+}
+
+/**
+ * @brief Ends a game and frees its slot. Moves still queued for it complete with UNKNOWN_GAME on the calling thread.
+ * @return True if the game existed. False otherwise.
+ */
+bool GameServer::endGame(const int& game) {
+    if (game < 0 || game >= capacity_) { return false; }
+
+    GameSlot& slot = slots_[game];
+    std::deque<Request> dropped;
+    {
+        std::lock_guard<std::mutex> guard(slot.lock);
+        if (!slot.active) { return false; }
+        slot.active = false;
+        // Flush the queue now, so that a game reusing the slot never sees these moves
+        dropped.swap(slot.pending);
+    }
+    active_games_--;
+    for (Request& request : dropped) {
+        if (request.done) { request.done(UNKNOWN_GAME); }
+    }
+
+    std::lock_guard<std::mutex> guard(free_lock_);
+    free_slots_.push_back(game);
+    return true;
+}
+
+/**
+ * @brief Queues a move for a game. done is called from a worker thread once the move has been processed.
+ * @return False (without calling done) if the game does not exist. True otherwise.
+ */
+bool GameServer::submit(const int& game, const Move& move, Callback done) {
+    if (game < 0 || game >= capacity_) { return false; }
+
+    GameSlot& slot = slots_[game];
+    bool needs_schedule = false;
+    {
+        std::lock_guard<std::mutex> guard(slot.lock);
+        if (!slot.active) { return false; }
+        slot.pending.push_back({move, std::move(done)});
+        if (!slot.scheduled) {
+            slot.scheduled = true;
+            needs_schedule = true;
+        }
+    }
+
+    if (needs_schedule) { schedule(game); }
+    return true;
+}
+
+/**
+ * @brief Copies the current position of a game
+ * @return True if the game exists. False otherwise.
+ */
+bool GameServer::snapshot(const int& game, CompactBoard& position) const {
+    if (game < 0 || game >= capacity_) { return false; }
+
+    const GameSlot& slot = slots_[game];
+    std::lock_guard<std::mutex> guard(slot.lock);
+    if (!slot.active) { return false; }
+    position = slot.board;
+    return true;
+}
+
+/**
+ * @brief Gets the number of games currently in progress
+ */
+int GameServer::activeGames() const {
+    return active_games_.load();
+}
+
+/**
+ * @brief Puts a game on the run queue
+ */
+void GameServer::schedule(const int& game) {
+    {
+        std::lock_guard<std::mutex> guard(queue_lock_);
+        run_queue_.push_back(game);
+    }
+    queue_ready_.notify_one();
+}
+
+/**
+ * @brief Worker loop: takes games off the run queue and processes their pending moves
+ */
+void GameServer::work() {
+    ScratchBoard scratch;
+    while (true) {
+        int game;
+        {
+            std::unique_lock<std::mutex> guard(queue_lock_);
+            queue_ready_.wait(guard, [this] { return stopping_ || !run_queue_.empty(); });
+            if (run_queue_.empty()) { return; }     // Only reached when stopping
+            game = run_queue_.front();
+            run_queue_.pop_front();
+        }
+        drain(game, scratch);
+    }
+}
+
+/**
+ * @brief Processes the pending moves of a game until its queue is empty
+ */
+void GameServer::drain(const int& game, ScratchBoard& scratch) {
+    GameSlot& slot = slots_[game];
+    std::unique_lock<std::mutex> guard(slot.lock);
+
+    while (!slot.pending.empty()) {
+        Request request = std::move(slot.pending.front());
+        slot.pending.pop_front();
+
+        MoveStatus status = UNKNOWN_GAME;
+        if (slot.active) {
+            status = scratch.load(slot.board) && scratch.isLegal(request.move) ? ACCEPTED : ILLEGAL;
+            if (status == ACCEPTED) { scratch.play(request.move, slot.board); }
+        }
+
+        // Run the callback unlocked so that it may submit the game's next move
+        guard.unlock();
+        if (request.done) { request.done(status); }
+        guard.lock();
+    }
+    slot.scheduled = false;
+}
@@ -0,0 +1,126 @@
+/**
+ * @class GameServer
+ * @brief Hosts many concurrent games and validates / applies the moves submitted to them on a small pool of worker threads.
+ *
+ * Games live in a fixed-capacity slab of GameSlots, each holding a CompactBoard, so thousands of games take a few
+ * hundred KB and a game id is simply a slot index. Submitted moves are queued on their game; a game with pending moves
+ * is put on a shared run queue, and the worker that takes it drains that game's queue before letting it go. A game is
+ * therefore only ever handled by one worker at a time (moves of a game are applied in submission order), while
+ * different games are processed in parallel, without a thread or a full ChessBoard per game.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CompactBoard.hpp"
+#include "../Move.hpp"
+
+class ScratchBoard;
+
+class GameServer {
+    public:
+        /**
+         * @brief The outcome of a submitted move, passed to its callback
+         */
+        enum MoveStatus {
+            ACCEPTED,       // The move was legal and has been played
+            ILLEGAL,        // The move was rejected, the game is unchanged
+            UNKNOWN_GAME    // The game does not exist (or was ended before the move was processed)
+        };
+
+        using Callback = std::function<void(MoveStatus)>;
+
+        /**
+         * @brief Constructs a server and starts its workers
+         * @param capacity The maximum number of concurrent games
+         * @param threads The number of worker threads. 0 uses one per hardware thread.
+         */
+        GameServer(const int& capacity, const unsigned& threads = 0);
+
+        /**
+         * @brief Destructor.
+         * @post Stops the workers once every queued move has been processed
+         */
+        ~GameServer();
+
+        GameServer(const GameServer&) = delete;
+        GameServer& operator=(const GameServer&) = delete;
+
+        /**
+         * @brief Starts a new game from the standard starting position
+         * @return The id of the game, or -1 if the server is full
+         */
+        int createGame();
+
+        /**
+         * @brief Ends a game and frees its slot. Moves still queued for it complete with UNKNOWN_GAME on the calling thread.
+         * @return True if the game existed. False otherwise.
+         */
+        bool endGame(const int& game);
+
+        /**
+         * @brief Queues a move for a game. done is called from a worker thread once the move has been processed.
+         * @return False (without calling done) if the game does not exist. True otherwise.
+         */
+        bool submit(const int& game, const Move& move, Callback done);
+
+        /**
+         * @brief Copies the current position of a game
+         * @return True if the game exists. False otherwise.
+         */
+        bool snapshot(const int& game, CompactBoard& position) const;
+
+        /**
+         * @brief Gets the number of games currently in progress
+         */
+        int activeGames() const;
+
+    private:
+        struct Request {
+            Move move;
+            Callback done;
+        };
+
+        struct GameSlot {
+            mutable std::mutex lock;
+            CompactBoard board;
+            std::deque<Request> pending;
+            bool active = false;
+            bool scheduled = false;     // The game is on the run queue or being drained by a worker
+        };
+
+        std::unique_ptr<GameSlot[]> slots_;
+        int capacity_;
+        std::vector<int> free_slots_;
+        std::mutex free_lock_;
+        std::atomic<int> active_games_;
+
+        std::deque<int> run_queue_;     // Games with pending moves
+        std::mutex queue_lock_;
+        std::condition_variable queue_ready_;
+        bool stopping_;
+
+        std::vector<std::thread> workers_;
+
+        /**
+         * @brief Puts a game on the run queue
+         */
+        void schedule(const int& game);
+
+        /**
+         * @brief Worker loop: takes games off the run queue and processes their pending moves
+         */
+        void work();
+
+        /**
+         * @brief Processes the pending moves of a game until its queue is empty
+         */
+        void drain(const int& game, ScratchBoard& scratch);
+};
@@ -0,0 +1,168 @@
+#include "LoadGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "ScratchBoard.hpp"
+#include "../Notation.hpp"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Both castlings, a capture en passant (e5f6) and a promotion to a Knight (g7h8n)
+    const std::vector<std::string> SCRIPTED_GAME = {
+        "e2e4", "d7d5", "e4e5", "f7f5", "e5f6", "b8c6", "f6g7", "c8e6", "g1f3", "d8d7",
+        "f1e2", "e8c8", "e1g1", "a7a6", "g7h8n", "d7d6", "h8f7", "e6f7", "d2d4", "c6d4"
+    };
+
+    // Completions handed from the server's workers back to a client thread
+    struct Mailbox {
+        std::mutex lock;
+        std::condition_variable ready;
+        std::deque<std::pair<int, GameServer::MoveStatus>> done;    // (local game index, status)
+        std::vector<double> latencies;                              // Microseconds
+    };
+
+    struct ClientGame {
+        int id = -1;
+        int plies = 0;
+    };
+}
+
+LoadGenerator::LoadGenerator(GameServer& server, const Options& options) : server_{server}, options_{options} {}
+
+/**
+ * @brief Runs the clients until Options::moves moves have been processed
+ */
+LoadGenerator::Report LoadGenerator::run() {
+    const int clients = std::max(1, options_.clients);
+    const long long quota = std::max(1LL, options_.moves / clients);
+
+    std::vector<Mailbox> mailboxes(clients);
+    std::vector<long long> rejected(clients, 0);
+    std::vector<std::thread> threads;
+
+    std::vector<Move> script;
+    for (const std::string& text : SCRIPTED_GAME) {
+        Move move;
+        if (Notation::parseMove(text, move)) { script.push_back(move); }
+    }
+    const int max_plies = options_.scripted ? static_cast<int>(script.size()) : options_.max_plies;
+
+    const Clock::time_point start = Clock::now();
+    for (int c = 0; c < clients; c++) {
+        threads.emplace_back([this, c, quota, max_plies, &script, &mailboxes, &rejected] {
+            Mailbox& mailbox = mailboxes[c];
+            std::mt19937_64 random(options_.seed + c);
+            ScratchBoard scratch;
+            MoveList moves;
+            std::vector<ClientGame> games(options_.games_per_client);
+            long long submitted = 0;
+            long long completed = 0;
+
+            // Picks & submits the next move of a game, starting a new game whenever the current one is over
+            auto advance = [&] (const int& local) {
+                ClientGame& game = games[local];
+                for (int attempt = 0; attempt < 2; attempt++) {
+                    CompactBoard position;
+                    if (game.id < 0 || game.plies >= max_plies || !server_.snapshot(game.id, position)) {
+                        if (game.id >= 0) { server_.endGame(game.id); }
+                        game.id = server_.createGame();
+                        game.plies = 0;
+                        if (game.id < 0 || !server_.snapshot(game.id, position)) { return false; }
+                    }
+
+                    moves.clear();
+                    if (options_.scripted) {
+                        moves.push_back(script[game.plies]);
+                    } else if (scratch.load(position)) {
+                        scratch.legalMoves(moves);
+                    }
+                    if (moves.empty()) {
+                        game.plies = max_plies;
+                        continue;
+                    }
+
+                    const Move move = moves[random() % moves.size()];
+                    const Clock::time_point sent = Clock::now();
+                    return server_.submit(game.id, move, [&mailbox, local, sent] (GameServer::MoveStatus status) {
+                        const double micros = std::chrono::duration<double, std::micro>(Clock::now() - sent).count();
+                        {
+                            std::lock_guard<std::mutex> guard(mailbox.lock);
+                            mailbox.done.emplace_back(local, status);
+                            mailbox.latencies.push_back(micros);
+                        }
+                        mailbox.ready.notify_one();
+                    });
+                }
+                return false;
+            };
+
+            for (int local = 0; local < static_cast<int>(games.size()) && submitted < quota; local++) {
+                if (advance(local)) { submitted++; }
+            }
+
+            while (completed < submitted) {
+                std::deque<std::pair<int, GameServer::MoveStatus>> done;
+                {
+                    std::unique_lock<std::mutex> guard(mailbox.lock);
+                    mailbox.ready.wait(guard, [&mailbox] { return !mailbox.done.empty(); });
+                    done.swap(mailbox.done);
+                }
+
+                for (const auto& completion : done) {
+                    completed++;
+                    ClientGame& game = games[completion.first];
+                    if (completion.second == GameServer::ACCEPTED) {
+                        game.plies++;
+                    } else {
+                        rejected[c]++;
+                        if (options_.scripted) { game.plies = max_plies; }
+                    }
+                    if (submitted < quota && advance(completion.first)) { submitted++; }
+                }
+            }
+
+            for (const ClientGame& game : games) {
+                if (game.id >= 0) { server_.endGame(game.id); }
+            }
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    long long total_rejected = 0;
+    for (int c = 0; c < clients; c++) {
+        latencies.insert(latencies.end(), mailboxes[c].latencies.begin(), mailboxes[c].latencies.end());
+        total_rejected += rejected[c];
+    }
+
+    Report report{static_cast<long long>(latencies.size()), total_rejected, seconds, 0, 0, 0};
+    if (!latencies.empty()) {
+        auto percentile = [&latencies] (const double& fraction) {
+            size_t rank = std::min(latencies.size() - 1, static_cast<size_t>(fraction * latencies.size()));
+            std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+            return latencies[rank];
+        };
+        report.p50_us = percentile(0.50);
+        report.p99_us = percentile(0.99);
+        report.max_us = *std::max_element(latencies.begin(), latencies.end());
+    }
+    return report;
+}
+
+/**
+ * @brief Prints a report as a single line of "key value" pairs
+ */
+void LoadGenerator::print(const Report& report, std::ostream& out) {
+    const double rate = report.seconds > 0 ? report.moves / report.seconds : 0;
+    out << "moves " << report.moves << " rejected " << report.rejected << " seconds " << report.seconds
+        << " moves/s " << static_cast<long long>(rate) << " p50_us " << report.p50_us << " p99_us " << report.p99_us
+        << " max_us " << report.max_us << std::endl;
+}
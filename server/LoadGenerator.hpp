@@ -0,0 +1,54 @@
+/**
+ * @class LoadGenerator
+ * @brief Drives a GameServer with simulated clients and measures how long submitted moves take to be processed.
+ *
+ * Each client thread keeps a set of games in flight: whenever one of its moves completes, it picks a random legal move
+ * for that game and submits it again, restarting games that end (no legal move, or too long). The latency of a move is
+ * the time from submit() to its callback.
+ *
+ * In the scripted scenario, every game replays a fixed game that castles on both wings, captures en passant and promotes
+ * (to a Knight), restarting once it is over or as soon as one of its moves is rejected.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include "GameServer.hpp"
+
+class LoadGenerator {
+    public:
+        struct Options {
+            int clients = 4;                // Client threads
+            int games_per_client = 256;     // Games each client keeps in flight
+            long long moves = 200000;       // Total moves to submit across all clients
+            int max_plies = 200;            // Games are restarted after this many plies
+            uint64_t seed = 1;
+            bool scripted = false;          // Replay the scripted game instead of random moves
+        };
+
+        struct Report {
+            long long moves;        // Moves processed
+            long long rejected;     // Moves that did not complete with ACCEPTED
+            double seconds;
+            double p50_us;          // Median latency, in microseconds
+            double p99_us;
+            double max_us;
+        };
+
+        LoadGenerator(GameServer& server, const Options& options);
+
+        /**
+         * @brief Runs the clients until Options::moves moves have been processed
+         */
+        Report run();
+
+        /**
+         * @brief Prints a report as a single line of "key value" pairs
+         */
+        static void print(const Report& report, std::ostream& out);
+
+    private:
+        GameServer& server_;
+        Options options_;
+};
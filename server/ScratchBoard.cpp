@@ -0,0 +1,46 @@
+#include "ScratchBoard.hpp"
+
+ScratchBoard::ScratchBoard() : loaded_{} {}
+
+/**
+ * @brief Sets up a position, replacing the previous one. Nothing is unpacked if the position is already loaded.
+ * @return False if the position is not a valid board (eg. a player has no King), in which case no move is legal
+ */
+bool ScratchBoard::load(const CompactBoard& position) {
+    if (board_ && position == loaded_) { return true; }
+
+    board_ = position.toBoard();
+    loaded_ = position;
+    return board_ != nullptr;
+}
+
+/**
+ * @brief Determines if a move is one of the legal moves of the loaded position. A promotion must name its piece.
+ */
+bool ScratchBoard::isLegal(const Move& move) {
+    if (!board_ || !board_->isPseudoLegal(move) || board_->castlesThroughCheck(move)) { return false; }
+
+    const bool mover = board_->isPlayerOneTurn();
+    MoveUndo undo;
+    board_->makeMove(move, undo);
+    const bool legal = !board_->isInCheck(mover);
+    board_->unmakeMove(move, undo);
+    return legal;
+}
+
+/**
+ * @brief Appends every legal move of the loaded position
+ */
+void ScratchBoard::legalMoves(MoveList& moves) {
+    if (board_) { board_->generateLegalMoves(moves); }
+}
+
+/**
+ * @brief Plays a move on the loaded position, which becomes the new one, and packs the result into position
+ * @pre The move is legal in the loaded position (see isLegal())
+ */
+void ScratchBoard::play(const Move& move, CompactBoard& position) {
+    board_->move(move);
+    position = CompactBoard::fromBoard(*board_);
+    loaded_ = position;
+}
@@ -0,0 +1,47 @@
+/**
+ * @class ScratchBoard
+ * @brief A ChessBoard that a CompactBoard is unpacked onto, so that the moves of packed games are checked & played by
+ *     ChessBoard's own rules (castling, en passant & promotions included).
+ *
+ * Each worker keeps one, and the board it holds is reused as long as it can be: loading the position it already holds
+ * (typically the one its last play() packed, when the same game's next move comes in) unpacks nothing. A move is checked
+ * by playing it out & taking it back, so no list of legal moves is generated unless legalMoves() asks for one.
+ */
+
+#pragma once
+
+#include <memory>
+#include "CompactBoard.hpp"
+#include "../Move.hpp"
+#include "../MoveList.hpp"
+
+class ScratchBoard {
+    public:
+        ScratchBoard();
+
+        /**
+         * @brief Sets up a position, replacing the previous one. Nothing is unpacked if the position is already loaded.
+         * @return False if the position is not a valid board (eg. a player has no King), in which case no move is legal
+         */
+        bool load(const CompactBoard& position);
+
+        /**
+         * @brief Determines if a move is one of the legal moves of the loaded position. A promotion must name its piece.
+         */
+        bool isLegal(const Move& move);
+
+        /**
+         * @brief Appends every legal move of the loaded position
+         */
+        void legalMoves(MoveList& moves);
+
+        /**
+         * @brief Plays a move on the loaded position, which becomes the new one, and packs the result into position
+         * @pre The move is legal in the loaded position (see isLegal())
+         */
+        void play(const Move& move, CompactBoard& position);
+
+    private:
+        std::unique_ptr<ChessBoard> board_;     // Null when the loaded position is not a valid board
+        CompactBoard loaded_;                   // The position on board_, while there is one
+};
@@ -0,0 +1,164 @@
+#include "Tablebase.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+namespace {
+    // Orders results for the side they belong to: quick wins first, then draws, then slow losses
+    int preference(const Tablebase::Result& result) {
+        if (result.outcome == Tablebase::Result::WIN) { return 1000 - result.plies; }
+        if (result.outcome == Tablebase::Result::LOSS) { return result.plies - 1000; }
+        return 0;
+    }
+
+    // Turns the result of the position after a move into the result of the move for the player who made it
+    Tablebase::Result afterMove(const Tablebase::Result& child) {
+        if (child.outcome == Tablebase::Result::WIN) { return {Tablebase::Result::LOSS, child.plies + 1}; }
+        if (child.outcome == Tablebase::Result::LOSS) { return {Tablebase::Result::WIN, child.plies + 1}; }
+        return child;
+    }
+}
+
+Tablebase::Tablebase() {}
+
+/**
+ * @brief Destructor.
+ * @post Unmaps every loaded table
+ */
+Tablebase::~Tablebase() {}
+
+/**
+ * @brief Memory-maps a single table file
+ * @return True if the file exists, is a valid table and was mapped. False otherwise.
+ */
+bool Tablebase::load(const std::string& path) {
+    // Probes jump around the whole table, so read-ahead only wastes I/O
+    MappedFile file;
+    if (!file.open(path, sizeof(TablebaseHeader), MappedFile::RANDOM)) { return false; }
+
+    TablebaseHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    std::string signature(header.signature, strnlen(header.signature, sizeof(header.signature)));
+
+    bool valid = std::memcmp(header.magic, "P4TB", 4) == 0 && header.version == VERSION &&
+        TablebaseIndex::isValidSignature(signature) && header.piece_count == signature.size() &&
+        header.entries == TablebaseIndex(signature).size() &&
+        file.size() >= sizeof(TablebaseHeader) + header.entries;
+
+    const uint32_t key = TablebaseIndex::signatureKey(signature);
+    if (!valid || tables_.count(key)) { return false; }
+
+    const uint8_t* data = file.data() + sizeof(TablebaseHeader);
+    tables_.emplace(key, MappedTable{TablebaseIndex(signature), data, std::move(file)});
+    return true;
+}
+
+/**
+ * @brief Loads every "*.p4tb" file in a directory
+ * @return The number of tables that were loaded
+ */
+int Tablebase::loadDirectory(const std::string& directory) {
+    std::error_code error;
+    int loaded = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ".p4tb" && load(entry.path().string())) { loaded++; }
+    }
+    return loaded;
+}
+
+/**
+ * @brief Determines if a table is loaded for the given canonical signature
+ */
+bool Tablebase::has(const std::string& signature) const {
+    return tables_.count(TablebaseIndex::signatureKey(signature)) > 0;
+}
+
+/**
+ * @brief Looks up the position on the board, including any capture en passant the player to move has.
+ * @return The outcome for the player whose turn it is, or UNKNOWN if no table covers the material on the board or
+ *     a castling right is left (table positions have none)
+ */
+Tablebase::Result Tablebase::probe(const ChessBoard& board) const {
+    if (board.getCastlingRights() != 0) { return {Result::UNKNOWN, 0}; }
+
+    std::vector<TablebasePiece> pieces;
+    const std::string p1_color = board.getPlayerColor(true);
+
+    for (int row = 0; row < TablebaseIndex::Geometry::ROWS; row++) {
+        for (int col = 0; col < TablebaseIndex::Geometry::COLS; col++) {
+            const ChessPiece* piece = board.getCell(row, col);
+            if (!piece) { continue; }
+            if (static_cast<int>(pieces.size()) == TablebaseIndex::MAX_PIECES) { return {Result::UNKNOWN, 0}; }
+
+            // Player one's pieces move UP the board, so they are side 0
+            pieces.push_back({piece->getColor() == p1_color ? 0 : 1, piece->getSymbol(), TablebaseIndex::Geometry::cell(row, col)});
+        }
+    }
+
+    Result result = probe(pieces, board.isPlayerOneTurn() ? 0 : 1);
+    const int en_passant_cell = board.getEnPassantCell();
+    if (en_passant_cell < 0 || result.outcome == Result::UNKNOWN) { return result; }
+
+    // The table holds the position without the en passant right, so each capture en passant is probed on its own
+    ChessBoard copy(board);
+    MoveList moves;
+    copy.generateLegalMoves(moves);
+
+    bool other_moves = false, captures = false;
+    Result best = result;
+    for (const Move& move : moves) {
+        bool en_passant = move.to() == en_passant_cell && move.col() != move.targetCol() &&
+            copy.getCell(move.row(), move.col())->getSymbol() == 'P';
+        if (!en_passant) {
+            other_moves = true;
+            continue;
+        }
+
+        MoveUndo undo;
+        copy.makeMove(move, undo);
+        Result capture = probe(copy);
+        copy.unmakeMove(move, undo);
+        if (capture.outcome == Result::UNKNOWN) { return capture; }
+
+        capture = afterMove(capture);
+        if (!captures || preference(capture) > preference(best)) { best = capture; }
+        captures = true;
+    }
+
+    // Without any other legal move, the table's mate or stalemate doesn't apply
+    if (captures && other_moves && preference(result) > preference(best)) { return result; }
+    return best;
+}
+
+/**
+ * @brief Looks up a position given as a list of pieces (side 0 moving UP the board) and the side to move,
+ *     without any en passant right.
+ * @return The outcome for the side to move, or UNKNOWN if no table covers the material
+ */
+Tablebase::Result Tablebase::probe(std::vector<TablebasePiece> pieces, int stm) const {
+    // Each side needs exactly one King for the position to belong to any table
+    int kings[2] = {0, 0};
+    for (const TablebasePiece& piece : pieces) {
+        if (piece.type == 'K') { kings[piece.side]++; }
+    }
+    if (kings[0] != 1 || kings[1] != 1) { return {Result::UNKNOWN, 0}; }
+
+    std::string signature = TablebaseIndex::canonicalize(pieces, stm);
+    if (TablebaseIndex::isTrivialDraw(signature)) { return {Result::DRAW, 0}; }
+
+    auto table = tables_.find(TablebaseIndex::signatureKey(signature));
+    if (table == tables_.end()) { return {Result::UNKNOWN, 0}; }
+
+    int squares[TablebaseIndex::MAX_PIECES];
+    for (size_t i = 0; i < pieces.size(); i++) { squares[i] = pieces[i].square; }
+
+    uint8_t value = table->second.data[table->second.index.encode(squares, stm)];
+    if (value == TablebaseIndex::INVALID) { return {Result::UNKNOWN, 0}; }
+
+    int plies = 0;
+    int outcome = TablebaseIndex::decodeValue(value, plies);
+    if (outcome > 0) { return {Result::WIN, plies}; }
+    if (outcome < 0) { return {Result::LOSS, plies}; }
+    return {Result::DRAW, 0};
+}
@@ -0,0 +1,97 @@
+/**
+ * @class Tablebase
+ * @brief Probes endgame tablebases written by TablebaseGenerator.
+ *
+ * Each table lives in its own "<SIGNATURE>.p4tb" file: a fixed-size TablebaseHeader followed by one byte per position,
+ * laid out exactly as TablebaseIndex numbers them. Files are memory-mapped, so loading costs no parsing and a probe
+ * is a single byte read once the position has been indexed.
+ *
+ * Table positions carry no en passant right, so probing a board that has one also probes each capture en passant. They
+ * carry no castling rights either, so a board that still has one is never probed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TablebaseIndex.hpp"
+#include "../ChessBoard.hpp"
+#include "../MappedFile.hpp"
+
+/**
+ * @brief On-disk header of a table file
+ */
+struct TablebaseHeader {
+    char magic[8];          // "P4TB" followed by zeros
+    uint32_t version;       // Currently 1
+    uint32_t piece_count;   // Number of slots in the signature
+    char signature[8];      // The canonical signature, zero-padded
+    uint64_t entries;       // Number of positions (bytes) following the header
+};
+
+class Tablebase {
+    public:
+        static const uint32_t VERSION = 1;
+
+        /**
+         * @brief The answer to a probe, from the side to move's perspective
+         */
+        struct Result {
+            enum Outcome { WIN, DRAW, LOSS, UNKNOWN };
+            Outcome outcome;
+            int plies;      // Distance to mate in plies (0 for a draw, or when the side to move is already mated)
+        };
+
+        Tablebase();
+
+        /**
+         * @brief Destructor.
+         * @post Unmaps every loaded table
+         */
+        ~Tablebase();
+
+        Tablebase(const Tablebase&) = delete;
+        Tablebase& operator=(const Tablebase&) = delete;
+
+        /**
+         * @brief Memory-maps a single table file
+         * @return True if the file exists, is a valid table and was mapped. False otherwise.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Loads every "*.p4tb" file in a directory
+         * @return The number of tables that were loaded
+         */
+        int loadDirectory(const std::string& directory);
+
+        /**
+         * @brief Determines if a table is loaded for the given canonical signature
+         */
+        bool has(const std::string& signature) const;
+
+        /**
+         * @brief Looks up the position on the board, including any capture en passant the player to move has.
+         * @return The outcome for the player whose turn it is, or UNKNOWN if no table covers the material on the board or
+         *     a castling right is left (table positions have none)
+         */
+        Result probe(const ChessBoard& board) const;
+
+        /**
+         * @brief Looks up a position given as a list of pieces (side 0 moving UP the board) and the side to move,
+         *     without any en passant right.
+         * @return The outcome for the side to move, or UNKNOWN if no table covers the material
+         */
+        Result probe(std::vector<TablebasePiece> pieces, int stm) const;
+
+    private:
+        struct MappedTable {
+            TablebaseIndex index;
+            const uint8_t* data;    // First position byte (just past the header)
+            MappedFile file;
+        };
+
+        std::unordered_map<uint32_t, MappedTable> tables_; // By TablebaseIndex::signatureKey()
+};
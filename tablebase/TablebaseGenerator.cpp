@@ -0,0 +1,606 @@
+#include "TablebaseGenerator.hpp"
+#include "Tablebase.hpp"
+#include "../pieces_module.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace {
+    using Geometry = TablebaseIndex::Geometry;
+    const int MAX_PLY = 126;            // Deepest mate representable by the value encoding
+    const uint8_t COUNT_MASK = 0x7F;    // Low bits of a counter: in-table moves not yet known to lose
+    const uint8_t SAFE_EXIT = 0x80;     // High bit of a counter: some move leaves the table into a draw or a win
+    const int MAX_PASSES = 4;           // Passes run for tables with pawns on both sides, at most 2 double steps deep in en passant
+
+    /**
+     * @brief A position waiting to be resolved with the given value, once the analysis reaches its ply
+     */
+    struct Candidate {
+        uint32_t index;
+        uint8_t value;
+    };
+
+    // Pawns of side 0 move UP the board, mirroring player one on ChessBoard
+    int pawnDirection(const int& side) { return side == 0 ? 1 : -1; }
+    int pawnStartRow(const int& side) { return side == 0 ? 1 : Geometry::ROWS - 2; }
+    int promotionRow(const int& side) { return side == 0 ? Geometry::ROWS - 1 : 0; }
+
+    // Orders outcomes (as decoded by TablebaseIndex::decodeValue) for the side they belong to: quick wins first, then draws, then slow losses
+    int preference(const int& outcome, const int& plies) {
+        if (outcome > 0) { return 2 * MAX_PLY - plies; }
+        if (outcome < 0) { return plies - 2 * MAX_PLY; }
+        return 0;
+    }
+
+    ChessPiece* makePiece(const char& type, const int& side) {
+        const std::string color = side == 0 ? "BLACK" : "WHITE";
+        const bool moving_up = side == 0;
+        switch (type) {
+            case 'K': return new King(color, -1, -1, moving_up);
+            case 'Q': return new Queen(color, -1, -1, moving_up);
+            case 'R': return new Rook(color, -1, -1, moving_up);
+            case 'B': return new Bishop(color, -1, -1, moving_up);
+            case 'N': return new Knight(color, -1, -1, moving_up);
+            default: return new Pawn(color, -1, -1, moving_up);
+        }
+    }
+
+    /**
+     * @brief Appends the cells a piece of the given type could have come from to reach square (ie. the targets of an un-move).
+     *     Sliding rays stop before the first occupied cell, and pawns step backwards without capturing.
+     *     These are only candidates: every one of them is confirmed with canMove before it is used.
+     */
+    void originCells(const char& type, const int& side, const int& square,
+        const std::vector<std::vector<ChessPiece*>>& grid, std::vector<int>& cells) {
+        const int row = Geometry::rowOf(square);
+        const int col = Geometry::colOf(square);
+
+        auto add_ray = [&] (const int& d_row, const int& d_col) {
+            for (int r = row + d_row, c = col + d_col; Geometry::contains(r, c) && !grid[r][c]; r += d_row, c += d_col) {
+                cells.push_back(Geometry::cell(r, c));
+            }
+        };
+        auto add_cell = [&] (const int& r, const int& c) {
+            if (Geometry::contains(r, c) && !grid[r][c]) { cells.push_back(Geometry::cell(r, c)); }
+        };
+
+        if (type == 'R' || type == 'Q') {
+            add_ray(1, 0); add_ray(-1, 0); add_ray(0, 1); add_ray(0, -1);
+        }
+        if (type == 'B' || type == 'Q') {
+            add_ray(1, 1); add_ray(1, -1); add_ray(-1, 1); add_ray(-1, -1);
+        }
+        if (type == 'N') {
+            const int jumps[8][2] = { {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2} };
+            for (const auto& jump : jumps) { add_cell(row + jump[0], col + jump[1]); }
+        }
+        if (type == 'K') {
+            for (int d_row = -1; d_row <= 1; d_row++) {
+                for (int d_col = -1; d_col <= 1; d_col++) {
+                    if (d_row || d_col) { add_cell(row + d_row, col + d_col); }
+                }
+            }
+        }
+        if (type == 'P') {
+            const int direction = -pawnDirection(side);
+            add_cell(row + direction, col);
+            if (Geometry::contains(row + direction, col) && !grid[row + direction][col]) { add_cell(row + 2 * direction, col); }
+        }
+    }
+}
+
+/**
+ * @brief A board of raw ChessPiece pointers that positions of one table are set up on, one per worker thread.
+ *     Pawns get two objects per slot, so that only a pawn still on its starting row is allowed to double jump.
+ */
+struct TablebaseGenerator::Scratch {
+    const TablebaseIndex& index;
+    std::vector<std::vector<ChessPiece*>> grid;
+    std::vector<std::unique_ptr<ChessPiece>> fresh;
+    std::vector<std::unique_ptr<ChessPiece>> moved;
+    std::vector<ChessPiece*> placed;
+    std::vector<int> squares;
+
+    Scratch(const TablebaseIndex& table_index) : index{table_index},
+        grid(Geometry::ROWS, std::vector<ChessPiece*>(Geometry::COLS)), placed(table_index.getSlots().size()), squares(placed.size()) {
+        for (const TablebasePiece& slot : index.getSlots()) {
+            fresh.emplace_back(makePiece(slot.type, slot.side));
+            moved.emplace_back(makePiece(slot.type, slot.side));
+            moved.back()->flagMoved();
+        }
+    }
+
+    // The object standing for slot while on square
+    ChessPiece* pieceFor(const size_t& slot, const int& square) const {
+        const TablebasePiece& info = index.getSlots()[slot];
+        bool on_start_row = info.type == 'P' && Geometry::rowOf(square) == pawnStartRow(info.side);
+        return on_start_row ? fresh[slot].get() : moved[slot].get();
+    }
+
+    void put(const size_t& slot, const int& square) {
+        if (placed[slot] && grid[Geometry::rowOf(squares[slot])][Geometry::colOf(squares[slot])] == placed[slot]) {
+            grid[Geometry::rowOf(squares[slot])][Geometry::colOf(squares[slot])] = nullptr;
+        }
+        ChessPiece* piece = pieceFor(slot, square);
+        piece->setRow(Geometry::rowOf(square));
+        piece->setColumn(Geometry::colOf(square));
+        grid[Geometry::rowOf(square)][Geometry::colOf(square)] = piece;
+        placed[slot] = piece;
+        squares[slot] = square;
+    }
+
+    // Sets up a whole position. Returns false if two slots share a square.
+    bool setup(const int position[]) {
+        for (auto& row : grid) { std::fill(row.begin(), row.end(), nullptr); }
+        std::fill(placed.begin(), placed.end(), nullptr);
+        for (size_t slot = 0; slot < placed.size(); slot++) {
+            if (grid[Geometry::rowOf(position[slot])][Geometry::colOf(position[slot])]) { return false; }
+            put(slot, position[slot]);
+        }
+        return true;
+    }
+
+    // Determines if any piece of by_side that is still on the board can move onto square
+    bool attacked(const int& square, const int& by_side) const {
+        for (size_t slot = 0; slot < placed.size(); slot++) {
+            if (!placed[slot] || index.getSlots()[slot].side != by_side) { continue; }
+            if (placed[slot]->canMove(Geometry::rowOf(square), Geometry::colOf(square), grid)) { return true; }
+        }
+        return false;
+    }
+
+    // Gets the slot of the piece on square, or -1 if it is empty
+    int slotAt(const int& square) const {
+        for (size_t slot = 0; slot < placed.size(); slot++) {
+            if (placed[slot] && squares[slot] == square) { return static_cast<int>(slot); }
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief Constructs a generator that writes its tables into directory
+ * @param directory The directory table files are read from & written to
+ * @param threads The number of worker threads. 0 uses one per hardware thread.
+ */
+TablebaseGenerator::TablebaseGenerator(const std::string& directory, const unsigned& threads) :
+    directory_{directory}, threads_{threads ? threads : std::max(1u, std::thread::hardware_concurrency())} {}
+
+/**
+ * @brief Generates the table for a signature, along with any smaller table it depends on, and writes them as "<SIGNATURE>.p4tb"
+ * @param signature A canonical signature with at most TablebaseIndex::MAX_PIECES pieces (eg. "KRK")
+ * @return True if every table could be generated & written. False otherwise (eg. invalid signature, unwritable directory).
+ */
+bool TablebaseGenerator::generate(const std::string& signature) {
+    if (!TablebaseIndex::isValidSignature(signature)) { return false; }
+    return ensure(signature);
+}
+
+/**
+ * @brief Makes sure the table for signature is in tables_, loading it from directory_ or generating it otherwise
+ */
+bool TablebaseGenerator::ensure(const std::string& signature) {
+    const uint32_t key = TablebaseIndex::signatureKey(signature);
+    if (tables_.count(key) || TablebaseIndex::isTrivialDraw(signature)) { return true; }
+
+    TablebaseIndex index(signature);
+    std::vector<uint8_t> values;
+    if (read(index, values)) {
+        tables_.emplace(key, Table{std::move(index), std::move(values)});
+        return true;
+    }
+
+    // Every capture of a non-King piece, and every promotion of a pawn, leads into a smaller table
+    const std::vector<TablebasePiece>& slots = index.getSlots();
+    for (size_t removed = 0; removed < slots.size(); removed++) {
+        for (const char& promotion : std::string("-QRBN")) {
+            if (promotion == '-' ? slots[removed].type == 'K' : slots[removed].type != 'P') { continue; }
+
+            std::vector<TablebasePiece> pieces;
+            for (size_t slot = 0; slot < slots.size(); slot++) {
+                if (slot != removed) { pieces.push_back({slots[slot].side, slots[slot].type, static_cast<int>(slot)}); }
+                else if (promotion != '-') { pieces.push_back({slots[slot].side, promotion, static_cast<int>(slot)}); }
+            }
+            int stm = 0;
+            if (!ensure(TablebaseIndex::canonicalize(pieces, stm))) { return false; }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    values = build(index);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t wins = 0, losses = 0, draws = 0;
+    int longest = 0;
+    for (const uint8_t& value : values) {
+        int plies = 0;
+        int outcome = TablebaseIndex::decodeValue(value, plies);
+        if (outcome > 0) { wins++; }
+        if (outcome < 0) { losses++; }
+        if (outcome == 0 && value != TablebaseIndex::INVALID) { draws++; }
+        longest = std::max(longest, plies);
+    }
+    std::cout << signature << ": " << values.size() << " positions, " << wins << " wins, " << draws << " draws, "
+        << losses << " losses, longest mate " << longest << " plies (" << seconds << "s)" << std::endl;
+
+    if (!write(index, values)) { return false; }
+    tables_.emplace(key, Table{std::move(index), std::move(values)});
+    return true;
+}
+
+/**
+ * @brief Runs the retrograde analysis for a single signature whose dependencies are already in tables_
+ */
+std::vector<uint8_t> TablebaseGenerator::build(const TablebaseIndex& index) const {
+    std::vector<uint8_t> stuck(index.size(), 0);
+    std::vector<uint8_t> values = resolve(index, {}, stuck);
+
+    // Captures en passant need a Pawn on each side
+    bool pawns[2] = {false, false};
+    for (const TablebasePiece& slot : index.getSlots()) {
+        if (slot.type == 'P') { pawns[slot.side] = true; }
+    }
+    if (!pawns[0] || !pawns[1]) { return values; }
+
+    for (int pass = 1; pass < MAX_PASSES; pass++) {
+        std::vector<uint8_t> next = resolve(index, values, stuck);
+        if (next == values) { break; }
+        values.swap(next);
+    }
+    return values;
+}
+
+/**
+ * @brief Runs one pass of the retrograde analysis
+ * @param previous The values found by the previous pass, used to resolve double steps that allow a capture en passant.
+ *     Empty on the first pass, which treats those double steps as ordinary in-table moves.
+ * @param stuck Filled by the first pass with 1 for every position without a legal move, and read by the later ones
+ */
+std::vector<uint8_t> TablebaseGenerator::resolve(const TablebaseIndex& index, const std::vector<uint8_t>& previous,
+    std::vector<uint8_t>& stuck) const {
+    const uint64_t size = index.size();
+    const std::vector<TablebasePiece>& slots = index.getSlots();
+    const size_t piece_count = slots.size();
+
+    std::vector<uint8_t> values(size, TablebaseIndex::DRAW);
+    std::vector<uint8_t> resolved(size, 0);
+    std::vector<uint8_t> exit_loss(size, 0);     // Longest mate the side to move suffers by leaving the table
+    std::unique_ptr<std::atomic<uint8_t>[]> counters(new std::atomic<uint8_t>[size]);
+    std::vector<std::vector<Candidate>> buckets(MAX_PLY + 2);
+
+    // Runs work(thread, begin, end) over [0, count) split evenly across the worker threads
+    auto parallel_for = [this] (const uint64_t& count, auto work) {
+        std::vector<std::thread> workers;
+        uint64_t chunk = (count + threads_ - 1) / threads_;
+        for (unsigned t = 0; t < threads_; t++) {
+            uint64_t begin = std::min(count, t * chunk);
+            uint64_t end = std::min(count, begin + chunk);
+            workers.emplace_back(work, t, begin, end);
+        }
+        for (std::thread& worker : workers) { worker.join(); }
+    };
+
+    // Phase 1: generate the moves of every position
+    std::vector<std::vector<std::pair<int, Candidate>>> found(threads_);
+    parallel_for(size, [&] (const unsigned& thread, const uint64_t& begin, const uint64_t& end) {
+        Scratch scratch(index);
+        int squares[TablebaseIndex::MAX_PIECES];
+
+        for (uint64_t position = begin; position < end; position++) {
+            int stm = 0;
+            index.decode(position, squares, stm);
+            counters[position].store(0, std::memory_order_relaxed);
+
+            bool valid = scratch.setup(squares);
+            for (size_t slot = 0; valid && slot < piece_count; slot++) {
+                valid = slots[slot].type != 'P' || (Geometry::rowOf(squares[slot]) != 0 && Geometry::rowOf(squares[slot]) != Geometry::ROWS - 1);
+            }
+            // The side that just moved can't have left its King in check (slot 0 & 1 are the Kings)
+            if (!valid || scratch.attacked(squares[1 - stm], stm)) {
+                values[position] = TablebaseIndex::INVALID;
+                resolved[position] = 1;
+                continue;
+            }
+
+            int legal_moves = 0, in_table = 0, best_exit_win = MAX_PLY + 1, longest_exit_loss = 0;
+            bool draw_exit = false;
+
+            // Records a move leaving the table, given the outcome for the opponent
+            auto add_exit = [&] (const int& outcome, const int& plies) {
+                if (outcome < 0) { best_exit_win = std::min(best_exit_win, plies + 1); }
+                if (outcome == 0) { draw_exit = true; }
+                if (outcome > 0) { longest_exit_loss = std::max(longest_exit_loss, plies + 1); }
+            };
+
+            for (size_t slot = 0; slot < piece_count; slot++) {
+                if (slots[slot].side != stm) { continue; }
+                const int from = squares[slot];
+                ChessPiece* piece = scratch.placed[slot];
+
+                for (uint64_t reachable = piece->reachableSquares(scratch.grid); reachable; reachable &= reachable - 1) {
+                    const int to = __builtin_ctzll(reachable);
+
+                    // Make the move on the scratch board & reject it if it leaves our King in check
+                    int captured = scratch.slotAt(to);
+                    if (captured >= 0) { scratch.placed[captured] = nullptr; }
+                    scratch.grid[Geometry::rowOf(from)][Geometry::colOf(from)] = nullptr;
+                    scratch.grid[Geometry::rowOf(to)][Geometry::colOf(to)] = piece;
+                    piece->setRow(Geometry::rowOf(to));
+                    piece->setColumn(Geometry::colOf(to));
+
+                    int king_square = slot == static_cast<size_t>(stm) ? to : squares[stm];
+                    bool legal = !scratch.attacked(king_square, 1 - stm);
+
+                    int en_passant_outcome = 0, en_passant_plies = 0;
+                    bool en_passant = legal && !previous.empty() && slots[slot].type == 'P' && std::abs(Geometry::rowOf(to) - Geometry::rowOf(from)) == 2;
+                    if (en_passant) {
+                        squares[slot] = to;
+                        en_passant = bestEnPassant(scratch, squares, slot, en_passant_outcome, en_passant_plies);
+                        squares[slot] = from;
+                    }
+
+                    scratch.grid[Geometry::rowOf(to)][Geometry::colOf(to)] = nullptr;
+                    piece->setRow(Geometry::rowOf(from));
+                    piece->setColumn(Geometry::colOf(from));
+                    scratch.grid[Geometry::rowOf(from)][Geometry::colOf(from)] = piece;
+                    if (captured >= 0) { scratch.put(captured, to); }
+                    if (!legal) { continue; }
+                    legal_moves++;
+
+                    if (en_passant) {
+                        // The opponent chooses between capturing en passant and its other moves, valued by the previous pass
+                        squares[slot] = to;
+                        const uint64_t child = index.encode(squares, 1 - stm);
+                        squares[slot] = from;
+                        if (!stuck[child]) {
+                            int child_plies = 0;
+                            int child_outcome = TablebaseIndex::decodeValue(previous[child], child_plies);
+                            if (preference(child_outcome, child_plies) > preference(en_passant_outcome, en_passant_plies)) {
+                                en_passant_outcome = child_outcome;
+                                en_passant_plies = child_plies;
+                            }
+                        }
+                        add_exit(en_passant_outcome, en_passant_plies);
+                        continue;
+                    }
+
+                    bool promotes = slots[slot].type == 'P' && Geometry::rowOf(to) == promotionRow(stm);
+                    if (captured < 0 && !promotes) {
+                        in_table++;
+                        continue;
+                    }
+
+                    // Leaves the table: look the result up in the smaller table, once per promotion choice
+                    for (const char& type : std::string(promotes ? "QRBN" : "-")) {
+                        std::vector<TablebasePiece> next;
+                        for (size_t other = 0; other < piece_count; other++) {
+                            if (static_cast<int>(other) == captured) { continue; }
+                            char next_type = (other == slot && promotes) ? type : slots[other].type;
+                            next.push_back({slots[other].side, next_type, other == slot ? to : squares[other]});
+                        }
+
+                        int plies = 0;
+                        int outcome = TablebaseIndex::decodeValue(lookup(next, 1 - stm), plies);
+                        add_exit(outcome, plies);
+                    }
+                }
+            }
+
+            if (previous.empty()) { stuck[position] = legal_moves == 0; }
+            if (legal_moves == 0) {
+                bool in_check = scratch.attacked(squares[stm], 1 - stm);
+                if (in_check) {
+                    found[thread].push_back({0, {static_cast<uint32_t>(position), TablebaseIndex::LOSS_BASE}});
+                } else {
+                    resolved[position] = 1; // Stalemate
+                }
+                continue;
+            }
+
+            bool safe_exit = draw_exit || best_exit_win <= MAX_PLY;
+            counters[position].store(static_cast<uint8_t>(in_table | (safe_exit ? SAFE_EXIT : 0)), std::memory_order_relaxed);
+            exit_loss[position] = static_cast<uint8_t>(std::min(longest_exit_loss, MAX_PLY));
+
+            if (best_exit_win <= MAX_PLY) {
+                found[thread].push_back({best_exit_win, {static_cast<uint32_t>(position), static_cast<uint8_t>(best_exit_win)}});
+            }
+            if (in_table == 0 && !safe_exit) {
+                found[thread].push_back({longest_exit_loss,
+                    {static_cast<uint32_t>(position), static_cast<uint8_t>(TablebaseIndex::LOSS_BASE + longest_exit_loss)}});
+            }
+        }
+    });
+
+    for (auto& list : found) {
+        for (const auto& entry : list) { buckets[entry.first].push_back(entry.second); }
+        list.clear();
+    }
+
+    // Phase 2: resolve one ply at a time, walking un-moves back from the positions resolved at the previous ply
+    for (int ply = 0; ply <= MAX_PLY; ply++) {
+        std::vector<Candidate> frontier;
+        for (const Candidate& candidate : buckets[ply]) {
+            if (resolved[candidate.index]) { continue; }
+            resolved[candidate.index] = 1;
+            values[candidate.index] = candidate.value;
+            frontier.push_back(candidate);
+        }
+        buckets[ply].clear();
+        if (frontier.empty()) { continue; }
+
+        parallel_for(frontier.size(), [&] (const unsigned& thread, const uint64_t& begin, const uint64_t& end) {
+            Scratch scratch(index);
+            std::vector<int> origins;
+            int squares[TablebaseIndex::MAX_PIECES];
+
+            for (uint64_t i = begin; i < end; i++) {
+                const Candidate& child = frontier[i];
+                int stm = 0;
+                index.decode(child.index, squares, stm);
+                scratch.setup(squares);
+                const bool child_lost = child.value >= TablebaseIndex::LOSS_BASE;
+                const int mover = 1 - stm;
+
+                for (size_t slot = 0; slot < piece_count; slot++) {
+                    if (slots[slot].side != mover) { continue; }
+                    const int to = squares[slot];
+
+                    // After the first pass, a double step that allows a capture en passant is an exit already counted by phase 1
+                    bool double_step_exit = false;
+                    if (!previous.empty() && slots[slot].type == 'P' && Geometry::rowOf(to) == pawnStartRow(mover) + 2 * pawnDirection(mover)) {
+                        int outcome = 0, plies = 0;
+                        double_step_exit = bestEnPassant(scratch, squares, slot, outcome, plies);
+                    }
+
+                    origins.clear();
+                    originCells(slots[slot].type, mover, to, scratch.grid, origins);
+                    for (const int& from : origins) {
+                        if (double_step_exit && std::abs(Geometry::rowOf(to) - Geometry::rowOf(from)) == 2) { continue; }
+                        // Confirm the un-move by checking the forward move from the parent position
+                        scratch.put(slot, from);
+                        bool reversible = scratch.placed[slot]->canMove(Geometry::rowOf(to), Geometry::colOf(to), scratch.grid);
+                        scratch.put(slot, to);
+                        if (!reversible) { continue; }
+
+                        squares[slot] = from;
+                        uint64_t parent = index.encode(squares, mover);
+                        squares[slot] = to;
+                        if (resolved[parent]) { continue; }
+
+                        if (child_lost) {
+                            found[thread].push_back({ply + 1, {static_cast<uint32_t>(parent), static_cast<uint8_t>(ply + 1)}});
+                            continue;
+                        }
+
+                        uint8_t before = counters[parent].fetch_sub(1, std::memory_order_relaxed);
+                        if ((before & COUNT_MASK) == 1 && !(before & SAFE_EXIT)) {
+                            int depth = std::max(ply + 1, static_cast<int>(exit_loss[parent]));
+                            found[thread].push_back({depth,
+                                {static_cast<uint32_t>(parent), static_cast<uint8_t>(TablebaseIndex::LOSS_BASE + depth)}});
+                        }
+                    }
+                }
+            }
+        });
+
+        for (auto& list : found) {
+            for (const auto& entry : list) {
+                if (entry.first <= MAX_PLY) { buckets[entry.first].push_back(entry.second); }
+            }
+            list.clear();
+        }
+    }
+
+    return values;
+}
+
+/**
+ * @brief Looks up a position reached by leaving the current table, from the perspective of its side to move
+ */
+uint8_t TablebaseGenerator::lookup(std::vector<TablebasePiece> pieces, int stm) const {
+    auto table = tables_.find(TablebaseIndex::signatureKey(TablebaseIndex::canonicalize(pieces, stm)));
+    if (table == tables_.end()) { return TablebaseIndex::DRAW; } // Trivial draws have no table
+
+    int squares[TablebaseIndex::MAX_PIECES];
+    for (size_t i = 0; i < pieces.size(); i++) { squares[i] = pieces[i].square; }
+    return table->second.values[table->second.index.encode(squares, stm)];
+}
+
+/**
+ * @brief Finds the best capture en passant open to the opponent of a Pawn that just made a double step
+ * @param squares The slot squares right after the double step, as set up on scratch
+ * @param pushed The slot of the Pawn that made the double step
+ * @return False if no capture en passant is legal. Otherwise outcome & plies are set, like TablebaseIndex::decodeValue()
+ *     does, from the capturing side's perspective.
+ */
+bool TablebaseGenerator::bestEnPassant(Scratch& scratch, const int squares[], const size_t& pushed, int& outcome, int& plies) const {
+    const std::vector<TablebasePiece>& slots = scratch.index.getSlots();
+    const int capturer = 1 - slots[pushed].side;
+    const int landed = squares[pushed];
+    const int passed = landed - pawnDirection(slots[pushed].side) * Geometry::COLS;
+    ChessPiece* victim = scratch.placed[pushed];
+    bool found = false;
+
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+        const int from = squares[slot];
+        if (slots[slot].side != capturer || slots[slot].type != 'P' || Geometry::rowOf(from) != Geometry::rowOf(landed) ||
+            std::abs(Geometry::colOf(from) - Geometry::colOf(landed)) != 1) {
+            continue;
+        }
+
+        // Make the capture on the scratch board & reject it if it leaves the capturing King in check
+        ChessPiece* pawn = scratch.placed[slot];
+        scratch.placed[pushed] = nullptr;
+        scratch.grid[Geometry::rowOf(landed)][Geometry::colOf(landed)] = nullptr;
+        scratch.grid[Geometry::rowOf(from)][Geometry::colOf(from)] = nullptr;
+        scratch.grid[Geometry::rowOf(passed)][Geometry::colOf(passed)] = pawn;
+        pawn->setRow(Geometry::rowOf(passed));
+        pawn->setColumn(Geometry::colOf(passed));
+
+        bool legal = !scratch.attacked(squares[capturer], 1 - capturer);
+
+        pawn->setRow(Geometry::rowOf(from));
+        pawn->setColumn(Geometry::colOf(from));
+        scratch.grid[Geometry::rowOf(passed)][Geometry::colOf(passed)] = nullptr;
+        scratch.grid[Geometry::rowOf(from)][Geometry::colOf(from)] = pawn;
+        scratch.grid[Geometry::rowOf(landed)][Geometry::colOf(landed)] = victim;
+        scratch.placed[pushed] = victim;
+        if (!legal) { continue; }
+
+        std::vector<TablebasePiece> next;
+        for (size_t other = 0; other < slots.size(); other++) {
+            if (other != pushed) { next.push_back({slots[other].side, slots[other].type, other == slot ? passed : squares[other]}); }
+        }
+
+        int next_plies = 0;
+        int next_outcome = -TablebaseIndex::decodeValue(lookup(next, 1 - capturer), next_plies);
+        if (next_outcome != 0) { next_plies++; }
+        if (!found || preference(next_outcome, next_plies) > preference(outcome, plies)) {
+            outcome = next_outcome;
+            plies = next_plies;
+        }
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * @brief Writes a finished table to "<directory_>/<SIGNATURE>.p4tb"
+ */
+bool TablebaseGenerator::write(const TablebaseIndex& index, const std::vector<uint8_t>& values) const {
+    TablebaseHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "P4TB", 4);
+    header.version = Tablebase::VERSION;
+    header.piece_count = static_cast<uint32_t>(index.getSlots().size());
+    std::memcpy(header.signature, index.getSignature().data(), std::min(sizeof(header.signature), index.getSignature().size()));
+    header.entries = values.size();
+
+    std::ofstream out(directory_ + "/" + index.getSignature() + ".p4tb", std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size()));
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads a previously written table file into values
+ */
+bool TablebaseGenerator::read(const TablebaseIndex& index, std::vector<uint8_t>& values) const {
+    std::ifstream in(directory_ + "/" + index.getSignature() + ".p4tb", std::ios::binary);
+    TablebaseHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) { return false; }
+    if (std::memcmp(header.magic, "P4TB", 4) != 0 || header.version != Tablebase::VERSION || header.entries != index.size() ||
+        std::strncmp(header.signature, index.getSignature().c_str(), sizeof(header.signature)) != 0) {
+        return false;
+    }
+
+    values.resize(header.entries);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size())));
+}
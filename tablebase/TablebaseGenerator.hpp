@@ -0,0 +1,101 @@
+/**
+ * @class TablebaseGenerator
+ * @brief Builds endgame tablebases (eg. KQK, KRK, KPK, KQKR) by retrograde analysis, using the movement rules of the pieces/ classes.
+ *
+ * Generation runs in two phases over the dense index of TablebaseIndex:
+ * 1) Every position is set up on a scratch board and its legal moves are generated with reachableSquares. Checkmates & stalemates
+ *    are resolved immediately, moves that leave the table (captures & promotions) are looked up in the smaller tables,
+ *    and the remaining in-table moves are counted.
+ * 2) Starting from the checkmates, positions are resolved one ply at a time by walking moves backwards ("un-moves"):
+ *    a predecessor of a lost position is won, and a predecessor whose in-table moves have all been shown to lose is lost.
+ *    Whatever is left unresolved at the end is a draw.
+ * Both phases are split across worker threads. Tables a signature depends on are generated (or loaded from disk) first.
+ *
+ * Stored positions never carry an en passant right. When both sides have pawns, a double step that lets the opponent capture
+ * en passant is treated as a move leaving the table instead: the opponent's best choice between that capture and the value
+ * of the position it lands in is taken from the previous pass, and whole passes are repeated until the values settle.
+ *
+ * @note Castling is not part of tablebase positions.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TablebaseIndex.hpp"
+
+class TablebaseGenerator {
+    public:
+        /**
+         * @brief Constructs a generator that writes its tables into directory
+         * @param directory The directory table files are read from & written to
+         * @param threads The number of worker threads. 0 uses one per hardware thread.
+         */
+        TablebaseGenerator(const std::string& directory, const unsigned& threads = 0);
+
+        /**
+         * @brief Generates the table for a signature, along with any smaller table it depends on, and writes them as "<SIGNATURE>.p4tb"
+         * @param signature A canonical signature with at most TablebaseIndex::MAX_PIECES pieces (eg. "KRK")
+         * @return True if every table could be generated & written. False otherwise (eg. invalid signature, unwritable directory).
+         */
+        bool generate(const std::string& signature);
+
+    private:
+        struct Scratch;
+
+        /**
+         * @brief A finished table, along with the index its positions are numbered by
+         */
+        struct Table {
+            TablebaseIndex index;
+            std::vector<uint8_t> values;
+        };
+
+        std::string directory_;
+        unsigned threads_;
+        std::unordered_map<uint32_t, Table> tables_; // Finished tables by TablebaseIndex::signatureKey(), used to resolve captures & promotions
+
+        /**
+         * @brief Makes sure the table for signature is in tables_, loading it from directory_ or generating it otherwise
+         */
+        bool ensure(const std::string& signature);
+
+        /**
+         * @brief Runs the retrograde analysis for a single signature whose dependencies are already in tables_
+         */
+        std::vector<uint8_t> build(const TablebaseIndex& index) const;
+
+        /**
+         * @brief Runs one pass of the retrograde analysis
+         * @param previous The values found by the previous pass, used to resolve double steps that allow a capture en passant.
+         *     Empty on the first pass, which treats those double steps as ordinary in-table moves.
+         * @param stuck Filled by the first pass with 1 for every position without a legal move, and read by the later ones
+         */
+        std::vector<uint8_t> resolve(const TablebaseIndex& index, const std::vector<uint8_t>& previous, std::vector<uint8_t>& stuck) const;
+
+        /**
+         * @brief Finds the best capture en passant open to the opponent of a Pawn that just made a double step
+         * @param squares The slot squares right after the double step, as set up on scratch
+         * @param pushed The slot of the Pawn that made the double step
+         * @return False if no capture en passant is legal. Otherwise outcome & plies are set, like TablebaseIndex::decodeValue()
+         *     does, from the capturing side's perspective.
+         */
+        bool bestEnPassant(Scratch& scratch, const int squares[], const size_t& pushed, int& outcome, int& plies) const;
+
+        /**
+         * @brief Looks up a position reached by leaving the current table, from the perspective of its side to move
+         */
+        uint8_t lookup(std::vector<TablebasePiece> pieces, int stm) const;
+
+        /**
+         * @brief Writes a finished table to "<directory_>/<SIGNATURE>.p4tb"
+         */
+        bool write(const TablebaseIndex& index, const std::vector<uint8_t>& values) const;
+
+        /**
+         * @brief Reads a previously written table file into values
+         */
+        bool read(const TablebaseIndex& index, std::vector<uint8_t>& values) const;
+};
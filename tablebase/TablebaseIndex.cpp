@@ -0,0 +1,176 @@
+#include "TablebaseIndex.hpp"
+
+#include <algorithm>
+
+namespace {
+    const std::string PIECE_ORDER = "KQRBNP";
+
+    // Material used to decide which side is the "strong" side of a signature
+    int materialValue(const char& type) {
+        switch (type) {
+            case 'Q': return 9;
+            case 'R': return 5;
+            case 'B': return 3;
+            case 'N': return 3;
+            case 'P': return 1;
+            default: return 0;
+        }
+    }
+
+    // Position of a piece within its side of a signature (Kings first, then Q, R, B, N, P)
+    int slotKey(const TablebasePiece& piece) {
+        if (piece.type == 'K') { return piece.side; }
+        return 2 + piece.side * static_cast<int>(PIECE_ORDER.size()) + static_cast<int>(PIECE_ORDER.find(piece.type));
+    }
+}
+
+/**
+ * @brief Constructs the index of the given material signature.
+ * @param signature A canonical signature (see canonicalize()), eg. "KQK"
+ */
+TablebaseIndex::TablebaseIndex(const std::string& signature) : signature_{signature} {
+    int side = -1;
+    for (const char& type : signature) {
+        if (type == 'K') { side++; }
+        slots_.push_back({side, type, -1});
+    }
+    std::stable_sort(slots_.begin(), slots_.end(), [] (const TablebasePiece& a, const TablebasePiece& b) {
+        return slotKey(a) < slotKey(b);
+    });
+}
+
+/**
+ * @brief Getter for the signature this index was built for
+ */
+std::string TablebaseIndex::getSignature() const {
+    return signature_;
+}
+
+/**
+ * @brief Gets the pieces (side & type, no square) of every slot, in slot order
+ */
+const std::vector<TablebasePiece>& TablebaseIndex::getSlots() const {
+    return slots_;
+}
+
+/**
+ * @brief Gets the number of positions in the table (ie. 2 * 64^n for n pieces)
+ */
+uint64_t TablebaseIndex::size() const {
+    return uint64_t{2} << (6 * slots_.size());
+}
+
+/**
+ * @brief Computes the index of the position with the given slot squares & side to move
+ */
+uint64_t TablebaseIndex::encode(const int squares[], const int& stm) const {
+    uint64_t index = stm;
+    for (size_t i = slots_.size(); i-- > 0; ) {
+        index = (index << 6) | static_cast<uint64_t>(squares[i]);
+    }
+    return index;
+}
+
+/**
+ * @brief Recovers the slot squares & side to move of the position at index
+ */
+void TablebaseIndex::decode(uint64_t index, int squares[], int& stm) const {
+    for (size_t i = 0; i < slots_.size(); i++) {
+        squares[i] = static_cast<int>(index & 63);
+        index >>= 6;
+    }
+    stm = static_cast<int>(index);
+}
+
+/**
+ * @brief Checks that a signature is well-formed: two Kings, at most MAX_PIECES pieces, and each side written in canonical order
+ */
+bool TablebaseIndex::isValidSignature(const std::string& signature) {
+    if (signature.size() < 2 || static_cast<int>(signature.size()) > MAX_PIECES || signature[0] != 'K') { return false; }
+    if (std::count(signature.begin(), signature.end(), 'K') != 2) { return false; }
+
+    std::vector<TablebasePiece> pieces;
+    int side = -1;
+    for (const char& type : signature) {
+        if (PIECE_ORDER.find(type) == std::string::npos) { return false; }
+        if (type == 'K') { side++; }
+        // Spread the pieces out so that canonicalize() sees a real position
+        pieces.push_back({side, type, static_cast<int>(pieces.size()) + Geometry::COLS});
+    }
+
+    int stm = 0;
+    return canonicalize(pieces, stm) == signature;
+}
+
+/**
+ * @brief Determines if the material of a canonical signature can never deliver mate (eg. "KK", "KBK", "KNK")
+ */
+bool TablebaseIndex::isTrivialDraw(const std::string& signature) {
+    return signature == "KK" || signature == "KBK" || signature == "KNK";
+}
+
+/**
+ * @brief Packs a signature into an integer (3 bits per piece letter), so that tables can be keyed without comparing strings
+ */
+uint32_t TablebaseIndex::signatureKey(const std::string& signature) {
+    uint32_t key = 0;
+    for (const char& type : signature) {
+        key = key << 3 | static_cast<uint32_t>(PIECE_ORDER.find(type) + 1);
+    }
+    return key;
+}
+
+/**
+ * @brief Brings a position into the canonical orientation of its table.
+ * @param pieces The pieces on the board, with side 0 being the side that moves UP the board.
+ *     On return they are sorted in slot order, and sides / squares are swapped & mirrored if side 1 was the stronger side.
+ * @param stm The side to move. Updated alongside the pieces.
+ * @return The canonical signature of the position
+ */
+std::string TablebaseIndex::canonicalize(std::vector<TablebasePiece>& pieces, int& stm) {
+    std::string sides[2];
+    int material[2] = {0, 0};
+    for (const TablebasePiece& piece : pieces) {
+        if (piece.type != 'K') { sides[piece.side] += piece.type; }
+        material[piece.side] += materialValue(piece.type);
+    }
+
+    auto by_order = [] (const char& a, const char& b) { return PIECE_ORDER.find(a) < PIECE_ORDER.find(b); };
+    std::sort(sides[0].begin(), sides[0].end(), by_order);
+    std::sort(sides[1].begin(), sides[1].end(), by_order);
+
+    // The stronger side becomes side 0; on equal material, the side with the earlier pieces (in PIECE_ORDER) wins
+    bool swap_sides = material[1] > material[0] || (material[1] == material[0] &&
+        std::lexicographical_compare(sides[1].begin(), sides[1].end(), sides[0].begin(), sides[0].end(), by_order));
+
+    if (swap_sides) {
+        std::swap(sides[0], sides[1]);
+        stm ^= 1;
+        for (TablebasePiece& piece : pieces) {
+            // Mirror the rows so that the new side 0 still moves UP the board
+            piece.side ^= 1;
+            piece.square = Geometry::cell(Geometry::ROWS - 1 - Geometry::rowOf(piece.square), Geometry::colOf(piece.square));
+        }
+    }
+
+    std::stable_sort(pieces.begin(), pieces.end(), [] (const TablebasePiece& a, const TablebasePiece& b) {
+        return slotKey(a) < slotKey(b);
+    });
+
+    return "K" + sides[0] + "K" + sides[1];
+}
+
+/**
+ * @brief Decodes a stored value into a win / draw / loss from the side to move's perspective
+ * @return +1 for a win, 0 for a draw (or invalid position), -1 for a loss. plies is set to the distance to mate (0 for a draw).
+ */
+int TablebaseIndex::decodeValue(const uint8_t& value, int& plies) {
+    plies = 0;
+    if (value == DRAW || value == INVALID) { return 0; }
+    if (value < LOSS_BASE) {
+        plies = value;
+        return 1;
+    }
+    plies = value - LOSS_BASE;
+    return -1;
+}
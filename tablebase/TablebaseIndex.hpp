@@ -0,0 +1,106 @@
+/**
+ * @class TablebaseIndex
+ * @brief Maps positions of a small endgame (eg. KQK, KRK, KPK, KQKR) to a dense index, and back.
+ *
+ * A material signature lists the pieces of the stronger side followed by the pieces of the weaker side,
+ * each starting with its King (eg. "KQKR"). Side 0 is always the stronger side, and it moves UP the board
+ * (ie. its pawns promote on the last row). Positions from any other orientation are canonicalized first.
+ *
+ * The index of a position is:  stm * 64^n + square[0] + 64 * square[1] + ... + 64^(n-1) * square[n-1]
+ * where square[i] = Geometry::cell(row, col) is the cell of the i-th slot of the signature, and stm is the side to move.
+ * Slot 0 is the strong King, slot 1 the weak King, followed by the remaining strong pieces, then the remaining weak ones.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../BoardGeometry.hpp"
+
+/**
+ * @brief A piece as seen by the tablebase: the side it belongs to, its type letter (one of "KQRBNP") and its cell.
+ */
+struct TablebasePiece {
+    int side;
+    char type;
+    int square;
+};
+
+class TablebaseIndex {
+    public:
+        using Geometry = GameBoard;
+        static_assert(Geometry::CELLS <= 64, "Squares are packed into 6 bits of the index");
+        static const int MAX_PIECES = 4;
+
+        // Encoding of the one-byte value stored for every position (always from the side to move's perspective)
+        static constexpr uint8_t DRAW = 0;          // Draw (or not a mate for either side)
+        static constexpr uint8_t LOSS_BASE = 128;   // LOSS_BASE + n : the side to move gets mated in n plies (n = 0 means mated now)
+        static constexpr uint8_t INVALID = 255;     // Not a reachable position (overlapping pieces, side not to move in check, ...)
+                                                    // 1 ... 127      : the side to move mates in that many plies
+
+        /**
+         * @brief Constructs the index of the given material signature.
+         * @param signature A canonical signature (see canonicalize()), eg. "KQK"
+         */
+        TablebaseIndex(const std::string& signature);
+
+        /**
+         * @brief Getter for the signature this index was built for
+         */
+        std::string getSignature() const;
+
+        /**
+         * @brief Gets the pieces (side & type, no square) of every slot, in slot order
+         */
+        const std::vector<TablebasePiece>& getSlots() const;
+
+        /**
+         * @brief Gets the number of positions in the table (ie. 2 * 64^n for n pieces)
+         */
+        uint64_t size() const;
+
+        /**
+         * @brief Computes the index of the position with the given slot squares & side to move
+         */
+        uint64_t encode(const int squares[], const int& stm) const;
+
+        /**
+         * @brief Recovers the slot squares & side to move of the position at index
+         */
+        void decode(uint64_t index, int squares[], int& stm) const;
+
+        /**
+         * @brief Checks that a signature is well-formed: two Kings, at most MAX_PIECES pieces, and each side written in canonical order
+         */
+        static bool isValidSignature(const std::string& signature);
+
+        /**
+         * @brief Determines if the material of a canonical signature can never deliver mate (eg. "KK", "KBK", "KNK")
+         */
+        static bool isTrivialDraw(const std::string& signature);
+
+        /**
+         * @brief Packs a signature into an integer (3 bits per piece letter), so that tables can be keyed without comparing strings
+         */
+        static uint32_t signatureKey(const std::string& signature);
+
+        /**
+         * @brief Brings a position into the canonical orientation of its table.
+         * @param pieces The pieces on the board, with side 0 being the side that moves UP the board.
+         *     On return they are sorted in slot order, and sides / squares are swapped & mirrored if side 1 was the stronger side.
+         * @param stm The side to move. Updated alongside the pieces.
+         * @return The canonical signature of the position
+         */
+        static std::string canonicalize(std::vector<TablebasePiece>& pieces, int& stm);
+
+        /**
+         * @brief Decodes a stored value into a win / draw / loss from the side to move's perspective
+         * @return +1 for a win, 0 for a draw (or invalid position), -1 for a loss. plies is set to the distance to mate (0 for a draw).
+         */
+        static int decodeValue(const uint8_t& value, int& plies);
+
+    private:
+        std::string signature_;
+        std::vector<TablebasePiece> slots_;
+};
@@ -0,0 +1,104 @@
+#include "Commands.hpp"
+#include "../analysis/AnalysisScheduler.hpp"
+#include "../Notation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Parses a line of an analysis jobs file: a FEN (or "startpos"), then optional "; <key> <value>" fields among
+ *     depth, multipv, priority & deadline (ms), eg. "startpos; depth 10; multipv 3; priority 1; deadline 500"
+ * @return False if a field is unknown
+ */
+bool parseAnalysisJob(const std::string& line, AnalysisJob& job) {
+    std::istringstream stream(line);
+    std::string field;
+    std::getline(stream, field, ';');
+    const size_t start = field.find_first_not_of(" \t");
+    const size_t end = field.find_last_not_of(" \t\r");
+    job.fen = start == std::string::npos ? "" : field.substr(start, end - start + 1);
+    if (job.fen == "startpos") { job.fen.clear(); }
+
+    while (std::getline(stream, field, ';')) {
+        std::istringstream pair(field);
+        std::string key;
+        long long value = 0;
+        if (!(pair >> key)) { continue; }
+        pair >> value;
+        if (key == "depth") { job.depth = static_cast<int>(value); }
+        else if (key == "multipv") { job.multi_pv = static_cast<int>(value); }
+        else if (key == "priority") { job.priority = static_cast<int>(value); }
+        else if (key == "deadline") { job.deadline = value; }
+        else { return false; }
+    }
+    return true;
+}
+
+/**
+ * @brief Submits every job of a file at once to an AnalysisScheduler, prints each result as it comes in, and then the
+ *     throughput. Blank lines & lines starting with '#' are skipped; see parseAnalysisJob() for the others.
+ *     With a shared-memory segment name, the hash table lives in that segment, shared with other processes & kept after
+ *     exiting. A missing segment is created with the hash size; an existing one keeps its own, which is printed.
+ *     Usage: main analyse <jobs file> [threads] [hash MB] [segment]   (0 threads uses one per hardware thread)
+ * @return 0 if every job was valid, 1 otherwise
+ */
+int runAnalysis(const std::vector<std::string>& args) {
+    if (args.empty() || args.size() > 4) {
+        std::cerr << "usage: analyse <jobs file> [threads] [hash MB] [segment]" << std::endl;
+        return 1;
+    }
+    std::ifstream in(args[0]);
+    if (!in) {
+        std::cerr << "could not read " << args[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<AnalysisJob> jobs;
+    for (std::string line; std::getline(in, line); ) {
+        const size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') { continue; }
+        AnalysisJob job;
+        if (!parseAnalysisJob(line, job)) {
+            std::cerr << "invalid job " << line << std::endl;
+            return 1;
+        }
+        jobs.push_back(job);
+    }
+
+    const unsigned threads = args.size() > 1 ? static_cast<unsigned>(std::atoi(args[1].c_str())) : 0;
+    const size_t hash = args.size() > 2 ? static_cast<size_t>(std::atoll(args[2].c_str())) : 64;
+    const char* statuses[] = {"complete", "partial", "expired", "no moves"};
+    AnalysisScheduler scheduler(threads, hash, nullptr, [&] (const AnalysisResult& result) {
+        std::ostringstream line;
+        line << "job " << result.id << ": " << statuses[result.status] << " depth " << result.depth << " nodes " << result.nodes
+            << " waited " << result.wait_time << "ms searched " << result.search_time << "ms";
+        for (size_t i = 0; i < result.lines.size(); i++) {
+            line << "\n  " << i + 1 << ": " << result.lines[i].score << " pv";
+            for (const Move& move : result.lines[i].pv) { line << " " << Notation::moveName(move); }
+        }
+        std::cout << line.str() << std::endl;
+    });
+    if (args.size() > 3 && !scheduler.openSharedTable(args[3])) {
+        std::cerr << "could not open shared hash table " << args[3] << std::endl;
+        return 1;
+    }
+    if (args.size() > 3) { std::cout << "shared hash table " << args[3] << ": " << scheduler.getTableMegabytes() << " MB" << std::endl; }
+
+    int invalid = 0;
+    for (const AnalysisJob& job : jobs) {
+        if (scheduler.submit(job) == 0) {
+            std::cerr << "invalid position " << job.fen << std::endl;
+            invalid++;
+        }
+    }
+    scheduler.wait();
+
+    const AnalysisScheduler::Stats stats = scheduler.getStats();
+    std::cout << stats.completed << " complete, " << stats.partial << " partial, " << stats.expired << " expired, " << stats.no_moves
+        << " without moves in " << stats.seconds << "s: " << stats.positionsPerSecond() << " positions/s, "
+        << static_cast<long long>(stats.nodes / std::max(stats.seconds, 1e-9)) << " nps" << std::endl;
+    return invalid == 0 ? 0 : 1;
+}
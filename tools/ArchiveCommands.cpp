@@ -0,0 +1,173 @@
+#include "Commands.hpp"
+#include "../archive/GameArchiveReader.hpp"
+#include "../archive/GameArchiveWriter.hpp"
+#include "../archive/PositionIndex.hpp"
+#include "../archive/PositionIndexBuilder.hpp"
+#include "../Notation.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Converts game files (see GameRecord for their format) into a binary game archive.
+ *     Usage: main archive <archive> <games>...
+ * @return 0 if the archive was written, 1 otherwise
+ */
+int buildArchive(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cerr << "usage: archive <archive> <games>..." << std::endl;
+        return 1;
+    }
+
+    GameArchiveWriter writer;
+    if (!writer.open(args[0])) {
+        std::cerr << "could not write " << args[0] << std::endl;
+        return 1;
+    }
+
+    long long skipped = 0;
+    for (size_t i = 1; i < args.size(); i++) {
+        std::ifstream in(args[i]);
+        if (!in) {
+            std::cerr << "could not read " << args[i] << std::endl;
+            return 1;
+        }
+        for (std::string line; std::getline(in, line); ) {
+            size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#') { continue; }
+
+            GameRecord record;
+            if (!GameRecord::parse(line, record) || !writer.write(record)) { skipped++; }
+        }
+    }
+
+    const uint64_t games = writer.size();
+    if (!writer.close()) {
+        std::cerr << "could not write " << args[0] << std::endl;
+        return 1;
+    }
+    std::cout << args[0] << ": " << games << " games, " << skipped << " skipped" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Replays every game of a binary game archive, or of a text game file, and reports the replay speed.
+ *     Usage: main replay <archive | games>
+ * @return 0 if the file could be read, 1 otherwise
+ */
+int replayGames(const std::vector<std::string>& args) {
+    if (args.size() != 1) {
+        std::cerr << "usage: replay <archive | games>" << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    long long games = 0;
+    long long plies = 0;
+
+    GameArchiveReader reader;
+    GameRecord record;
+    if (reader.open(args[0])) {
+        while (reader.next(record)) {
+            games++;
+            plies += static_cast<long long>(record.moves.size());
+        }
+    } else {
+        std::ifstream in(args[0]);
+        if (!in) {
+            std::cerr << "could not read " << args[0] << std::endl;
+            return 1;
+        }
+        for (std::string line; std::getline(in, line); ) {
+            if (!GameRecord::parse(line, record) || record.moves.empty()) { continue; }
+
+            // Text moves have to be checked against the rules, where archived moves index a move list
+            std::unique_ptr<ChessBoard> board = record.fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(record.fen);
+            if (!board) { continue; }
+            for (const Move& move : record.moves) {
+                if (!board->move(move)) { break; }
+                plies++;
+            }
+            games++;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << games << " games, " << plies << " plies in " << seconds << "s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Builds a position index over a binary game archive.
+ *     Usage: main posindex <archive> <index>
+ * @return 0 if the index was written, 1 otherwise
+ */
+int buildPositionIndex(const std::vector<std::string>& args) {
+    if (args.size() != 2) {
+        std::cerr << "usage: posindex <archive> <index>" << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    long long positions = PositionIndexBuilder().build(args[0], args[1]);
+    if (positions < 0) {
+        std::cerr << "could not index " << args[0] << " into " << args[1] << std::endl;
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << args[1] << ": " << positions << " positions in " << seconds << "s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Looks up the position reached by a sequence of moves from the starting position: how many games reached it,
+ *     their results, and the same for the position after each legal move.
+ *     Usage: main posquery <index> [moves...]
+ * @return 0 if the query could be answered, 1 otherwise
+ */
+int queryPositionIndex(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::cerr << "usage: posquery <index> [moves...]" << std::endl;
+        return 1;
+    }
+
+    PositionIndex index;
+    if (!index.open(args[0])) {
+        std::cerr << "could not open " << args[0] << std::endl;
+        return 1;
+    }
+
+    ChessBoard board;
+    for (size_t i = 1; i < args.size(); i++) {
+        Move move;
+        if (!Notation::parseMove(args[i], move) || !board.move(move)) {
+            std::cerr << "illegal move " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+    auto print = [] (const std::string& label, const PositionIndex::Stats& stats) {
+        std::cout << label << " games " << stats.games << " +" << stats.player_one_wins << " -" << stats.player_two_wins
+            << " =" << stats.draws << std::endl;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    print("position", index.stats(board.getHash()));
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    for (const Move& move : moves) {
+        MoveUndo undo;
+        board.makeMove(move, undo);
+        const PositionIndex::Stats stats = index.stats(board.getHash());
+        board.unmakeMove(move, undo);
+        if (stats.games > 0) { print(Notation::moveName(move), stats); }
+    }
+
+    const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "query took " << millis << "ms" << std::endl;
+    return 0;
+}
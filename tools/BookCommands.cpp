@@ -0,0 +1,32 @@
+#include "Commands.hpp"
+#include "../book/BookBuilder.hpp"
+
+#include <iostream>
+
+/**
+ * @brief Builds an opening book from game files (see BookBuilder for their format).
+ *     Usage: main bookgen <book> <games>...
+ * @return 0 if the book was written, 1 otherwise
+ */
+int buildBook(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cerr << "usage: bookgen <book> <games>..." << std::endl;
+        return 1;
+    }
+
+    BookBuilder builder;
+    for (size_t i = 1; i < args.size(); i++) {
+        if (builder.addGameFile(args[i]) < 0) {
+            std::cerr << "could not read " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+    long long written = builder.write(args[0]);
+    if (written < 0) {
+        std::cerr << "could not write " << args[0] << std::endl;
+        return 1;
+    }
+    std::cout << args[0] << ": " << written << " entries" << std::endl;
+    return 0;
+}
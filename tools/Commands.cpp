@@ -0,0 +1,52 @@
+#include "Commands.hpp"
+
+#include <iostream>
+
+namespace {
+    const Command COMMANDS[] = {
+        {"tbgen", generateTablebases},
+        {"bookgen", buildBook},
+        {"loadtest", runLoadTest},
+        {"archive", buildArchive},
+        {"replay", replayGames},
+        {"posindex", buildPositionIndex},
+        {"posquery", queryPositionIndex},
+        {"mate", solveMate},
+        {"matebench", benchMateSolver},
+        {"bench", runBench},
+        {"perft", runPerft},
+        {"pperft", runParallelPerft},
+        {"perftsuite", runPerftSuite},
+        {"nnuegen", generateNetwork},
+        {"evalbench", benchEvaluation},
+        {"selfplay", runSelfPlay},
+        {"analyse", runAnalysis},
+        {"posgen", generatePositions},
+        {"posdedup", deduplicatePositions},
+        {"poscheck", checkPositionWriter},
+    };
+}
+
+/**
+ * @brief Finds the mode with the given name
+ * @return The mode, or null if there is none
+ */
+const Command* findCommand(const std::string& name) {
+    for (const Command& command : COMMANDS) {
+        if (name == command.name) { return &command; }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Sets up the position given by the FEN in args[first...], or the start position if there is none.
+ *     The FEN may be passed unquoted, as several arguments.
+ * @return The board, or null (after printing an error) if the FEN is invalid
+ */
+std::unique_ptr<ChessBoard> loadPosition(const std::vector<std::string>& args, const size_t& first) {
+    std::string fen;
+    for (size_t i = first; i < args.size(); i++) { fen += (i > first ? " " : "") + args[i]; }
+    std::unique_ptr<ChessBoard> board = fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(fen);
+    if (!board) { std::cerr << "invalid FEN " << fen << std::endl; }
+    return board;
+}
@@ -0,0 +1,214 @@
+/**
+ * @brief The modes of the main executable ("main <mode> <arguments>..."), which otherwise runs as a UCI engine.
+ *
+ * Each mode's driver lives in the tools/ translation unit of the subsystem it drives (eg. TablebaseCommands.cpp for
+ * tbgen), and findCommand() maps mode names to drivers. A driver gets the arguments after the mode's name, prints its
+ * usage when they are invalid, and returns the process's exit status.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../ChessBoard.hpp"
+
+/**
+ * @brief A mode of the main executable
+ */
+struct Command {
+    const char* name;
+    int (*run)(const std::vector<std::string>& args);
+};
+
+/**
+ * @brief Finds the mode with the given name
+ * @return The mode, or null if there is none
+ */
+const Command* findCommand(const std::string& name);
+
+/**
+ * @brief Sets up the position given by the FEN in args[first...], or the start position if there is none.
+ *     The FEN may be passed unquoted, as several arguments.
+ * @return The board, or null (after printing an error) if the FEN is invalid
+ */
+std::unique_ptr<ChessBoard> loadPosition(const std::vector<std::string>& args, const size_t& first);
+
+// TablebaseCommands.cpp
+
+/**
+ * @brief Generates endgame tablebases.
+ *     Usage: main tbgen <directory> <SIGNATURE>...   (eg. main tbgen tables KQK KRK KPK)
+ * @return 0 if every table was generated, 1 otherwise
+ */
+int generateTablebases(const std::vector<std::string>& args);
+
+// BookCommands.cpp
+
+/**
+ * @brief Builds an opening book from game files (see BookBuilder for their format).
+ *     Usage: main bookgen <book> <games>...
+ * @return 0 if the book was written, 1 otherwise
+ */
+int buildBook(const std::vector<std::string>& args);
+
+// ServerCommands.cpp
+
+/**
+ * @brief Runs simulated clients against a GameServer and reports move latency.
+ *     Usage: main loadtest [clients] [games per client] [moves] [worker threads] [random | scripted]
+ *     The scripted scenario replays a game with castling, en passant & a promotion (see LoadGenerator).
+ * @return 0, or 1 if a move of the scripted scenario was rejected
+ */
+int runLoadTest(const std::vector<std::string>& args);
+
+// ArchiveCommands.cpp
+
+/**
+ * @brief Converts game files (see GameRecord for their format) into a binary game archive.
+ *     Usage: main archive <archive> <games>...
+ * @return 0 if the archive was written, 1 otherwise
+ */
+int buildArchive(const std::vector<std::string>& args);
+
+/**
+ * @brief Replays every game of a binary game archive, or of a text game file, and reports the replay speed.
+ *     Usage: main replay <archive | games>
+ * @return 0 if the file could be read, 1 otherwise
+ */
+int replayGames(const std::vector<std::string>& args);
+
+/**
+ * @brief Builds a position index over a binary game archive.
+ *     Usage: main posindex <archive> <index>
+ * @return 0 if the index was written, 1 otherwise
+ */
+int buildPositionIndex(const std::vector<std::string>& args);
+
+/**
+ * @brief Looks up the position reached by a sequence of moves from the starting position: how many games reached it,
+ *     their results, and the same for the position after each legal move.
+ *     Usage: main posquery <index> [moves...]
+ * @return 0 if the query could be answered, 1 otherwise
+ */
+int queryPositionIndex(const std::vector<std::string>& args);
+
+// MateCommands.cpp
+
+/**
+ * @brief Answers "can the player to move mate in at most N moves?" with the proof-number solver, and prints the
+ *     shortest mating line found. With "checks", only mates by successive checks are looked for.
+ *     Usage: main mate <moves> [checks] [FEN]   (the start position without a FEN)
+ * @return 0 if the query was answered, 1 if the arguments are invalid
+ */
+int solveMate(const std::vector<std::string>& args);
+
+/**
+ * @brief Solves every puzzle of the bundled suite, checking the length of each mate found, and times the solver against
+ *     an alpha-beta search to the depth the mate needs.
+ *     Usage: main matebench [checks]
+ * @return 0 if every mate was found with its expected length, 1 otherwise
+ */
+int benchMateSolver(const std::vector<std::string>& args);
+
+// BenchCommands.cpp
+
+/**
+ * @brief Searches every position of the bundled bench suite to a fixed depth, each from an empty table, and prints the
+ *     total node count & speed. The total depends only on the search (not on timing or the order of the positions), so it
+ *     is a signature: a change that should not alter the search must leave it unchanged.
+ *     Usage: main bench [depth] [hash MB]
+ * @return 0 once every position was searched, 1 if the arguments are invalid
+ */
+int runBench(const std::vector<std::string>& args);
+
+// PerftCommands.cpp
+
+/**
+ * @brief Counts the legal move tree of a position & prints the count of each root move.
+ *     Usage: main perft <depth> [FEN]   (the start position without a FEN)
+ * @return 0 on success, 1 if the arguments are invalid
+ */
+int runPerft(const std::vector<std::string>& args);
+
+/**
+ * @brief Counts the legal move tree of a position on several threads sharing a hash table of subtree counts, & prints
+ *     the count of each root move and the hash hit rate.
+ *     Usage: main pperft <depth> <threads> <hash MB> [FEN]   (0 threads uses one per hardware thread)
+ * @return 0 on success, 1 if the arguments are invalid
+ */
+int runParallelPerft(const std::vector<std::string>& args);
+
+/**
+ * @brief Counts the legal move tree of every position of the bundled suite & checks each count against its published
+ *     value, so that a change to move generation can be checked in one run.
+ *     Usage: main perftsuite
+ * @return 0 if every count matched, 1 otherwise
+ */
+int runPerftSuite(const std::vector<std::string>& args);
+
+// NnueCommands.cpp
+
+/**
+ * @brief Writes an NNUE weights file equivalent to the handcrafted evaluation, to seed training or to check the NNUE code.
+ *     Usage: main nnuegen <file>
+ * @return 0 if the file was written, 1 otherwise
+ */
+int generateNetwork(const std::vector<std::string>& args);
+
+/**
+ * @brief Checks that incremental NNUE evaluation matches evaluating from scratch (& the handcrafted evaluation, for a
+ *     network written by nnuegen) over a move tree, then times each way of evaluating.
+ *     Usage: main evalbench <weights file> <depth> [FEN]
+ * @return 0 if every evaluation matched, 1 otherwise
+ */
+int benchEvaluation(const std::vector<std::string>& args);
+
+// TournamentCommands.cpp
+
+/**
+ * @brief Plays a match between two engine configurations on every core, streaming each result, until the SPRT of
+ *     H0: elo0 vs H1: elo1 (0 & 5 by default) is decided or every game is played.
+ *     Usage: main selfplay <first> <second> <games> <openings | -> <archive | -> [elo0 elo1]
+ *     (see parseEngine() for the configurations; "-" plays from the starting position / keeps no archive)
+ * @return 0 when the match is over, 1 if the arguments are invalid
+ */
+int runSelfPlay(const std::vector<std::string>& args);
+
+// AnalysisCommands.cpp
+
+/**
+ * @brief Submits every job of a file at once to an AnalysisScheduler, prints each result as it comes in, and then the
+ *     throughput. Blank lines & lines starting with '#' are skipped; see parseAnalysisJob() for the others.
+ *     With a shared-memory segment name, the hash table lives in that segment, shared with other processes & kept after
+ *     exiting. A missing segment is created with the hash size; an existing one keeps its own, which is printed.
+ *     Usage: main analyse <jobs file> [threads] [hash MB] [segment]   (0 threads uses one per hardware thread)
+ * @return 0 if every job was valid, 1 otherwise
+ */
+int runAnalysis(const std::vector<std::string>& args);
+
+// TrainingCommands.cpp
+
+/**
+ * @brief Packs every position of a binary game archive, labelled with its game's result, into shuffled chunk files
+ *     named <prefix>-00000.p4pp, <prefix>-00001.p4pp, ...
+ *     Usage: main posgen <archive> <prefix> [positions per chunk]
+ * @return 0 if every chunk was written, 1 otherwise
+ */
+int generatePositions(const std::vector<std::string>& args);
+
+/**
+ * @brief Copies chunk files of packed positions into new shuffled chunk files without repeated positions.
+ *     Usage: main posdedup <prefix> <chunk files...>
+ * @return 0 if every chunk was read & written, 1 otherwise
+ */
+int deduplicatePositions(const std::vector<std::string>& args);
+
+/**
+ * @brief Checks PositionWriter under contention: several threads write numbered positions in uneven batches into tiny
+ *     chunks, then every chunk is read back to check that each one but the last is full & that every position was
+ *     written exactly once. The chunk files are removed afterwards.
+ *     Usage: main poscheck <prefix> [threads] [positions per chunk]
+ * @return 0 if every check passed, 1 otherwise
+ */
+int checkPositionWriter(const std::vector<std::string>& args);
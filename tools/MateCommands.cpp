@@ -0,0 +1,140 @@
+#include "Commands.hpp"
+#include "../search/MateSolver.hpp"
+#include "../search/Search.hpp"
+#include "../Notation.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    const size_t MATE_HASH_MEGABYTES = 64;  // Proof-number table of the mate solver
+
+    /**
+     * @brief A position of the matebench suite, whose player to move mates in exactly moves moves
+     */
+    struct MatePuzzle {
+        const char* fen;
+        int moves;
+    };
+
+    // Classic problems, and endings of self-play games cut a few moves before the mate
+    const MatePuzzle MATE_PUZZLES[] = {
+        {"6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 1},
+        {"r1bqkbnr/pppp1ppp/2n5/4p3/2B1P3/5Q2/PPPP1PPP/RNB1K1NR w KQkq - 0 1", 1},
+        {"6rk/6pp/8/6N1/8/8/8/6K1 w - - 0 1", 1},
+        {"B7/5P2/6B1/1QN5/8/8/7K/k7 w - - 0 1", 1},
+        {"8/3P1rk1/8/P2P4/K7/8/1q6/8 b - - 0 1", 1},
+        {"6k1/pp4p1/2p5/2bp4/8/P5Pb/1P3rrP/2BRRN1K b - - 0 1", 2},
+        {"r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 1", 2},
+        {"r1b2k1r/ppp1bppp/8/1B1Q4/5q2/2P5/PPP2PPP/R3R1K1 w - - 1 1", 2},
+        {"7k/8/5K2/8/8/8/8/6R1 w - - 0 1", 2},
+        {"q5b1/3k4/7p/3p3p/7P/2r5/8/7K b - - 0 1", 2},
+        {"2Q5/4k3/P6P/3P4/8/6K1/3B4/8 w - - 0 1", 2},
+        {"8/4bQ2/P5k1/6n1/1r2p3/6rb/2K5/4q3 b - - 0 1", 2},
+        {"2r3k1/p4p2/3Rp2p/1p2P1pK/8/1P4P1/P3Q2P/1q6 b - - 0 1", 3},
+        {"r5rk/5p1p/5R2/4B3/8/8/7P/7K w - - 0 1", 3},
+        {"3k1K2/r7/8/7p/n3b3/5p2/8/8 b - - 0 1", 3},
+        {"1r2k3/P7/2p5/4P1NP/4B2P/3Rb3/1rQBR1N1/3bK3 w - - 0 1", 3},
+        {"8/8/8/1r6/8/3p1kp1/3B4/5K1b b - - 0 1", 3},
+        {"r1bqr3/ppp1B1kp/1b4p1/n2B4/3PQ1P1/2P5/P4P2/RN4K1 w - - 1 1", 4},
+        {"8/2k1n1Q1/1R6/p1bp2p1/Bn1Pp1P1/2P5/5P2/5K2 w - - 0 1", 4},
+        {"8/3k4/7P/P7/3P4/2Q3K1/8/4B3 w - - 0 1", 4},
+        {"8/r3k1K1/8/7p/5p2/8/1n6/7b b - - 0 1", 4},
+        {"8/1P6/8/8/4K3/1k6/8/8 w - - 0 1", 5},
+        {"8/2k1n3/1R6/p1bp2p1/B2P2PQ/2P1p3/2n2P2/5K2 w - - 0 1", 5},
+        {"3k3K/3r3b/8/7p/n7/5p2/8/8 b - - 0 1", 5},
+        {"8/k5r1/3P4/2p5/2P2P2/3P4/K6Q/2B4B w - - 0 1", 5},
+    };
+}
+
+/**
+ * @brief Answers "can the player to move mate in at most N moves?" with the proof-number solver, and prints the
+ *     shortest mating line found. With "checks", only mates by successive checks are looked for.
+ *     Usage: main mate <moves> [checks] [FEN]   (the start position without a FEN)
+ * @return 0 if the query was answered, 1 if the arguments are invalid
+ */
+int solveMate(const std::vector<std::string>& args) {
+    const int moves = args.empty() ? 0 : std::atoi(args[0].c_str());
+    if (moves < 1 || moves > MateSolver::MAX_MOVES) {
+        std::cerr << "usage: mate <moves> [checks] [FEN]" << std::endl;
+        return 1;
+    }
+    const bool checks_only = args.size() > 1 && args[1] == "checks";
+    std::unique_ptr<ChessBoard> board = loadPosition(args, checks_only ? 2 : 1);
+    if (!board) { return 1; }
+
+    const auto start = std::chrono::steady_clock::now();
+    MateSolver solver(MATE_HASH_MEGABYTES, checks_only);
+    std::vector<Move> line;
+    const MateSolver::Result result = solver.findMate(*board, moves, 0, line);
+    const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (result == MateSolver::PROVEN) {
+        std::cout << "mate in " << (line.size() + 1) / 2 << ":";
+        for (const Move& move : line) { std::cout << " " << Notation::moveName(move); }
+        std::cout << std::endl;
+    } else {
+        std::cout << "no mate in " << moves << std::endl;
+    }
+    std::cout << solver.getNodes() << " nodes in " << millis << "ms" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Solves every puzzle of the bundled suite, checking the length of each mate found, and times the solver against
+ *     an alpha-beta search to the depth the mate needs.
+ *     Usage: main matebench [checks]
+ * @return 0 if every mate was found with its expected length, 1 otherwise
+ */
+int benchMateSolver(const std::vector<std::string>& args) {
+    const bool checks_only = !args.empty() && args[0] == "checks";
+    MateSolver solver(MATE_HASH_MEGABYTES, checks_only);
+    TranspositionTable table(MATE_HASH_MEGABYTES);
+
+    int failures = 0;
+    long long solver_nodes = 0;
+    long long search_nodes = 0;
+    double solver_millis = 0;
+    double search_millis = 0;
+    for (const MatePuzzle& puzzle : MATE_PUZZLES) {
+        std::unique_ptr<ChessBoard> board = ChessBoard::fromFen(puzzle.fen);
+
+        // Each puzzle starts from empty tables, so the times don't depend on the order of the suite
+        solver.clear();
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Move> line;
+        const MateSolver::Result result = solver.findMate(*board, puzzle.moves, 0, line);
+        const double solved = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const int found = result == MateSolver::PROVEN ? static_cast<int>(line.size() + 1) / 2 : 0;
+
+        table.clear();
+        start = std::chrono::steady_clock::now();
+        Search search(*board, table);
+        SearchLimits limits;
+        limits.depth = 2 * puzzle.moves - 1;
+        int score = 0;
+        search.run(limits, [&score] (const SearchInfo& info) {
+            if (!info.pv.empty()) { score = info.score; }
+        });
+        const double searched = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const int announced = (Search::isMateScore(score) && score > 0) ? (Search::MATE_SCORE - score + 1) / 2 : 0;
+
+        // Only mates by successive checks can be found with "checks", so a longer (or no) mate is no failure there
+        const bool failed = checks_only ? (found != 0 && found < puzzle.moves) : found != puzzle.moves;
+        if (failed) { failures++; }
+        solver_nodes += solver.getNodes();
+        search_nodes += search.getNodes();
+        solver_millis += solved;
+        search_millis += searched;
+
+        std::cout << puzzle.fen << " | mate in " << puzzle.moves << ": solver " << (found ? std::to_string(found) : "-")
+            << " (" << solver.getNodes() << " nodes, " << solved << "ms), search " << (announced ? std::to_string(announced) : "-")
+            << " (" << search.getNodes() << " nodes, " << searched << "ms)" << (failed ? " FAILED" : "") << std::endl;
+    }
+
+    std::cout << "solver: " << solver_nodes << " nodes in " << solver_millis << "ms" << std::endl;
+    std::cout << "search: " << search_nodes << " nodes in " << search_millis << "ms" << std::endl;
+    std::cout << failures << " of " << sizeof(MATE_PUZZLES) / sizeof(MATE_PUZZLES[0]) << " puzzles failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include "Commands.hpp"
+#include "../search/Evaluator.hpp"
+#include "../search/NnueAccumulator.hpp"
+#include "../search/NnueNetwork.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    // What evaluateTree() computes at each node
+    enum class EvalMode { NONE, INCREMENTAL, FROM_SCRATCH, HANDCRAFTED, VERIFY };
+
+    struct EvalTally {
+        long long nodes = 0;
+        long long sum = 0;          // Keeps the evaluations from being optimized away
+        long long mismatches = 0;
+    };
+}
+
+/**
+ * @brief Writes an NNUE weights file equivalent to the handcrafted evaluation, to seed training or to check the NNUE code.
+ *     Usage: main nnuegen <file>
+ * @return 0 if the file was written, 1 otherwise
+ */
+int generateNetwork(const std::vector<std::string>& args) {
+    if (args.size() != 1) {
+        std::cerr << "usage: nnuegen <file>" << std::endl;
+        return 1;
+    }
+    if (!NnueNetwork::writeMaterialNetwork(args[0])) {
+        std::cerr << "could not write " << args[0] << std::endl;
+        return 1;
+    }
+    std::cout << args[0] << ": " << NnueNetwork::INPUTS << "x" << NnueNetwork::HIDDEN << " network" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Walks the legal move tree of depth plies, pushing & popping accumulators along the way, & evaluates every node
+ *     (the root included) as mode says. VERIFY checks that all three evaluations agree.
+ * @post The board & the accumulator stack are back where they were
+ */
+void evaluateTree(ChessBoard& board, NnueAccumulator& accumulator, const int& depth, const EvalMode& mode, EvalTally& tally) {
+    tally.nodes++;
+    switch (mode) {
+        case EvalMode::NONE: break;
+        case EvalMode::INCREMENTAL: tally.sum += accumulator.evaluate(board); break;
+        case EvalMode::FROM_SCRATCH: tally.sum += accumulator.evaluateFromScratch(board); break;
+        case EvalMode::HANDCRAFTED: tally.sum += Evaluator::evaluate(board); break;
+        case EvalMode::VERIFY: {
+            const int incremental = accumulator.evaluate(board);
+            if (incremental != accumulator.evaluateFromScratch(board) || incremental != Evaluator::evaluate(board)) {
+                if (tally.mismatches++ == 0) { std::cerr << "first mismatch at " << board.toFen() << std::endl; }
+            }
+            break;
+        }
+    }
+    if (depth <= 0) { return; }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    for (const Move& move : moves) {
+        MoveUndo undo;
+        board.makeMove(move, undo);
+        if (mode != EvalMode::NONE) { accumulator.push(board, move, undo); }
+        evaluateTree(board, accumulator, depth - 1, mode, tally);
+        if (mode != EvalMode::NONE) { accumulator.pop(); }
+        board.unmakeMove(move, undo);
+    }
+}
+
+/**
+ * @brief Checks that incremental NNUE evaluation matches evaluating from scratch (& the handcrafted evaluation, for a
+ *     network written by nnuegen) over a move tree, then times each way of evaluating.
+ *     Usage: main evalbench <weights file> <depth> [FEN]
+ * @return 0 if every evaluation matched, 1 otherwise
+ */
+int benchEvaluation(const std::vector<std::string>& args) {
+    const int depth = args.size() < 2 ? 0 : std::atoi(args[1].c_str());
+    if (depth < 1) {
+        std::cerr << "usage: evalbench <weights file> <depth> [FEN]" << std::endl;
+        return 1;
+    }
+    NnueNetwork network;
+    if (!network.load(args[0])) {
+        std::cerr << "could not load " << args[0] << std::endl;
+        return 1;
+    }
+    std::unique_ptr<ChessBoard> board = loadPosition(args, 2);
+    if (!board) { return 1; }
+    NnueAccumulator accumulator(network);
+
+    auto walk = [&] (const EvalMode& mode) {
+        accumulator.reset(*board);
+        EvalTally tally;
+        const auto start = std::chrono::steady_clock::now();
+        evaluateTree(*board, accumulator, depth, mode, tally);
+        return std::make_pair(tally, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    };
+
+    const EvalTally verified = walk(EvalMode::VERIFY).first;
+    std::cout << "nodes " << verified.nodes << " mismatches " << verified.mismatches << std::endl;
+
+    // Each rate leaves out the time spent walking the tree itself
+    const double baseline = walk(EvalMode::NONE).second;
+    auto report = [&] (const std::string& name, const EvalMode& mode) {
+        const auto result = walk(mode);
+        const double seconds = std::max(result.second - baseline, 1e-9);
+        std::cout << name << ": " << result.second << "s, " << static_cast<long long>(result.first.nodes / seconds) << " evals/s" << std::endl;
+    };
+    if (NnueNetwork::setAvx2(true)) { report("nnue incremental avx2", EvalMode::INCREMENTAL); }
+    NnueNetwork::setAvx2(false);
+    report("nnue incremental scalar", EvalMode::INCREMENTAL);
+    NnueNetwork::setAvx2(true);
+    report("nnue from scratch", EvalMode::FROM_SCRATCH);
+    report("handcrafted", EvalMode::HANDCRAFTED);
+    std::cout << "tree walk: " << baseline << "s" << std::endl;
+    return verified.mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#include "Commands.hpp"
+#include "../search/Perft.hpp"
+#include "../search/PerftHash.hpp"
+#include "../search/VariantPerft.hpp"
+#include "../Notation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    /**
+     * @brief Counts the legal move tree of a FEN position to depth plies
+     * @return The count, or 0 if the FEN is not a valid position
+     */
+    using Counter = uint64_t (*)(const char* fen, const int& depth);
+
+    uint64_t countStandard(const char* fen, const int& depth) {
+        std::unique_ptr<ChessBoard> board = ChessBoard::fromFen(fen);
+        return board ? Perft::count(*board, depth) : 0;
+    }
+
+    template <class Geometry>
+    uint64_t countVariant(const char* fen, const typename VariantPerft<Geometry>::Rules& rules, const int& depth) {
+        typename VariantPerft<Geometry>::Position position;
+        return VariantPerft<Geometry>::fromFen(fen, position) ? VariantPerft<Geometry>::count(position, rules, depth) : 0;
+    }
+
+    // VariantPerft on the standard board, to check the generator the variants share against the published counts
+    uint64_t countGeneric(const char* fen, const int& depth) { return countVariant<StandardBoard>(fen, {true, "QRBN"}, depth); }
+    uint64_t countCapablanca(const char* fen, const int& depth) { return countVariant<CapablancaBoard>(fen, {true, "QRBNAC"}, depth); }
+    uint64_t countLosAlamos(const char* fen, const int& depth) { return countVariant<MiniBoard>(fen, {false, "QRN"}, depth); }
+
+    /**
+     * @brief A position of the perftsuite suite, whose legal move tree to depth plies has nodes leaves
+     */
+    struct PerftPosition {
+        const char* name;
+        const char* fen;
+        int depth;
+        uint64_t nodes;
+        Counter count;
+    };
+
+    // The standard perft positions, whose counts are published & agreed on by many engines. Between them they cover
+    // castling (& the loss of castling rights), en passant (including discovered checks along the rank) & promotions.
+    //
+    // The variant positions exercise the other board geometries through VariantPerft, which does not castle: none of
+    // them can castle within its depth. The Capablanca count is published; Los Alamos has no agreed-on counts, so its
+    // count is the one VariantPerft gives, once its standard-board counts match the published ones.
+    const PerftPosition PERFT_POSITIONS[] = {
+        {"start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609, countStandard},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603, countStandard},
+        {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083, countStandard},
+        {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333, countStandard},
+        {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487, countStandard},
+        {"position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594, countStandard},
+        {"start, generic", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1", 5, 4865609, countGeneric},
+        {"position 3, generic", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083, countGeneric},
+        {"capablanca", "rnabqkbcnr/pppppppppp/10/10/10/10/PPPPPPPPPP/RNABQKBCNR w - - 0 1", 4, 805128, countCapablanca},
+        {"los alamos", "rnqknr/pppppp/6/6/PPPPPP/RNQKNR w - - 0 1", 5, 191846, countLosAlamos},
+    };
+}
+
+/**
+ * @brief Prints the count of each root move, then the total & its speed
+ * @return The total count
+ */
+uint64_t printDivide(const std::vector<std::pair<Move, uint64_t>>& counts, const double& seconds) {
+    uint64_t nodes = 0;
+    for (const auto& entry : counts) {
+        std::cout << Notation::moveName(entry.first) << ": " << entry.second << std::endl;
+        nodes += entry.second;
+    }
+    std::cout << "nodes " << nodes << " seconds " << seconds << " nps " << static_cast<long long>(nodes / std::max(seconds, 1e-9)) << std::endl;
+    return nodes;
+}
+
+/**
+ * @brief Counts the legal move tree of a position & prints the count of each root move.
+ *     Usage: main perft <depth> [FEN]   (the start position without a FEN)
+ * @return 0 on success, 1 if the arguments are invalid
+ */
+int runPerft(const std::vector<std::string>& args) {
+    const int depth = args.empty() ? 0 : std::atoi(args[0].c_str());
+    if (depth < 1) {
+        std::cerr << "usage: perft <depth> [FEN]" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<ChessBoard> board = loadPosition(args, 1);
+    if (!board) { return 1; }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto counts = Perft::divide(*board, depth);
+    printDivide(counts, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return 0;
+}
+
+/**
+ * @brief Counts the legal move tree of a position on several threads sharing a hash table of subtree counts, & prints
+ *     the count of each root move and the hash hit rate.
+ *     Usage: main pperft <depth> <threads> <hash MB> [FEN]   (0 threads uses one per hardware thread)
+ * @return 0 on success, 1 if the arguments are invalid
+ */
+int runParallelPerft(const std::vector<std::string>& args) {
+    const int depth = args.size() < 3 ? 0 : std::atoi(args[0].c_str());
+    if (depth < 1) {
+        std::cerr << "usage: pperft <depth> <threads> <hash MB> [FEN]" << std::endl;
+        return 1;
+    }
+    const unsigned threads = static_cast<unsigned>(std::atoi(args[1].c_str()));
+    const size_t megabytes = static_cast<size_t>(std::atoll(args[2].c_str()));
+
+    std::unique_ptr<ChessBoard> board = loadPosition(args, 3);
+    if (!board) { return 1; }
+
+    PerftHash hash(megabytes);
+    Perft::Stats stats;
+    const auto start = std::chrono::steady_clock::now();
+    const auto counts = Perft::divide(*board, depth, threads, hash, stats);
+    printDivide(counts, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    std::cout << "hash entries " << hash.size() << " probes " << stats.probes << " hits " << stats.hits << " hit rate "
+        << (stats.probes ? 100.0 * stats.hits / stats.probes : 0.0) << "%" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Counts the legal move tree of every position of the bundled suite & checks each count against its published
+ *     value, so that a change to move generation can be checked in one run.
+ *     Usage: main perftsuite
+ * @return 0 if every count matched, 1 otherwise
+ */
+int runPerftSuite(const std::vector<std::string>& args) {
+    if (!args.empty()) {
+        std::cerr << "usage: perftsuite" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    uint64_t total = 0;
+    double total_seconds = 0;
+    for (const PerftPosition& position : PERFT_POSITIONS) {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t nodes = position.count(position.fen, position.depth);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const bool failed = nodes != position.nodes;
+        if (failed) { failures++; }
+        total += nodes;
+        total_seconds += seconds;
+        std::cout << position.name << " | depth " << position.depth << ": " << nodes << " nodes (expected " << position.nodes
+            << "), " << seconds << "s" << (failed ? " FAILED" : "") << std::endl;
+    }
+
+    std::cout << "nodes " << total << " seconds " << total_seconds << " nps "
+        << static_cast<long long>(total / std::max(total_seconds, 1e-9)) << std::endl;
+    std::cout << failures << " of " << sizeof(PERFT_POSITIONS) / sizeof(PERFT_POSITIONS[0]) << " positions failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#include "Commands.hpp"
+#include "../server/GameServer.hpp"
+#include "../server/LoadGenerator.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Runs simulated clients against a GameServer and reports move latency.
+ *     Usage: main loadtest [clients] [games per client] [moves] [worker threads] [random | scripted]
+ *     The scripted scenario replays a game with castling, en passant & a promotion (see LoadGenerator).
+ * @return 0, or 1 if a move of the scripted scenario was rejected
+ */
+int runLoadTest(const std::vector<std::string>& args) {
+    LoadGenerator::Options options;
+    unsigned threads = 0;
+    if (args.size() > 0) { options.clients = std::stoi(args[0]); }
+    if (args.size() > 1) { options.games_per_client = std::stoi(args[1]); }
+    if (args.size() > 2) { options.moves = std::stoll(args[2]); }
+    if (args.size() > 3) { threads = static_cast<unsigned>(std::stoi(args[3])); }
+    if (args.size() > 4) { options.scripted = args[4] == "scripted"; }
+
+    GameServer server(options.clients * options.games_per_client, threads);
+    LoadGenerator generator(server, options);
+    const LoadGenerator::Report report = generator.run();
+    LoadGenerator::print(report, std::cout);
+    return options.scripted && report.rejected > 0 ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+#include "Commands.hpp"
+#include "../tablebase/TablebaseGenerator.hpp"
+
+#include <iostream>
+
+/**
+ * @brief Generates endgame tablebases.
+ *     Usage: main tbgen <directory> <SIGNATURE>...   (eg. main tbgen tables KQK KRK KPK)
+ * @return 0 if every table was generated, 1 otherwise
+ */
+int generateTablebases(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cerr << "usage: tbgen <directory> <SIGNATURE>..." << std::endl;
+        return 1;
+    }
+
+    TablebaseGenerator generator(args[0]);
+    for (size_t i = 1; i < args.size(); i++) {
+        if (!generator.generate(args[i])) {
+            std::cerr << "could not generate " << args[i] << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
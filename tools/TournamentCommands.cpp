@@ -0,0 +1,87 @@
+#include "Commands.hpp"
+#include "../tournament/SelfPlay.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Parses an engine configuration of selfplay: comma-separated key=value pairs among name, depth, nodes,
+ *     movetime (ms), time & inc (a clock, in ms per game & per move), hash (MB) & eval (an NNUE weights file, loaded
+ *     into networks). eg. "name=nnue,depth=6,eval=net.nnue" or "name=blitz,time=10000,inc=100"
+ * @return False (after printing an error) if a pair is invalid or the weights cannot be loaded
+ */
+bool parseEngine(const std::string& spec, EngineConfig& config, std::vector<std::unique_ptr<NnueNetwork>>& networks) {
+    std::istringstream stream(spec);
+    for (std::string pair; std::getline(stream, pair, ','); ) {
+        const size_t equals = pair.find('=');
+        const std::string key = pair.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : pair.substr(equals + 1);
+        if (key == "name") { config.name = value; }
+        else if (key == "depth") { config.limits.depth = std::atoi(value.c_str()); }
+        else if (key == "nodes") { config.limits.nodes = std::atoll(value.c_str()); }
+        else if (key == "movetime") { config.limits.movetime = std::atoll(value.c_str()); }
+        else if (key == "hash") { config.hash_megabytes = static_cast<size_t>(std::atoll(value.c_str())); }
+        else if (key == "time") { config.time = std::atoll(value.c_str()); }
+        else if (key == "inc") { config.increment = std::atoll(value.c_str()); }
+        else if (key == "eval") {
+            networks.emplace_back(new NnueNetwork());
+            if (!networks.back()->load(value)) {
+                std::cerr << "could not load " << value << std::endl;
+                return false;
+            }
+            config.network = networks.back().get();
+        } else {
+            std::cerr << "invalid engine option " << pair << std::endl;
+            return false;
+        }
+    }
+    if (config.name.empty()) { config.name = spec; }
+    return true;
+}
+
+/**
+ * @brief Plays a match between two engine configurations on every core, streaming each result, until the SPRT of
+ *     H0: elo0 vs H1: elo1 (0 & 5 by default) is decided or every game is played.
+ *     Usage: main selfplay <first> <second> <games> <openings | -> <archive | -> [elo0 elo1]
+ *     (see parseEngine() for the configurations; "-" plays from the starting position / keeps no archive)
+ * @return 0 when the match is over, 1 if the arguments are invalid
+ */
+int runSelfPlay(const std::vector<std::string>& args) {
+    if (args.size() != 5 && args.size() != 7) {
+        std::cerr << "usage: selfplay <first> <second> <games> <openings | -> <archive | -> [elo0 elo1]" << std::endl;
+        return 1;
+    }
+
+    EngineConfig engines[2];
+    std::vector<std::unique_ptr<NnueNetwork>> networks;
+    if (!parseEngine(args[0], engines[0], networks) || !parseEngine(args[1], engines[1], networks)) { return 1; }
+
+    SelfPlay::Options options;
+    options.games = std::atoi(args[2].c_str());
+    if (args.size() == 7) {
+        options.elo0 = std::atof(args[5].c_str());
+        options.elo1 = std::atof(args[6].c_str());
+    }
+
+    std::vector<std::string> openings;
+    if (args[3] != "-" && SelfPlay::loadOpenings(args[3], openings) < 0) {
+        std::cerr << "could not read " << args[3] << std::endl;
+        return 1;
+    }
+
+    GameArchiveWriter archive;
+    if (args[4] != "-" && !archive.open(args[4])) {
+        std::cerr << "could not write " << args[4] << std::endl;
+        return 1;
+    }
+
+    SelfPlay match(engines[0], engines[1], openings, options);
+    const SelfPlay::Summary summary = match.run(args[4] != "-" ? &archive : nullptr, std::cout);
+    if (args[4] != "-") { archive.close(); }
+
+    const char* verdicts[] = {"undecided", "H0 accepted", "H1 accepted"};
+    std::cout << engines[0].name << " vs " << engines[1].name << ": +" << summary.wins << " =" << summary.draws << " -"
+        << summary.losses << ", llr " << summary.llr << ", " << verdicts[summary.status] << " in " << summary.seconds << "s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "Commands.hpp"
+#include "../training/PositionReader.hpp"
+#include "../training/TrainingSetBuilder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+/**
+ * @brief Packs every position of a binary game archive, labelled with its game's result, into shuffled chunk files
+ *     named <prefix>-00000.p4pp, <prefix>-00001.p4pp, ...
+ *     Usage: main posgen <archive> <prefix> [positions per chunk]
+ * @return 0 if every chunk was written, 1 otherwise
+ */
+int generatePositions(const std::vector<std::string>& args) {
+    if (args.size() != 2 && args.size() != 3) {
+        std::cerr << "usage: posgen <archive> <prefix> [positions per chunk]" << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    PositionWriter writer;
+    writer.open(args[1], args.size() == 3 ? static_cast<size_t>(std::atoll(args[2].c_str())) : PositionWriter::DEFAULT_CHUNK_POSITIONS);
+    const long long positions = TrainingSetBuilder().extract(args[0], writer);
+    if (!writer.close() || positions < 0) {
+        std::cerr << "could not extract " << args[0] << " into " << args[1] << std::endl;
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << positions << " positions in " << writer.chunks() << " chunks in " << seconds << "s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Copies chunk files of packed positions into new shuffled chunk files without repeated positions.
+ *     Usage: main posdedup <prefix> <chunk files...>
+ * @return 0 if every chunk was read & written, 1 otherwise
+ */
+int deduplicatePositions(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cerr << "usage: posdedup <prefix> <chunk files...>" << std::endl;
+        return 1;
+    }
+
+    // Size the filter for the worst case, where every position is distinct
+    const std::vector<std::string> chunks(args.begin() + 1, args.end());
+    uint64_t total = 0;
+    for (const std::string& chunk : chunks) {
+        std::ifstream in(chunk, std::ios::binary);
+        const long long positions = PositionReader::readHeader(in);
+        if (positions < 0) {
+            std::cerr << "could not read " << chunk << std::endl;
+            return 1;
+        }
+        total += static_cast<uint64_t>(positions);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    PositionWriter writer;
+    writer.open(args[0]);
+    long long duplicates = 0;
+    const long long positions = TrainingSetBuilder().deduplicate(chunks, writer, total, duplicates);
+    if (!writer.close() || positions < 0) {
+        std::cerr << "could not deduplicate into " << args[0] << std::endl;
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << positions << " positions kept, " << duplicates << " duplicates dropped in " << seconds << "s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Checks PositionWriter under contention: several threads write numbered positions in uneven batches into tiny
+ *     chunks, then every chunk is read back to check that each one but the last is full & that every position was
+ *     written exactly once. The chunk files are removed afterwards.
+ *     Usage: main poscheck <prefix> [threads] [positions per chunk]
+ * @return 0 if every check passed, 1 otherwise
+ */
+int checkPositionWriter(const std::vector<std::string>& args) {
+    if (args.empty() || args.size() > 3) {
+        std::cerr << "usage: poscheck <prefix> [threads] [positions per chunk]" << std::endl;
+        return 1;
+    }
+    const unsigned threads = args.size() > 1 ? static_cast<unsigned>(std::max(1, std::atoi(args[1].c_str()))) : 8;
+    const size_t chunk_positions = args.size() > 2 ? static_cast<size_t>(std::max(1, std::atoi(args[2].c_str()))) : 7;
+    const uint64_t per_thread = 20000;
+
+    // Each position is numbered by its occupied field: producer in the high half, index in the low half
+    PositionWriter writer;
+    writer.open(args[0], chunk_positions);
+    std::vector<std::thread> producers;
+    for (unsigned t = 0; t < threads; t++) {
+        producers.emplace_back([&writer, t, per_thread] () {
+            PackedPosition batch[13];
+            std::memset(batch, 0, sizeof(batch));
+            for (uint64_t i = 0, size = 1; i < per_thread; i += size, size = size % 13 + 1) {
+                size = std::min<uint64_t>(size, per_thread - i);
+                for (uint64_t j = 0; j < size; j++) { batch[j].occupied = (uint64_t{t} << 32) | (i + j); }
+                writer.write(batch, static_cast<size_t>(size));
+            }
+        });
+    }
+    for (std::thread& producer : producers) { producer.join(); }
+    const bool closed = writer.close();
+
+    std::vector<std::string> paths;
+    int failures = closed ? 0 : 1;
+    for (size_t chunk = 0; chunk < writer.chunks(); chunk++) {
+        paths.push_back(PositionWriter::chunkPath(args[0], chunk));
+        std::ifstream in(paths.back(), std::ios::binary);
+        const long long positions = PositionReader::readHeader(in);
+        const bool last = chunk + 1 == writer.chunks();
+        if (positions <= 0 || (!last && static_cast<size_t>(positions) != chunk_positions)) {
+            std::cerr << paths.back() << ": " << positions << " positions, expected " << chunk_positions << std::endl;
+            failures++;
+        }
+    }
+
+    std::vector<uint8_t> seen(threads * per_thread, 0);
+    PositionReader reader;
+    reader.open(paths);
+    for (std::vector<PackedPosition> batch; reader.next(batch); ) {
+        for (const PackedPosition& position : batch) {
+            const uint64_t producer = position.occupied >> 32;
+            const uint64_t index = position.occupied & 0xFFFFFFFFULL;
+            if (producer >= threads || index >= per_thread) { failures++; continue; }
+            seen[producer * per_thread + index]++;
+        }
+    }
+    if (reader.failed()) { failures++; }
+    reader.close();
+    const long long wrong = std::count_if(seen.begin(), seen.end(), [] (const uint8_t& count) { return count != 1; });
+    if (wrong > 0) {
+        std::cerr << wrong << " positions missing or repeated" << std::endl;
+        failures++;
+    }
+    for (const std::string& path : paths) { std::remove(path.c_str()); }
+
+    std::cout << writer.size() << " positions from " << threads << " threads in " << writer.chunks() << " chunks of "
+        << chunk_positions << ": " << (failures ? "FAILED" : "ok") << std::endl;
+    return failures ? 1 : 0;
+}
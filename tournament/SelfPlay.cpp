@@ -0,0 +1,258 @@
+#include "SelfPlay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    const int FIFTY_MOVE_PLIES = 100;
+    const int REPETITIONS = 3;
+
+    /**
+     * @brief Sets up the board a game starts from
+     */
+    std::unique_ptr<ChessBoard> startingBoard(const std::string& fen) {
+        return fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(fen);
+    }
+}
+
+/**
+ * @brief Constructs a match
+ * @param openings FENs to start games from. The standard starting position is used if there are none.
+ */
+SelfPlay::SelfPlay(const EngineConfig& first, const EngineConfig& second, const std::vector<std::string>& openings,
+    const Options& options) : engines_{first, second}, openings_{openings}, options_{options},
+    sprt_{options.elo0, options.elo1, options.alpha, options.beta}, next_game_{0}, stop_{false} {
+    if (openings_.empty()) { openings_.push_back(""); }
+    if (options_.threads == 0) { options_.threads = std::max(1u, std::thread::hardware_concurrency()); }
+    options_.games += options_.games % 2;
+}
+
+/**
+ * @brief Reads opening positions, one FEN (or EPD, whose first four fields are a FEN) per line. Blank lines & lines
+ *     starting with '#' are skipped, as are positions that are invalid or already over.
+ * @return The number of positions added, or -1 if the file could not be opened
+ */
+int SelfPlay::loadOpenings(const std::string& path, std::vector<std::string>& openings) {
+    std::ifstream in(path);
+    if (!in) { return -1; }
+
+    int added = 0;
+    for (std::string line; std::getline(in, line); ) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') { continue; }
+
+        // EPD operations (eg. "bm e4; id ...") follow the fourth field
+        std::istringstream stream(line);
+        std::string fen;
+        std::string field;
+        for (int fields = 0; fields < 6 && stream >> field && field.find(';') == std::string::npos; fields++) {
+            if (fields >= 4 && field.find_first_not_of("0123456789") != std::string::npos) { break; }
+            fen += (fen.empty() ? "" : " ") + field;
+        }
+
+        std::unique_ptr<ChessBoard> board = ChessBoard::fromFen(fen);
+        if (!board) { continue; }
+        MoveList moves;
+        board->generateLegalMoves(moves);
+        if (moves.empty()) { continue; }
+
+        openings.push_back(board->toFen());
+        added++;
+    }
+    return added;
+}
+
+/**
+ * @brief Plays the match
+ * @param archive Receives every finished game, if not null
+ * @param out Receives a line per finished game
+ */
+SelfPlay::Summary SelfPlay::run(GameArchiveWriter* archive, std::ostream& out) {
+    const auto start = std::chrono::steady_clock::now();
+    next_game_ = 0;
+    stop_ = false;
+    summary_ = Summary();
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < options_.threads; t++) {
+        threads.emplace_back([this, archive, &out] {
+            // Each configuration keeps its own table, cleared between games so that games don't depend on each other
+            TranspositionTable tables[2] = {TranspositionTable(engines_[0].hash_megabytes), TranspositionTable(engines_[1].hash_megabytes)};
+            while (!stop_.load()) {
+                const int game = next_game_.fetch_add(1);
+                if (game >= options_.games) { break; }
+
+                tables[0].clear();
+                tables[1].clear();
+                std::string reason;
+                const GameRecord record = play(game, tables, reason);
+                report(game, record, reason, archive, out);
+            }
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+
+    summary_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary_;
+}
+
+/**
+ * @brief Plays one game of the match
+ * @param game The game's number, which picks its opening & colours
+ * @param tables The transposition tables of the first [0] & second [1] configuration
+ * @param reason Set to what ended the game
+ * @return The game, which starts from its opening's FEN (empty for the standard starting position)
+ */
+GameRecord SelfPlay::play(const int& game, TranspositionTable* tables, std::string& reason) const {
+    GameRecord record;
+    record.fen = openings_[(game / 2) % openings_.size()];
+    std::unique_ptr<ChessBoard> board = startingBoard(record.fen);
+
+    // The first configuration plays player one in even games, player two in odd ones
+    const int player_one_engine = game % 2;
+
+    // Positions since the last capture or Pawn move, the only ones that can repeat
+    std::unordered_map<uint64_t, int> seen;
+    seen[board->getHash()]++;
+    int quiet_plies = 0;
+
+    // Clocks of player one [0] & player two [1], for configurations that have one
+    long long clocks[2] = {engines_[player_one_engine].time, engines_[player_one_engine ^ 1].time};
+
+    int resign_plies = 0;
+    bool resign_for_player_one = false;
+    int draw_plies = 0;
+
+    const auto finish = [&] (const GameRecord::Result& result, const std::string& why) {
+        record.result = result;
+        reason = why;
+        return record;
+    };
+
+    MoveList moves;
+    while (true) {
+        const bool player_one = board->isPlayerOneTurn();
+        moves.clear();
+        board->generateLegalMoves(moves);
+        if (moves.empty()) {
+            if (!board->isInCheck(player_one)) { return finish(GameRecord::DRAW, "stalemate"); }
+            return finish(player_one ? GameRecord::PLAYER_TWO_WINS : GameRecord::PLAYER_ONE_WINS, "checkmate");
+        }
+        if (quiet_plies >= FIFTY_MOVE_PLIES) { return finish(GameRecord::DRAW, "fifty moves"); }
+        if (isInsufficientMaterial(*board)) { return finish(GameRecord::DRAW, "insufficient material"); }
+        if (static_cast<int>(record.moves.size()) >= options_.max_plies) { return finish(GameRecord::DRAW, "adjudication: length"); }
+
+        const int engine = player_one ? player_one_engine : player_one_engine ^ 1;
+        const int side = player_one ? 0 : 1;
+        const bool timed = engines_[engine].time > 0;
+        SearchLimits limits = engines_[engine].limits;
+        if (timed) {
+            limits.time[side] = clocks[side];
+            limits.increment[side] = engines_[engine].increment;
+        }
+
+        int score = 0;
+        Search search(*board, tables[engine]);
+        search.setNetwork(engines_[engine].network);
+        const auto start = std::chrono::steady_clock::now();
+        Move best = search.run(limits, [&score] (const SearchInfo& info) {
+            if (!info.pv.empty()) { score = info.score; }
+        });
+        if (best.isNone()) { best = moves.front(); }    // Only if the limits allowed no search at all
+
+        if (timed) {
+            clocks[side] -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            if (clocks[side] < 0) { return finish(player_one ? GameRecord::PLAYER_TWO_WINS : GameRecord::PLAYER_ONE_WINS, "time forfeit"); }
+            clocks[side] += engines_[engine].increment;
+        }
+
+        // Both engines' scores must agree in a row, so each adjudication counts plies from either side
+        const bool winning = score >= options_.resign_score;
+        const bool losing = score <= -options_.resign_score;
+        if (winning || losing) {
+            const bool for_player_one = winning == player_one;
+            resign_plies = (resign_plies > 0 && resign_for_player_one == for_player_one) ? resign_plies + 1 : 1;
+            resign_for_player_one = for_player_one;
+        } else {
+            resign_plies = 0;
+        }
+        const int ply = static_cast<int>(record.moves.size());
+        draw_plies = (ply >= options_.draw_start && std::abs(score) <= options_.draw_score) ? draw_plies + 1 : 0;
+
+        const ChessPiece* mover = board->getCell(best.row(), best.col());
+        const bool irreversible = mover->getSymbol() == 'P' || board->isCapture(best);
+        board->move(best);
+        record.moves.push_back(best);
+
+        if (irreversible) {
+            seen.clear();
+            quiet_plies = 0;
+        } else {
+            quiet_plies++;
+        }
+        if (++seen[board->getHash()] >= REPETITIONS) { return finish(GameRecord::DRAW, "repetition"); }
+
+        if (options_.resign_plies > 0 && resign_plies >= options_.resign_plies) {
+            return finish(resign_for_player_one ? GameRecord::PLAYER_ONE_WINS : GameRecord::PLAYER_TWO_WINS, "adjudication: resign");
+        }
+        if (options_.draw_plies > 0 && draw_plies >= options_.draw_plies) { return finish(GameRecord::DRAW, "adjudication: draw"); }
+    }
+}
+
+/**
+ * @brief Adds a finished game to the totals, the archive & the output, and checks the Sprt
+ */
+void SelfPlay::report(const int& game, const GameRecord& record, const std::string& reason, GameArchiveWriter* archive, std::ostream& out) {
+    const bool first_is_player_one = game % 2 == 0;
+    std::lock_guard<std::mutex> lock(results_mutex_);
+
+    const char* result = "1/2-1/2";
+    if (record.result == GameRecord::PLAYER_ONE_WINS) {
+        (first_is_player_one ? summary_.wins : summary_.losses)++;
+        result = "1-0";
+    } else if (record.result == GameRecord::PLAYER_TWO_WINS) {
+        (first_is_player_one ? summary_.losses : summary_.wins)++;
+        result = "0-1";
+    } else {
+        summary_.draws++;
+    }
+    if (archive) { archive->write(record); }
+
+    double margin;
+    const double elo = Sprt::elo(summary_.wins, summary_.draws, summary_.losses, margin);
+    summary_.llr = sprt_.llr(summary_.wins, summary_.draws, summary_.losses);
+    summary_.status = sprt_.status(summary_.wins, summary_.draws, summary_.losses);
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "game %d: %s - %s %s (%s, %zu plies) | +%lld =%lld -%lld | elo %.1f +/- %.1f | llr %.2f [%.2f, %.2f]",
+        game + 1, engines_[first_is_player_one ? 0 : 1].name.c_str(), engines_[first_is_player_one ? 1 : 0].name.c_str(), result,
+        reason.c_str(), record.moves.size(), summary_.wins, summary_.draws, summary_.losses, elo, margin, summary_.llr,
+        sprt_.lowerBound(), sprt_.upperBound());
+    out << line << std::endl;
+
+    if (options_.sprt && summary_.status != Sprt::CONTINUE) { stop_ = true; }
+}
+
+/**
+ * @brief Determines if neither side has enough material left to mate
+ */
+bool SelfPlay::isInsufficientMaterial(const ChessBoard& board) {
+    // Bare Kings, or Kings & a single minor piece
+    int minors = 0;
+    for (int row = 0; row < GameBoard::ROWS; row++) {
+        for (int col = 0; col < GameBoard::COLS; col++) {
+            const ChessPiece* piece = board.getCell(row, col);
+            if (!piece || piece->getSymbol() == 'K') { continue; }
+            if (piece->getSymbol() != 'N' && piece->getSymbol() != 'B') { return false; }
+            if (++minors > 1) { return false; }
+        }
+    }
+    return true;
+}
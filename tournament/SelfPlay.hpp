@@ -0,0 +1,123 @@
+/**
+ * @class SelfPlay
+ * @brief Plays a match between two engine configurations on several threads, to measure whether a change helps.
+ *
+ * Each thread plays whole games, one at a time, with a ChessBoard as the arbiter: it generates the legal moves, spots
+ * checkmate & stalemate, and the match adds the draws the board does not track (fifty moves, threefold repetition,
+ * insufficient material). Games are played in pairs from each opening, with colours swapped, so that an unbalanced
+ * opening favours neither configuration. Games whose outcome is clear are adjudicated:
+ * - resigned once both engines agree (for resign_plies plies in a row) that one side is up resign_score or more
+ * - drawn once both engines see a score within draw_score for draw_plies plies in a row, after draw_start plies
+ * - drawn after max_plies plies
+ * A configuration with a clock searches under it (see TimeManager) and loses the game if it runs out of time.
+ *
+ * Every finished game is streamed as a line of text (result, running score, Elo estimate & LLR) and appended to an
+ * optional game archive. The match stops early as soon as its Sprt reaches a decision.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Sprt.hpp"
+#include "../archive/GameArchiveWriter.hpp"
+#include "../archive/GameRecord.hpp"
+#include "../search/NnueNetwork.hpp"
+#include "../search/Search.hpp"
+
+/**
+ * @brief One side of a match
+ */
+struct EngineConfig {
+    std::string name;
+    SearchLimits limits;                    // Per move. Fixed depths or node counts keep games reproducible.
+    long long time = 0;                     // Milliseconds on the clock at the start of a game, or 0 for no clock
+    long long increment = 0;                // Milliseconds added to the clock after each move
+    size_t hash_megabytes = 16;             // Transposition table size, per game being played
+    const NnueNetwork* network = nullptr;   // Evaluates with Evaluator when null
+};
+
+class SelfPlay {
+    public:
+        struct Options {
+            int games = 1000;           // Most games to play (rounded up to whole pairs)
+            unsigned threads = 0;       // Games played at once. 0 uses one per hardware thread.
+            int max_plies = 400;
+            int resign_score = 1000;
+            int resign_plies = 8;
+            int draw_score = 10;
+            int draw_plies = 16;
+            int draw_start = 80;
+            bool sprt = true;           // Stop as soon as the test below is decided
+            double elo0 = 0;
+            double elo1 = 5;
+            double alpha = 0.05;
+            double beta = 0.05;
+        };
+
+        /**
+         * @brief Totals of a match, from the first configuration's point of view
+         */
+        struct Summary {
+            long long wins = 0;
+            long long draws = 0;
+            long long losses = 0;
+            double llr = 0;
+            Sprt::Status status = Sprt::CONTINUE;
+            double seconds = 0;
+        };
+
+        /**
+         * @brief Constructs a match
+         * @param openings FENs to start games from. The standard starting position is used if there are none.
+         */
+        SelfPlay(const EngineConfig& first, const EngineConfig& second, const std::vector<std::string>& openings, const Options& options);
+
+        /**
+         * @brief Reads opening positions, one FEN (or EPD, whose first four fields are a FEN) per line. Blank lines & lines
+         *     starting with '#' are skipped, as are positions that are invalid or already over.
+         * @return The number of positions added, or -1 if the file could not be opened
+         */
+        static int loadOpenings(const std::string& path, std::vector<std::string>& openings);
+
+        /**
+         * @brief Plays the match
+         * @param archive Receives every finished game, if not null
+         * @param out Receives a line per finished game
+         */
+        Summary run(GameArchiveWriter* archive, std::ostream& out);
+
+    private:
+        EngineConfig engines_[2];
+        std::vector<std::string> openings_;
+        Options options_;
+        Sprt sprt_;
+
+        std::atomic<int> next_game_;
+        std::atomic<bool> stop_;
+        std::mutex results_mutex_;      // Guards summary_, the archive & the output stream
+        Summary summary_;
+
+        /**
+         * @brief Plays one game of the match
+         * @param game The game's number, which picks its opening & colours
+         * @param tables The transposition tables of the first [0] & second [1] configuration
+         * @param reason Set to what ended the game
+         * @return The game, which starts from its opening's FEN (empty for the standard starting position)
+         */
+        GameRecord play(const int& game, TranspositionTable* tables, std::string& reason) const;
+
+        /**
+         * @brief Adds a finished game to the totals, the archive & the output, and checks the Sprt
+         */
+        void report(const int& game, const GameRecord& record, const std::string& reason, GameArchiveWriter* archive, std::ostream& out);
+
+        /**
+         * @brief Determines if neither side has enough material left to mate
+         */
+        static bool isInsufficientMaterial(const ChessBoard& board);
+};
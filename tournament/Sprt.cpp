@@ -0,0 +1,82 @@
+#include "Sprt.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double MAX_ELO = 999;
+
+    // Expected score per game of a side that is elo Elo stronger
+    double expectedScore(const double& elo) {
+        return 1 / (1 + std::pow(10, -elo / 400));
+    }
+
+    // Inverse of expectedScore()
+    double eloOf(const double& score) {
+        if (score <= 0) { return -MAX_ELO; }
+        if (score >= 1) { return MAX_ELO; }
+        return std::max(-MAX_ELO, std::min(MAX_ELO, -400 * std::log10(1 / score - 1)));
+    }
+}
+
+/**
+ * @brief Constructs a test of H0: elo0 against H1: elo1
+ * @param alpha Probability of accepting H1 when H0 holds (false positive)
+ * @param beta Probability of accepting H0 when H1 holds (false negative)
+ */
+Sprt::Sprt(const double& elo0, const double& elo1, const double& alpha, const double& beta) : score0_{expectedScore(elo0)},
+    score1_{expectedScore(elo1)}, lower_{std::log(beta / (1 - alpha))}, upper_{std::log((1 - beta) / alpha)} {}
+
+/**
+ * @brief Computes the LLR of H1 over H0 for a match result, from the first engine's point of view
+ * @return 0 until both decisive and drawn outcomes can be told apart (ie. the score variance is not 0)
+ */
+double Sprt::llr(const long long& wins, const long long& draws, const long long& losses) const {
+    const double games = static_cast<double>(wins + draws + losses);
+    if (games == 0) { return 0; }
+
+    const double score = (wins + 0.5 * draws) / games;
+    const double variance = (wins * std::pow(1 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / games;
+    if (variance <= 0) { return 0; }
+    return games * (score1_ - score0_) * (2 * score - score0_ - score1_) / (2 * variance);
+}
+
+/**
+ * @brief Decides a match result, from the first engine's point of view
+ */
+Sprt::Status Sprt::status(const long long& wins, const long long& draws, const long long& losses) const {
+    const double ratio = llr(wins, draws, losses);
+    if (ratio >= upper_) { return ACCEPT_H1; }
+    if (ratio <= lower_) { return ACCEPT_H0; }
+    return CONTINUE;
+}
+
+/**
+ * @brief Gets the LLR bound at which H0 is accepted (negative)
+ */
+double Sprt::lowerBound() const {
+    return lower_;
+}
+
+/**
+ * @brief Gets the LLR bound at which H1 is accepted (positive)
+ */
+double Sprt::upperBound() const {
+    return upper_;
+}
+
+/**
+ * @brief Estimates the Elo difference of a match result, with the half-width of its 95% confidence interval
+ * @return The estimate, clamped to [-999, 999] when one side scored every point
+ */
+double Sprt::elo(const long long& wins, const long long& draws, const long long& losses, double& margin) {
+    const double games = static_cast<double>(wins + draws + losses);
+    margin = 0;
+    if (games == 0) { return 0; }
+
+    const double score = (wins + 0.5 * draws) / games;
+    const double variance = (wins * std::pow(1 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / games;
+    const double deviation = 1.959964 * std::sqrt(variance / games);
+    margin = (eloOf(score + deviation) - eloOf(score - deviation)) / 2;
+    return eloOf(score);
+}
@@ -0,0 +1,66 @@
+/**
+ * @class Sprt
+ * @brief Sequential probability ratio test between two Elo hypotheses, to stop an engine match as soon as its result
+ *     is clear.
+ *
+ * H0 says the first engine is elo0 Elo stronger than the second, H1 says it is elo1 stronger (elo0 < elo1). After every
+ * game the log-likelihood ratio (LLR) of H1 over H0 is compared with two bounds derived from the error rates: H1 is
+ * accepted once the LLR reaches log((1 - beta) / alpha), H0 once it falls to log(beta / (1 - alpha)).
+ * The LLR uses the usual normal approximation of the trinomial (win / draw / loss) model:
+ *
+ *      LLR = N * (s1 - s0) * (2 * s - s0 - s1) / (2 * variance)
+ *
+ * where s is the mean score per game, variance its per-game variance, and s0 / s1 the expected scores under each
+ * hypothesis (logistic Elo model).
+ */
+
+#pragma once
+
+class Sprt {
+    public:
+        enum Status {
+            CONTINUE,       // Neither bound was reached
+            ACCEPT_H0,      // The change is not worth elo1 (it is likely worth elo0 or less)
+            ACCEPT_H1       // The change is worth elo1 or more
+        };
+
+        /**
+         * @brief Constructs a test of H0: elo0 against H1: elo1
+         * @param alpha Probability of accepting H1 when H0 holds (false positive)
+         * @param beta Probability of accepting H0 when H1 holds (false negative)
+         */
+        Sprt(const double& elo0, const double& elo1, const double& alpha, const double& beta);
+
+        /**
+         * @brief Computes the LLR of H1 over H0 for a match result, from the first engine's point of view
+         * @return 0 until both decisive and drawn outcomes can be told apart (ie. the score variance is not 0)
+         */
+        double llr(const long long& wins, const long long& draws, const long long& losses) const;
+
+        /**
+         * @brief Decides a match result, from the first engine's point of view
+         */
+        Status status(const long long& wins, const long long& draws, const long long& losses) const;
+
+        /**
+         * @brief Gets the LLR bound at which H0 is accepted (negative)
+         */
+        double lowerBound() const;
+
+        /**
+         * @brief Gets the LLR bound at which H1 is accepted (positive)
+         */
+        double upperBound() const;
+
+        /**
+         * @brief Estimates the Elo difference of a match result, with the half-width of its 95% confidence interval
+         * @return The estimate, clamped to [-999, 999] when one side scored every point
+         */
+        static double elo(const long long& wins, const long long& draws, const long long& losses, double& margin);
+
+    private:
+        double score0_;     // Expected score per game under H0
+        double score1_;     // Expected score per game under H1
+        double lower_;
+        double upper_;
+};
@@ -0,0 +1,79 @@
+#include "BloomFilter.hpp"
+#include "../SplitMix64.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int MAX_BITS_PER_HASH = 16;
+}
+
+/**
+ * @brief Constructs an empty filter sized for a number of hashes
+ * @param false_positive_rate The share of new hashes that should be reported as seen once the filter is full
+ */
+BloomFilter::BloomFilter(const uint64_t& expected, const double& false_positive_rate) {
+    // Optimal size: -n ln(p) / ln(2)^2 bits, and ln(2) * bits / n bits per hash. Keeping each hash within one word costs
+    // a little accuracy, which the rounding up to a power of two makes up for.
+    const double rate = std::min(0.5, std::max(1e-9, false_positive_rate));
+    const double bits = std::max(64.0, -static_cast<double>(std::max<uint64_t>(expected, 1)) * std::log(rate) / (std::log(2.0) * std::log(2.0)));
+    uint64_t words = 1;
+    while (static_cast<double>(words * 64) < bits) { words <<= 1; }
+    word_mask_ = words - 1;
+    bits_per_hash_ = std::max(1, std::min(MAX_BITS_PER_HASH, static_cast<int>(std::lround(-std::log2(rate)))));
+
+    words_.reset(new std::atomic<uint64_t>[words]);
+    for (uint64_t i = 0; i < words; i++) { words_[i].store(0, std::memory_order_relaxed); }
+}
+
+/**
+ * @brief Adds a hash
+ * @return True if the hash was (probably) added before. False if it definitely was not.
+ */
+bool BloomFilter::insert(const uint64_t& hash) {
+    uint64_t word;
+    const uint64_t bits = mask(hash, word);
+    return (words_[word].fetch_or(bits, std::memory_order_relaxed) & bits) == bits;
+}
+
+/**
+ * @brief Determines if a hash was (probably) added
+ */
+bool BloomFilter::contains(const uint64_t& hash) const {
+    uint64_t word;
+    const uint64_t bits = mask(hash, word);
+    return (words_[word].load(std::memory_order_relaxed) & bits) == bits;
+}
+
+/**
+ * @brief Gets the size of the filter in bytes
+ */
+size_t BloomFilter::bytes() const {
+    return static_cast<size_t>(word_mask_ + 1) * sizeof(uint64_t);
+}
+
+/**
+ * @brief Gets the number of bits each hash sets
+ */
+int BloomFilter::bitsPerHash() const {
+    return bits_per_hash_;
+}
+
+/**
+ * @brief Gets the word a hash lives in & the bits it sets there
+ */
+uint64_t BloomFilter::mask(const uint64_t& hash, uint64_t& word) const {
+    // Mixing spreads the bits of the hash, so that keys differing in a few bits pick unrelated words & bits
+    word = SplitMix64::mix(hash) & word_mask_;
+
+    // Double hashing within the word: bit i = (h1 + i * h2) mod 64, from a second mix so the bits don't follow the word
+    const uint64_t mixed = SplitMix64::mix(hash ^ SplitMix64::GAMMA);
+    uint64_t h1 = mixed;
+    const uint64_t h2 = (mixed >> 32) | 1;
+    uint64_t bits = 0;
+    for (int i = 0; i < bits_per_hash_; i++) {
+        bits |= uint64_t{1} << (h1 & 63);
+        h1 += h2;
+    }
+    return bits;
+}
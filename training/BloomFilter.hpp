@@ -0,0 +1,54 @@
+/**
+ * @class BloomFilter
+ * @brief A set of 64-bit hashes that may answer "seen" for a hash it never held (at a chosen rate), but never answers
+ *     "not seen" for one it did, in a small fraction of the memory an exact set would take.
+ *
+ * Each hash sets a few bits of one 64-bit word, the word & bits being derived from the hash itself, so a lookup touches
+ * a single cache line. Bits are set with atomic operations, so insert() may be called from several threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class BloomFilter {
+    public:
+        /**
+         * @brief Constructs an empty filter sized for a number of hashes
+         * @param false_positive_rate The share of new hashes that should be reported as seen once the filter is full
+         */
+        BloomFilter(const uint64_t& expected, const double& false_positive_rate = 0.001);
+
+        /**
+         * @brief Adds a hash
+         * @return True if the hash was (probably) added before. False if it definitely was not.
+         */
+        bool insert(const uint64_t& hash);
+
+        /**
+         * @brief Determines if a hash was (probably) added
+         */
+        bool contains(const uint64_t& hash) const;
+
+        /**
+         * @brief Gets the size of the filter in bytes
+         */
+        size_t bytes() const;
+
+        /**
+         * @brief Gets the number of bits each hash sets
+         */
+        int bitsPerHash() const;
+
+    private:
+        std::unique_ptr<std::atomic<uint64_t>[]> words_;
+        uint64_t word_mask_;    // Number of words - 1 (a power of two)
+        int bits_per_hash_;
+
+        /**
+         * @brief Gets the word a hash lives in & the bits it sets there
+         */
+        uint64_t mask(const uint64_t& hash, uint64_t& word) const;
+};
@@ -0,0 +1,70 @@
+#include "PackedPosition.hpp"
+#include "../SplitMix64.hpp"
+#include "../server/CompactBoard.hpp"
+
+#include <cstring>
+
+namespace {
+    const int CELLS = GameBoard::CELLS;
+    static_assert(CELLS <= 64, "PackedPosition::occupied has one bit per cell");
+
+    // FEN letters of the codes, player one's pieces in uppercase
+    const char LETTERS[16] = {0, 'P', 'N', 'B', 'R', 'Q', 'K', 0, 0, 'p', 'n', 'b', 'r', 'q', 'k', 0};
+}
+
+/**
+ * @brief Packs the position on a board
+ * @return False if the board has more than MAX_PIECES pieces (nothing is set). True otherwise.
+ */
+bool PackedPosition::pack(const ChessBoard& board, PackedPosition& packed) {
+    PackedPosition result;
+    std::memset(&result, 0, sizeof(result));
+
+    const std::string p1_color = board.getPlayerColor(true);
+    int count = 0;
+    for (int cell = 0; cell < CELLS; cell++) {
+        const ChessPiece* piece = board.getCell(GameBoard::rowOf(cell), GameBoard::colOf(cell));
+        if (!piece) { continue; }
+        if (count == MAX_PIECES) { return false; }
+
+        const uint8_t code = CompactBoard::typeCode(piece->getSymbol()) | (piece->getColor() == p1_color ? 0 : CompactBoard::PLAYER_TWO);
+        result.occupied |= uint64_t{1} << cell;
+        result.pieces[count / 2] |= static_cast<uint8_t>(code << (4 * (count % 2)));
+        count++;
+    }
+
+    result.state = static_cast<uint8_t>((board.isPlayerOneTurn() ? 0 : PLAYER_TWO_TO_MOVE) | board.getCastlingRights() << 1);
+    result.en_passant = board.getEnPassantCell() < 0 ? NO_EN_PASSANT : static_cast<uint8_t>(board.getEnPassantCell());
+    packed = result;
+    return true;
+}
+
+/**
+ * @brief Builds a board in the packed position
+ * @return The board, or nullptr if the packed bytes are not a valid position
+ */
+std::unique_ptr<ChessBoard> PackedPosition::unpack() const {
+    if (__builtin_popcountll(occupied) > MAX_PIECES) { return nullptr; }
+
+    char symbols[CELLS] = {};
+    int count = 0;
+    for (uint64_t cells = occupied; cells; cells &= cells - 1) {
+        const char letter = LETTERS[(pieces[count / 2] >> (4 * (count % 2))) & 0x0F];
+        if (!letter) { return nullptr; }
+        symbols[__builtin_ctzll(cells)] = letter;
+        count++;
+    }
+    return ChessBoard::fromCells(symbols, !(state & PLAYER_TWO_TO_MOVE), state >> 1, en_passant == NO_EN_PASSANT ? -1 : en_passant);
+}
+
+/**
+ * @brief Hashes the position (pieces, side to move, castling rights & en passant), ignoring the labels
+ */
+uint64_t PackedPosition::hash() const {
+    uint64_t words[2];
+    std::memcpy(words, pieces, sizeof(words));
+    uint64_t value = SplitMix64::mix(occupied);
+    value = SplitMix64::mix(value ^ words[0]);
+    value = SplitMix64::mix(value ^ words[1]);
+    return SplitMix64::mix(value ^ (static_cast<uint64_t>(state) << 8 | en_passant));
+}
@@ -0,0 +1,51 @@
+/**
+ * @struct PackedPosition
+ * @brief A labelled ChessBoard position packed into 32 bytes, for storing the billions of positions evaluation tuning needs.
+ *
+ * The pieces are stored as an occupancy bitmap plus one 4-bit code per occupied cell, in cell order (the first one in the
+ * low nibble of pieces[0]). Codes are those of CompactBoard: 1 to 6 for P, N, B, R, Q, K, with PLAYER_TWO set for player
+ * two's pieces. A legal position has at most 32 pieces, so 16 bytes always hold them. The rest of the position (side to
+ * move, castling rights & en passant cell) and two labels (a score & the game's result) fill the other 8 bytes.
+ *
+ * Equal positions pack to equal bytes whatever their labels, so hash() can be used to find duplicates.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "../ChessBoard.hpp"
+
+struct PackedPosition {
+    static const int MAX_PIECES = 32;
+    static const uint8_t PLAYER_TWO_TO_MOVE = 1;    // Flag of state; castling rights take the 4 bits above it
+    static const uint8_t NO_EN_PASSANT = 0xFF;
+
+    uint64_t occupied;              // Bit set for every occupied cell (numbered as in GameBoard)
+    uint8_t pieces[MAX_PIECES / 2]; // Codes of the occupied cells
+    uint8_t state;                  // PLAYER_TWO_TO_MOVE | ChessBoard::CastlingRight flags << 1
+    uint8_t en_passant;             // Cell the player to move may capture onto en passant, or NO_EN_PASSANT
+    int16_t score;                  // Label: centipawns for the player to move
+    uint8_t result;                 // Label: the game's GameRecord::Result
+    uint8_t reserved;
+    uint16_t ply;                   // Plies played in the game before the position
+
+    /**
+     * @brief Packs the position on a board
+     * @return False if the board has more than MAX_PIECES pieces (nothing is set). True otherwise.
+     */
+    static bool pack(const ChessBoard& board, PackedPosition& packed);
+
+    /**
+     * @brief Builds a board in the packed position
+     * @return The board, or nullptr if the packed bytes are not a valid position
+     */
+    std::unique_ptr<ChessBoard> unpack() const;
+
+    /**
+     * @brief Hashes the position (pieces, side to move, castling rights & en passant), ignoring the labels
+     */
+    uint64_t hash() const;
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition is a 32-byte file record");
@@ -0,0 +1,138 @@
+#include "PositionReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "PositionWriter.hpp"
+
+PositionReader::PositionReader() : batch_positions_{DEFAULT_BATCH_POSITIONS}, max_queued_{0}, next_path_{0}, running_{0},
+    stop_{false}, failed_{false} {}
+
+/**
+ * @brief Destructor.
+ * @post Stops the background threads
+ */
+PositionReader::~PositionReader() {
+    close();
+}
+
+/**
+ * @brief Starts reading files
+ * @param threads The number of files read at once. 0 uses one per hardware thread, up to the number of files.
+ * @return False if the reader is already open
+ */
+bool PositionReader::open(const std::vector<std::string>& paths, unsigned threads, const size_t& batch_positions) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!threads_.empty()) { return false; }
+
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    threads = std::max(1u, std::min(threads, static_cast<unsigned>(paths.size())));
+    paths_ = paths;
+    batch_positions_ = batch_positions > 0 ? batch_positions : DEFAULT_BATCH_POSITIONS;
+    max_queued_ = 2 * threads;
+    queue_.clear();
+    next_path_ = 0;
+    running_ = threads;
+    stop_ = false;
+    failed_ = false;
+    for (unsigned t = 0; t < threads; t++) { threads_.emplace_back(&PositionReader::readLoop, this); }
+    return true;
+}
+
+/**
+ * @brief Takes the next batch of positions, waiting for one to be read if need be
+ * @return True if batch was filled. False once every file has been read.
+ */
+bool PositionReader::next(std::vector<PackedPosition>& batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !queue_.empty() || running_ == 0; });
+    if (queue_.empty()) { return false; }
+
+    batch = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    changed_.notify_all();
+    return true;
+}
+
+/**
+ * @brief Determines if a file could not be opened, was not a chunk file or was cut short
+ */
+bool PositionReader::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+/**
+ * @brief Stops the background threads, dropping the batches not taken yet
+ */
+void PositionReader::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+    for (std::thread& thread : threads_) { thread.join(); }
+    threads_.clear();
+    queue_.clear();
+}
+
+/**
+ * @brief Reads the header of a chunk file
+ * @return The number of positions the file holds, or -1 if it is not a chunk file of this version
+ */
+long long PositionReader::readHeader(std::istream& in) {
+    PositionChunkHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) { return -1; }
+    if (std::memcmp(header.magic, "P4PP", 4) != 0 || header.version != PositionWriter::VERSION) { return -1; }
+    return static_cast<long long>(header.positions);
+}
+
+/**
+ * @brief Body of a background thread: reads files until there are none left
+ */
+void PositionReader::readLoop() {
+    while (true) {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_ || next_path_ == paths_.size()) { break; }
+            path = paths_[next_path_++];
+        }
+        if (!readFile(path)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = failed_ || !stop_;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_--;
+    }
+    changed_.notify_all();
+}
+
+/**
+ * @brief Reads one file into the queue
+ * @return False if the file is invalid, or the reader was closed
+ */
+bool PositionReader::readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    long long remaining = readHeader(in);
+    if (remaining < 0) { return false; }
+
+    while (remaining > 0) {
+        std::vector<PackedPosition> batch(static_cast<size_t>(std::min<long long>(remaining, batch_positions_)));
+        const std::streamsize bytes = static_cast<std::streamsize>(batch.size() * sizeof(PackedPosition));
+        if (!in.read(reinterpret_cast<char*>(batch.data()), bytes)) { return false; }
+        remaining -= static_cast<long long>(batch.size());
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return queue_.size() < max_queued_ || stop_; });
+        if (stop_) { return false; }
+        queue_.push_back(std::move(batch));
+        lock.unlock();
+        changed_.notify_all();
+    }
+    return true;
+}
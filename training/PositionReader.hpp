@@ -0,0 +1,89 @@
+/**
+ * @class PositionReader
+ * @brief Streams the positions of a set of chunk files (see PositionWriter) in batches, reading ahead on background threads.
+ *
+ * Each thread reads whole files, one at a time, and queues their positions in batches; at most two batches per thread
+ * wait in the queue, so memory stays bounded however large the files are. Batches come out in the order they are read,
+ * which mixes files when there are several threads. next() may be called from several threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PackedPosition.hpp"
+
+class PositionReader {
+    public:
+        static constexpr size_t DEFAULT_BATCH_POSITIONS = 1 << 16;
+
+        PositionReader();
+
+        /**
+         * @brief Destructor.
+         * @post Stops the background threads
+         */
+        ~PositionReader();
+
+        PositionReader(const PositionReader&) = delete;
+        PositionReader& operator=(const PositionReader&) = delete;
+
+        /**
+         * @brief Starts reading files
+         * @param threads The number of files read at once. 0 uses one per hardware thread, up to the number of files.
+         * @return False if the reader is already open
+         */
+        bool open(const std::vector<std::string>& paths, unsigned threads = 2, const size_t& batch_positions = DEFAULT_BATCH_POSITIONS);
+
+        /**
+         * @brief Takes the next batch of positions, waiting for one to be read if need be
+         * @return True if batch was filled. False once every file has been read.
+         */
+        bool next(std::vector<PackedPosition>& batch);
+
+        /**
+         * @brief Determines if a file could not be opened, was not a chunk file or was cut short
+         */
+        bool failed() const;
+
+        /**
+         * @brief Stops the background threads, dropping the batches not taken yet
+         */
+        void close();
+
+        /**
+         * @brief Reads the header of a chunk file
+         * @return The number of positions the file holds, or -1 if it is not a chunk file of this version
+         */
+        static long long readHeader(std::istream& in);
+
+    private:
+        std::vector<std::string> paths_;
+        size_t batch_positions_;
+        size_t max_queued_;
+
+        mutable std::mutex mutex_;          // Guards everything below
+        std::condition_variable changed_;   // Signalled when a batch is queued or taken, or a thread finishes
+        std::deque<std::vector<PackedPosition>> queue_;
+        size_t next_path_;
+        unsigned running_;                  // Background threads still reading
+        bool stop_;
+        bool failed_;
+        std::vector<std::thread> threads_;
+
+        /**
+         * @brief Body of a background thread: reads files until there are none left
+         */
+        void readLoop();
+
+        /**
+         * @brief Reads one file into the queue
+         * @return False if the file is invalid, or the reader was closed
+         */
+        bool readFile(const std::string& path);
+};
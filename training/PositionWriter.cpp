@@ -0,0 +1,156 @@
+#include "PositionWriter.hpp"
+#include "../SplitMix64.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+PositionWriter::PositionWriter() : chunk_positions_{DEFAULT_CHUNK_POSITIONS}, seed_{1}, chunks_{0}, positions_{0}, open_{false},
+    closing_{false}, failed_{false} {}
+
+/**
+ * @brief Destructor.
+ * @post Closes the writer if it is still open
+ */
+PositionWriter::~PositionWriter() {
+    close();
+}
+
+/**
+ * @brief Starts writing chunks named after prefix (see the class description)
+ * @param seed Seeds the shuffles, so that the same positions written in the same order give the same files
+ * @return False if the writer is already open
+ */
+bool PositionWriter::open(const std::string& prefix, const size_t& chunk_positions, const uint64_t& seed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) { return false; }
+
+    prefix_ = prefix;
+    chunk_positions_ = chunk_positions > 0 ? chunk_positions : DEFAULT_CHUNK_POSITIONS;
+    seed_ = seed;
+    filling_.clear();
+    filling_.reserve(chunk_positions_);
+    chunks_ = 0;
+    positions_ = 0;
+    open_ = true;
+    closing_ = false;
+    failed_ = false;
+    flusher_ = std::thread(&PositionWriter::flushLoop, this);
+    return true;
+}
+
+/**
+ * @brief Adds positions. Safe to call from several threads; batches of a few thousand keep the lock cheap.
+ */
+void PositionWriter::write(const PackedPosition* positions, const size_t& count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_) { return; }
+
+    for (size_t done = 0; done < count; ) {
+        const size_t taken = std::min(count - done, chunk_positions_ - filling_.size());
+        filling_.insert(filling_.end(), positions + done, positions + done + taken);
+        done += taken;
+        positions_ += taken;
+        // Another producer may queue the full chunk (& start filling the next) while this one waits for room
+        while (filling_.size() == chunk_positions_) {
+            if (pending_.size() < MAX_PENDING) {
+                queueChunk();
+            } else {
+                changed_.wait(lock);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes the last (partial) chunk & waits for every chunk to be on disk
+ * @return True if every chunk was written. False otherwise, or if the writer was not open.
+ */
+bool PositionWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) { return false; }
+        if (!filling_.empty()) { queueChunk(); }
+        closing_ = true;
+    }
+    changed_.notify_all();
+    flusher_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = false;
+    return !failed_;
+}
+
+/**
+ * @brief Gets the number of positions added so far
+ */
+uint64_t PositionWriter::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return positions_;
+}
+
+/**
+ * @brief Gets the number of chunk files started so far
+ */
+size_t PositionWriter::chunks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_;
+}
+
+/**
+ * @brief Gets the name of a chunk file
+ */
+std::string PositionWriter::chunkPath(const std::string& prefix, const size_t& chunk) {
+    char number[16];
+    std::snprintf(number, sizeof(number), "-%05zu.p4pp", chunk);
+    return prefix + number;
+}
+
+/**
+ * @brief Body of the background thread: shuffles & writes queued chunks until the writer closes
+ */
+void PositionWriter::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return !pending_.empty() || closing_; });
+        if (pending_.empty()) { return; }
+
+        std::pair<size_t, std::vector<PackedPosition>> chunk = std::move(pending_.front());
+        pending_.pop_front();
+        lock.unlock();
+        changed_.notify_all();  // Producers may be waiting for room
+        const bool written = writeChunk(chunk.first, chunk.second);
+        lock.lock();
+        failed_ = failed_ || !written;
+    }
+}
+
+/**
+ * @brief Queues the chunk being filled
+ * @pre mutex_ is held
+ */
+void PositionWriter::queueChunk() {
+    pending_.emplace_back(chunks_++, std::move(filling_));
+    filling_.clear();
+    filling_.reserve(chunk_positions_);
+    changed_.notify_all();
+}
+
+/**
+ * @brief Shuffles a chunk & writes it to its file
+ */
+bool PositionWriter::writeChunk(const size_t& number, std::vector<PackedPosition>& positions) const {
+    uint64_t state = seed_ ^ (number * 0xD1B54A32D192ED03ULL);
+    for (size_t i = positions.size(); i > 1; i--) { std::swap(positions[i - 1], positions[SplitMix64::next(state) % i]); }
+
+    std::ofstream out(chunkPath(prefix_, number), std::ios::binary | std::ios::trunc);
+    PositionChunkHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "P4PP", 4);
+    header.version = VERSION;
+    header.positions = positions.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(positions.data()), static_cast<std::streamsize>(positions.size() * sizeof(PackedPosition)));
+    return static_cast<bool>(out.flush());
+}
@@ -0,0 +1,114 @@
+/**
+ * @class PositionWriter
+ * @brief Streams packed positions from any number of threads into shuffled chunk files.
+ *
+ * Positions are gathered into chunks of a fixed number of positions. A full chunk is handed to a background thread,
+ * which shuffles it and writes it to its own file ("<prefix>-00000.p4pp", "<prefix>-00001.p4pp", ...), so producers
+ * never wait on the disk unless it falls more than MAX_PENDING chunks behind. Each chunk mixes the positions of every
+ * producer, and shuffling breaks up the runs of positions from the same game, so a trainer can read chunks in any order.
+ *
+ * A chunk file is a PositionChunkHeader followed by its positions (host byte order).
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PackedPosition.hpp"
+
+/**
+ * @brief Start of a chunk file
+ */
+struct PositionChunkHeader {
+    char magic[4];          // "P4PP"
+    uint32_t version;       // Currently 1
+    uint64_t positions;     // Positions following the header
+};
+
+class PositionWriter {
+    public:
+        static const uint32_t VERSION = 1;
+        static constexpr size_t DEFAULT_CHUNK_POSITIONS = size_t{1} << 20;    // 32 MB chunks
+        static constexpr size_t MAX_PENDING = 2;    // Full chunks waiting for the disk before producers are held up
+
+        PositionWriter();
+
+        /**
+         * @brief Destructor.
+         * @post Closes the writer if it is still open
+         */
+        ~PositionWriter();
+
+        PositionWriter(const PositionWriter&) = delete;
+        PositionWriter& operator=(const PositionWriter&) = delete;
+
+        /**
+         * @brief Starts writing chunks named after prefix (see the class description)
+         * @param seed Seeds the shuffles, so that the same positions written in the same order give the same files
+         * @return False if the writer is already open
+         */
+        bool open(const std::string& prefix, const size_t& chunk_positions = DEFAULT_CHUNK_POSITIONS, const uint64_t& seed = 1);
+
+        /**
+         * @brief Adds positions. Safe to call from several threads; batches of a few thousand keep the lock cheap.
+         */
+        void write(const PackedPosition* positions, const size_t& count);
+
+        /**
+         * @brief Writes the last (partial) chunk & waits for every chunk to be on disk
+         * @return True if every chunk was written. False otherwise, or if the writer was not open.
+         */
+        bool close();
+
+        /**
+         * @brief Gets the number of positions added so far
+         */
+        uint64_t size() const;
+
+        /**
+         * @brief Gets the number of chunk files started so far
+         */
+        size_t chunks() const;
+
+        /**
+         * @brief Gets the name of a chunk file
+         */
+        static std::string chunkPath(const std::string& prefix, const size_t& chunk);
+
+    private:
+        std::string prefix_;
+        size_t chunk_positions_;
+        uint64_t seed_;
+
+        mutable std::mutex mutex_;              // Guards everything below
+        std::condition_variable changed_;       // Signalled when a chunk is queued or written, or the writer closes
+        std::vector<PackedPosition> filling_;   // The chunk being filled
+        std::deque<std::pair<size_t, std::vector<PackedPosition>>> pending_;    // Full chunks & their numbers
+        size_t chunks_;
+        uint64_t positions_;
+        bool open_;
+        bool closing_;
+        bool failed_;
+        std::thread flusher_;
+
+        /**
+         * @brief Body of the background thread: shuffles & writes queued chunks until the writer closes
+         */
+        void flushLoop();
+
+        /**
+         * @brief Queues the chunk being filled
+         * @pre mutex_ is held
+         */
+        void queueChunk();
+
+        /**
+         * @brief Shuffles a chunk & writes it to its file
+         */
+        bool writeChunk(const size_t& number, std::vector<PackedPosition>& positions) const;
+};
@@ -0,0 +1,126 @@
+#include "TrainingSetBuilder.hpp"
+#include "BloomFilter.hpp"
+#include "PositionReader.hpp"
+#include "../Parallel.hpp"
+#include "../archive/GameArchiveReader.hpp"
+#include "../search/Evaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace {
+    const size_t BATCH_POSITIONS = 4096;    // Positions a thread gathers before taking the writer's lock
+    const double FALSE_POSITIVE_RATE = 0.001;
+}
+
+/**
+ * @brief Constructs a builder
+ * @param threads The number of worker threads. 0 uses one per hardware thread.
+ */
+TrainingSetBuilder::TrainingSetBuilder(const unsigned& threads) : threads_{threads ? threads : std::thread::hardware_concurrency()} {
+    if (threads_ == 0) { threads_ = 1; }
+}
+
+/**
+ * @brief Packs the positions of every game of an archive into a writer
+ * @pre The writer is open
+ * @return The number of positions written, or -1 if the archive could not be read
+ */
+long long TrainingSetBuilder::extract(const std::string& archive, PositionWriter& writer) const {
+    uint64_t games = 0;
+    {
+        GameArchiveReader reader;
+        if (!reader.open(archive)) { return -1; }
+        games = reader.size();
+    }
+
+    const unsigned threads = static_cast<unsigned>(std::max<uint64_t>(1, std::min<uint64_t>(threads_, games)));
+    std::atomic<long long> written{0};
+    std::atomic<bool> failed{false};
+
+    parallelFor(threads, [&] (const unsigned& t) {
+        const uint64_t first = games * t / threads;
+        const uint64_t last = games * (t + 1) / threads;
+        if (first == last) { return; }
+        GameArchiveReader reader;
+        if (!reader.open(archive) || !reader.seek(first)) {
+            failed = true;
+            return;
+        }
+
+        std::vector<PackedPosition> batch;
+        batch.reserve(BATCH_POSITIONS);
+        auto flush = [&] {
+            writer.write(batch.data(), batch.size());
+            written += static_cast<long long>(batch.size());
+            batch.clear();
+        };
+
+        GameRecord record;
+        for (uint64_t game = first; game < last; game++) {
+            if (!reader.next(record)) {
+                failed = true;
+                return;
+            }
+            std::unique_ptr<ChessBoard> board = record.fen.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(record.fen);
+            if (!board) {
+                failed = true;
+                return;
+            }
+
+            for (size_t ply = 0; ; ply++) {
+                PackedPosition packed;
+                if (!board->isInCheck(board->isPlayerOneTurn()) && PackedPosition::pack(*board, packed)) {
+                    const int score = Evaluator::evaluate(*board);
+                    packed.score = static_cast<int16_t>(std::max<int>(std::numeric_limits<int16_t>::min(),
+                        std::min<int>(std::numeric_limits<int16_t>::max(), score)));
+                    packed.result = record.result;
+                    packed.ply = static_cast<uint16_t>(std::min<size_t>(ply, std::numeric_limits<uint16_t>::max()));
+                    batch.push_back(packed);
+                    if (batch.size() == BATCH_POSITIONS) { flush(); }
+                }
+                if (ply == record.moves.size()) { break; }
+                board->move(record.moves[ply]);
+            }
+        }
+        flush();
+    });
+
+    return failed ? -1 : written.load();
+}
+
+/**
+ * @brief Copies the positions of chunk files into a writer, leaving out repeated positions
+ * @pre The writer is open
+ * @param expected The number of distinct positions expected, which sizes the filter
+ * @param duplicates Set to the number of positions left out
+ * @return The number of positions written, or -1 if a chunk file could not be read
+ */
+long long TrainingSetBuilder::deduplicate(const std::vector<std::string>& chunks, PositionWriter& writer, const uint64_t& expected,
+    long long& duplicates) const {
+    BloomFilter seen(expected, FALSE_POSITIVE_RATE);
+    PositionReader reader;
+    reader.open(chunks, std::min<unsigned>(threads_, 4));
+
+    std::atomic<long long> written{0};
+    std::atomic<long long> dropped{0};
+    parallelFor(threads_, [&] (const unsigned&) {
+        std::vector<PackedPosition> batch;
+        std::vector<PackedPosition> kept;
+        while (reader.next(batch)) {
+            kept.clear();
+            for (const PackedPosition& position : batch) {
+                if (!seen.insert(position.hash())) { kept.push_back(position); }
+            }
+            writer.write(kept.data(), kept.size());
+            written += static_cast<long long>(kept.size());
+            dropped += static_cast<long long>(batch.size() - kept.size());
+        }
+    });
+
+    duplicates = dropped;
+    return reader.failed() ? -1 : written.load();
+}
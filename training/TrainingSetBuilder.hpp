@@ -0,0 +1,49 @@
+/**
+ * @class TrainingSetBuilder
+ * @brief Turns a game archive into shuffled chunk files of labelled positions (see PositionWriter), and removes
+ *     duplicate positions from a set of chunk files.
+ *
+ * Extraction splits the archive into one range of games per thread, like PositionIndexBuilder. Each thread replays its
+ * games and packs every position whose player to move is not in check (a static score means little there), labelled
+ * with the game's result, Evaluator's score and the ply, then hands them to the shared writer in batches.
+ *
+ * Deduplication streams the chunks through a BloomFilter of PackedPosition::hash(): the first copy of each position is
+ * kept, later ones are dropped. A false positive drops a position that was not a duplicate, which costs a little data
+ * but never lets a duplicate through.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PositionWriter.hpp"
+
+class TrainingSetBuilder {
+    public:
+        /**
+         * @brief Constructs a builder
+         * @param threads The number of worker threads. 0 uses one per hardware thread.
+         */
+        TrainingSetBuilder(const unsigned& threads = 0);
+
+        /**
+         * @brief Packs the positions of every game of an archive into a writer
+         * @pre The writer is open
+         * @return The number of positions written, or -1 if the archive could not be read
+         */
+        long long extract(const std::string& archive, PositionWriter& writer) const;
+
+        /**
+         * @brief Copies the positions of chunk files into a writer, leaving out repeated positions
+         * @pre The writer is open
+         * @param expected The number of distinct positions expected, which sizes the filter
+         * @param duplicates Set to the number of positions left out
+         * @return The number of positions written, or -1 if a chunk file could not be read
+         */
+        long long deduplicate(const std::vector<std::string>& chunks, PositionWriter& writer, const uint64_t& expected,
+            long long& duplicates) const;
+
+    private:
+        unsigned threads_;
+};
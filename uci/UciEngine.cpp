@@ -0,0 +1,249 @@
+#include "UciEngine.hpp"
+#include "../Notation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Constructs an engine that reads commands from in & writes responses to out
+ */
+UciEngine::UciEngine(std::istream& in, std::ostream& out) : in_{in}, out_{out}, table_{HASH_MEGABYTES},
+    shared_hash_pending_{false}, multi_pv_{1} {}
+
+/**
+ * @brief Destructor.
+ * @post Any running search is stopped & its thread joined
+ */
+UciEngine::~UciEngine() {
+    stopSearch();
+}
+
+/**
+ * @brief Processes commands until "quit" or the end of the input
+ */
+void UciEngine::run() {
+    for (std::string line; std::getline(in_, line); ) {
+        if (!handle(line)) { break; }
+    }
+    stopSearch();
+}
+
+/**
+ * @brief Processes a single command line
+ * @return False if the command was "quit". True otherwise.
+ */
+bool UciEngine::handle(const std::string& line) {
+    std::istringstream command(line);
+    std::string name;
+    command >> name;
+
+    if (name == "uci") {
+        send("id name p4-235");
+        send("id author p4-235 contributors");
+        send("option name EvalFile type string default <empty>");
+        send("option name Hash type spin default " + std::to_string(HASH_MEGABYTES) + " min 1 max " + std::to_string(MAX_HASH_MEGABYTES));
+        send("option name MultiPV type spin default 1 min 1 max " + std::to_string(MAX_MULTI_PV));
+        send("option name SharedHash type string default <empty>");
+        send("uciok");
+    } else if (name == "isready") {
+        openSharedHash();     // Options are only set between searches, so none is running if one is pending
+        send("readyok");
+    } else if (name == "setoption") {
+        stopSearch();
+        setOption(command);
+    } else if (name == "ucinewgame") {
+        stopSearch();
+        if (!table_.isShared()) { table_.clear(); }     // Other processes may be using a shared table
+        position_fen_.clear();
+        position_moves_.clear();
+    } else if (name == "position") {
+        stopSearch();
+        position(command);
+    } else if (name == "go") {
+        go(command);
+    } else if (name == "stop") {
+        stopSearch();
+    } else if (name == "quit") {
+        stopSearch();
+        return false;
+    }
+    // Unknown commands are ignored, as the protocol requires
+    return true;
+}
+
+/**
+ * @brief Writes a whole line at once, so that lines of the worker & input threads never interleave
+ */
+void UciEngine::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    out_ << line << std::endl;
+}
+
+void UciEngine::position(std::istringstream& command) {
+    std::string token;
+    command >> token;
+
+    position_fen_.clear();
+    position_moves_.clear();
+    if (token == "fen") {
+        std::string field;
+        while (command >> field && field != "moves") { position_fen_ += (position_fen_.empty() ? "" : " ") + field; }
+        token = field;
+    } else if (token == "startpos") {
+        command >> token;
+    }
+
+    if (token == "moves") {
+        for (std::string move; command >> move; ) { position_moves_.push_back(move); }
+    }
+}
+
+/**
+ * @brief Applies "setoption name <name> value <value>". The options are EvalFile, the path of an NNUE weights file
+ *     ("<empty>" goes back to the handcrafted evaluation), Hash, the size of the transposition table in megabytes,
+ *     MultiPV, the number of variations to search, and SharedHash, the shared-memory segment to keep the transposition
+ *     table in ("<empty>" goes back to a private one). The segment is opened on the next "isready" or "go" (see
+ *     openSharedHash()), and created with the Hash size if it does not exist yet.
+ */
+void UciEngine::setOption(std::istringstream& command) {
+    std::string token, option, value;
+    command >> token;
+    while (command >> token && token != "value") { option += (option.empty() ? "" : " ") + token; }
+    while (command >> token) { value += (value.empty() ? "" : " ") + token; }
+
+    if (option == "Hash") {
+        const long long megabytes = std::atoll(value.c_str());
+        table_.resize(static_cast<size_t>(std::max(1LL, std::min(static_cast<long long>(MAX_HASH_MEGABYTES), megabytes))));
+        shared_hash_pending_ = !shared_hash_.empty();   // resize() left the segment for private slots
+    } else if (option == "MultiPV") {
+        multi_pv_ = std::max(1, std::min(MAX_MULTI_PV, std::atoi(value.c_str())));
+    } else if (option == "SharedHash") {
+        if (value.empty() || value == "<empty>") {
+            table_.closeShared();
+            shared_hash_.clear();
+            shared_hash_pending_ = false;
+            send("info string using a private hash table");
+        } else {
+            shared_hash_ = value;
+            shared_hash_pending_ = true;
+        }
+    } else if (option != "EvalFile") {
+        send("info string unknown option " + option);
+    } else if (value.empty() || value == "<empty>") {
+        network_.reset();
+        send("info string using the handcrafted evaluation");
+    } else {
+        std::unique_ptr<NnueNetwork> network(new NnueNetwork());
+        if (!network->load(value)) {
+            send("info string cannot load network " + value);
+            return;
+        }
+        network_ = std::move(network);
+        send("info string using network " + value);
+    }
+}
+
+void UciEngine::go(std::istringstream& command) {
+    stopSearch();
+    openSharedHash();
+
+    SearchLimits limits;
+    limits.multi_pv = multi_pv_;
+    for (std::string token; command >> token; ) {
+        if (token == "infinite") { limits.infinite = true; }
+        else if (token == "depth") { command >> limits.depth; }
+        else if (token == "nodes") { command >> limits.nodes; }
+        else if (token == "movetime") { command >> limits.movetime; }
+        else if (token == "wtime") { command >> limits.time[0]; }
+        else if (token == "btime") { command >> limits.time[1]; }
+        else if (token == "winc") { command >> limits.increment[0]; }
+        else if (token == "binc") { command >> limits.increment[1]; }
+        else if (token == "movestogo") { command >> limits.moves_to_go; }
+    }
+
+    search_board_ = buildBoard();
+    if (!search_board_) {
+        send("info string invalid position");
+        send("bestmove 0000");
+        return;
+    }
+
+    search_.reset(new Search(*search_board_, table_));
+    search_->setNetwork(network_.get());
+    worker_ = std::thread([this, limits] () {
+        Move best = search_->run(limits, [this] (const SearchInfo& info) { send(infoLine(info)); });
+        if (limits.infinite) { search_->waitForStop(); }   // "go infinite" reports its move only after "stop"
+        send("bestmove " + (best.isNone() ? std::string("0000") : Notation::moveName(best)));
+    });
+}
+
+/**
+ * @brief Stops the running search (if any) & waits for its "bestmove"
+ */
+void UciEngine::stopSearch() {
+    if (search_) { search_->stop(); }
+    if (worker_.joinable()) { worker_.join(); }
+}
+
+/**
+ * @brief Opens the segment of the SharedHash option, if it changed (or Hash did) since it was last opened, and
+ *     reports the size of the table in an "info string" line
+ * @pre No search is running
+ */
+void UciEngine::openSharedHash() {
+    if (!shared_hash_pending_) { return; }
+    shared_hash_pending_ = false;
+    if (table_.openShared(shared_hash_)) {
+        send("info string using shared hash table " + shared_hash_ + " of " + std::to_string(table_.getMegabytes()) + " MB");
+    } else {
+        send("info string cannot open shared hash table " + shared_hash_ + ", using a private one of " +
+            std::to_string(table_.getMegabytes()) + " MB");
+    }
+}
+
+/**
+ * @brief Builds a fresh board for the current position. The moves stop at the first one that can't be played,
+ *     which is reported in an "info string" line.
+ * @return The board, or nullptr if the position's FEN is invalid
+ */
+std::unique_ptr<ChessBoard> UciEngine::buildBoard() {
+    std::unique_ptr<ChessBoard> board = position_fen_.empty() ? std::unique_ptr<ChessBoard>(new ChessBoard()) : ChessBoard::fromFen(position_fen_);
+    if (!board) { return nullptr; }
+
+    for (size_t i = 0; i < position_moves_.size(); i++) {
+        Move move;
+        if (!Notation::parseMove(position_moves_[i], move) || !board->move(move)) {
+            send("info string illegal move " + position_moves_[i] + " (move " + std::to_string(i + 1) +
+                "), searching the position before it");
+            break;
+        }
+    }
+    return board;
+}
+
+/**
+ * @brief Formats a search report as an "info" line
+ */
+std::string UciEngine::infoLine(const SearchInfo& info) {
+    std::ostringstream line;
+    long long nps = info.nodes * 1000 / std::max(1LL, info.time);
+    line << "info depth " << info.depth;
+
+    if (!info.pv.empty()) {
+        line << " multipv " << info.multi_pv;
+        if (Search::isMateScore(info.score)) {
+            // Mate in moves, negative when the engine is the one getting mated
+            int plies = Search::MATE_SCORE - std::abs(info.score);
+            line << " score mate " << (info.score > 0 ? (plies + 1) / 2 : -(plies / 2));
+        } else {
+            line << " score cp " << info.score;
+        }
+    }
+
+    line << " nodes " << info.nodes << " nps " << nps << " time " << info.time;
+    if (!info.pv.empty()) {
+        line << " pv";
+        for (const Move& move : info.pv) { line << " " << Notation::moveName(move); }
+    }
+    return line.str();
+}
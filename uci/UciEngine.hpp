@@ -0,0 +1,119 @@
+/**
+ * @class UciEngine
+ * @brief Universal Chess Interface (UCI) front-end, so that GUIs & tournament managers can drive the engine.
+ *
+ * Supported commands: uci, isready, ucinewgame, position (startpos | fen <FEN>) [moves <move>...],
+ * go [depth | nodes | movetime | wtime | btime | winc | binc | movestogo | infinite], setoption name EvalFile value <path>,
+ * setoption name Hash value <megabytes>, setoption name MultiPV value <variations>, setoption name SharedHash value <segment name>,
+ * stop & quit.
+ *
+ * SharedHash moves the transposition table into a named shared-memory segment (see TranspositionTable::openShared()), so
+ * that engine processes on one host share what they learn, and a restarted engine starts from a warm table. A missing
+ * segment is created with the Hash size; an existing one keeps its own, which is reported in an "info string" line.
+ * "ucinewgame" leaves a shared table as it is.
+ *
+ * The search of a "go" command runs on a worker thread, so input keeps being read (and "stop" or "isready" answered)
+ * while it runs. The worker streams "info" lines (depth, multipv, score, nodes, nps, time, pv) and ends with "bestmove".
+ */
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ChessBoard.hpp"
+#include "../search/Search.hpp"
+
+class UciEngine {
+    public:
+        static constexpr size_t HASH_MEGABYTES = 16;   // Default size of the transposition table (Hash option)
+        static constexpr size_t MAX_HASH_MEGABYTES = 65536;
+        static constexpr int MAX_MULTI_PV = 256;
+
+        /**
+         * @brief Constructs an engine that reads commands from in & writes responses to out
+         */
+        UciEngine(std::istream& in, std::ostream& out);
+
+        /**
+         * @brief Destructor.
+         * @post Any running search is stopped & its thread joined
+         */
+        ~UciEngine();
+
+        UciEngine(const UciEngine&) = delete;
+        UciEngine& operator=(const UciEngine&) = delete;
+
+        /**
+         * @brief Processes commands until "quit" or the end of the input
+         */
+        void run();
+
+        /**
+         * @brief Processes a single command line
+         * @return False if the command was "quit". True otherwise.
+         */
+        bool handle(const std::string& line);
+
+    private:
+        std::istream& in_;
+        std::ostream& out_;
+        std::mutex output_mutex_;
+
+        // The position set by the last "position" command: a FEN (empty for the start position) & the moves played from it
+        std::string position_fen_;
+        std::vector<std::string> position_moves_;
+
+        // Kept across searches, so that each move of a game starts from what the previous searches learned
+        TranspositionTable table_;
+
+        // Set by the SharedHash option (empty for a private table). The segment is opened before the next search rather
+        // than when the option is set, so that a segment created by this engine gets the Hash size whatever the order
+        // the options came in, and reopened when Hash changes.
+        std::string shared_hash_;
+        bool shared_hash_pending_;
+
+        std::unique_ptr<NnueNetwork> network_;  // Set by the EvalFile option; Evaluator is used when null
+        int multi_pv_;                          // Set by the MultiPV option
+
+        std::unique_ptr<ChessBoard> search_board_;
+        std::unique_ptr<Search> search_;
+        std::thread worker_;
+
+        /**
+         * @brief Writes a whole line at once, so that lines of the worker & input threads never interleave
+         */
+        void send(const std::string& line);
+
+        void position(std::istringstream& command);
+        void setOption(std::istringstream& command);
+        void go(std::istringstream& command);
+
+        /**
+         * @brief Stops the running search (if any) & waits for its "bestmove"
+         */
+        void stopSearch();
+
+        /**
+         * @brief Opens the segment of the SharedHash option, if it changed (or Hash did) since it was last opened, and
+         *     reports the size of the table in an "info string" line
+         * @pre No search is running
+         */
+        void openSharedHash();
+
+        /**
+         * @brief Builds a fresh board for the current position. The moves stop at the first one that can't be played,
+         *     which is reported in an "info string" line.
+         * @return The board, or nullptr if the position's FEN is invalid
+         */
+        std::unique_ptr<ChessBoard> buildBoard();
+
+        /**
+         * @brief Formats a search report as an "info" line
+         */
+        static std::string infoLine(const SearchInfo& info);
+};